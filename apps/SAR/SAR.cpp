@@ -1,11 +1,12 @@
 #include "apps/app_interface.hpp"
 #include "dash/fft.hpp"
+#include "dash/host_buffer.hpp"
 #include "dash/provider.hpp"
+#include "dash/vec.hpp"
 #include "schedrt/accelerator.hpp"
 #include "schedrt/application_registry.hpp"
 #include "schedrt/scheduler.hpp"
 
-#include <algorithm>
 #include <chrono>
 #include <cmath>
 #include <cstring>
@@ -43,24 +44,12 @@ bool load_raw(const std::filesystem::path& path, std::vector<Complex>& dest, siz
     return true;
 }
 
-void fftshift(std::vector<Complex>& data, size_t len) {
-    size_t half = len / 2;
-    if (len % 2 == 0) {
-        for (size_t i = 0; i < half; ++i) {
-            std::swap(data[i], data[i + half]);
-        }
-    } else {
-        std::rotate(data.begin(), data.begin() + half + 1, data.end());
-    }
-}
-
-bool run_fft(const std::vector<float>& input, std::vector<float>& output, size_t len, bool inverse) {
+bool run_fft(const float* input, float* output, size_t len, bool inverse) {
     dash::FftPlan plan;
     plan.n = static_cast<int>(len);
     plan.inverse = inverse;
-    return dash::fft_execute(plan,
-                             {const_cast<float*>(input.data()), input.size() * sizeof(float)},
-                             {output.data(), output.size() * sizeof(float)});
+    size_t bytes = len * 2 * sizeof(float);
+    return dash::fft_execute(plan, {const_cast<float*>(input), bytes}, {output, bytes});
 }
 
 size_t discover_arg(int argc, char** argv, const char* prefix, const std::string& default_value, std::string& out) {
@@ -146,48 +135,44 @@ extern "C" int app_run(int argc, char** argv, Scheduler& sched) {
         }
     }
 
-    std::vector<float> s0_flat(complex_len * 2);
+    dash::host_vector<float> s0_flat(complex_len * 2);
     for (size_t i = 0; i < complex_len; ++i) {
         s0_flat[2 * i] = s0[i].re;
         s0_flat[2 * i + 1] = s0[i].im;
     }
 
-    std::vector<float> temp(complex_len * 2, 0.0f);
-    std::vector<float> fft_tmp(complex_len * 2, 0.0f);
-    std::vector<float> corr(complex_len * 2, 0.0f);
+    dash::host_vector<float> fft_tmp(complex_len * 2, 0.0f);
+    dash::host_vector<float> temp(complex_len * 2, 0.0f);
+    dash::host_vector<float> corr(complex_len * 2, 0.0f);
 
-    size_t block = Nfast;
+    // Range compression. The FFTs go row by row; the shift and reference
+    // multiply between them run once over the whole block as vector tasks.
     for (size_t slow = 0; slow < Nslow; ++slow) {
         size_t offset = slow * Nfast * 2;
-        std::copy_n(s0_flat.begin() + offset, block * 2, temp.begin() + offset);
-        if (!run_fft(temp, fft_tmp, Nfast, false)) return 1;
-        std::vector<Complex> chunk(Nfast);
-        for (size_t i = 0; i < Nfast; ++i) {
-            chunk[i].re = fft_tmp[offset + 2 * i];
-            chunk[i].im = fft_tmp[offset + 2 * i + 1];
-        }
-        fftshift(chunk, Nfast);
-        for (size_t i = 0; i < Nfast; ++i) {
-            float re = chunk[i].re * g[2 * i] - chunk[i].im * g[2 * i + 1];
-            float im = chunk[i].im * g[2 * i] + chunk[i].re * g[2 * i + 1];
-            fft_tmp[offset + 2 * i] = re;
-            fft_tmp[offset + 2 * i + 1] = im;
-        }
-        if (!run_fft(fft_tmp, temp, Nfast, true)) return 1;
-        for (size_t i = 0; i < Nfast; ++i) {
-            corr[offset + 2 * i] = temp[offset + 2 * i];
-            corr[offset + 2 * i + 1] = temp[offset + 2 * i + 1];
-        }
+        if (!run_fft(s0_flat.data() + offset, fft_tmp.data() + offset, Nfast, false)) return 1;
+    }
+    using dash::vec::Op;
+    if (!dash::vec::execute({Op::FftShift, fft_tmp.data(), nullptr, temp.data(), complex_len, Nfast}) ||
+        !dash::vec::execute({Op::Mul, temp.data(), g.data(), temp.data(), complex_len, Nfast})) {
+        std::cerr << "[SAR] reference multiply failed\n";
+        return 1;
+    }
+    for (size_t slow = 0; slow < Nslow; ++slow) {
+        size_t offset = slow * Nfast * 2;
+        if (!run_fft(temp.data() + offset, corr.data() + offset, Nfast, true)) return 1;
     }
 
     // Output magnitude
+    dash::host_vector<float> mag(complex_len);
+    if (!dash::vec::execute({Op::Magnitude, corr.data(), nullptr, mag.data(), complex_len})) {
+        std::cerr << "[SAR] magnitude failed\n";
+        return 1;
+    }
     std::ofstream out((input_dir / "SAR_output.txt").string());
     if (out) {
         for (size_t slow = 0; slow < Nslow; ++slow) {
             for (size_t fast = 0; fast < Nfast; ++fast) {
-                size_t idx = slow * Nfast * 2 + fast * 2;
-                float mag = std::sqrt(corr[idx] * corr[idx] + corr[idx + 1] * corr[idx + 1]);
-                out << mag << " ";
+                out << mag[slow * Nfast + fast] << " ";
             }
             out << "\n";
         }
@@ -1,27 +1,86 @@
+#include <algorithm>
 #include <chrono>
+#include <condition_variable>
 #include <csignal>
 #include <cstdint>
+#include <cstdio>
 #include <cstring>
 #include <fcntl.h>
 #include <fstream>
+#include <iomanip>
 #include <iostream>
 #include <memory>
+#include <mutex>
+#include <optional>
+#include <poll.h>
 #include <string>
 #include <thread>
 #include <unistd.h>
+#include <vector>
+#include <sys/eventfd.h>
+#include <sys/ioctl.h>
 #include <sys/mman.h>
 
+#include "axi_dma_map_ioctl.h"
+
 namespace {
 struct Options {
     std::string device = "/dev/axi_dma_regs";
     std::string udmabuf = "udmabuf0";
+    std::string dma_buf;                // --dma-buf: allocate from axi_dma_map instead
+    size_t dma_buf_bytes = 1024 * 1024;
     size_t bytes = 256 * 1024; // 256 KiB
     unsigned timeout_ms = 100;
+
+    // --bench
+    bool bench = false;
+    bool software = false;
+    size_t sw_buffer = 1024 * 1024;
+    size_t min_bytes = 64;
+    size_t max_bytes = 0;  // 0 = half the buffer / outstanding
+    std::vector<bool> cached = {true, false};
+    std::vector<bool> irq = {false};
+    std::vector<unsigned> outstanding = {1, 2};
+    unsigned iters = 200;
+    std::vector<std::string> uio;  // MM2S and S2MM interrupt lines
 };
 
 void print_usage(const char* prog) {
     std::cout << "Usage: " << prog << " [--device=/dev/axi_dma_regs]"
-              << " [--udmabuf=udmabuf0] [--bytes=N] [--timeout-ms=N]\n";
+              << " [--udmabuf=udmabuf0 | --dma-buf[=PATH] [--dma-buf-bytes=N]] [--bytes=N] [--timeout-ms=N]\n"
+              << "       " << prog << " --bench [--sw] [--cache=LIST] [--completion=LIST] [--outstanding=LIST]"
+              << " [--min-bytes=N] [--max-bytes=N] [--iters=N] [--uio=MM2S_DEV,S2MM_DEV] [--sw-buffer=N]\n"
+              << "  --dma-buf[=PATH]     allocate the buffer from axi_dma_map (default " AXI_DMA_BUF_DEVICE ")\n"
+              << "                       instead of mapping a u-dma-buf device\n"
+              << "  --dma-buf-bytes=N    size to allocate with --dma-buf (default 1048576)\n"
+              << "  --bench              sweep transfer sizes and report MB/s, latency percentiles and the\n"
+              << "                       register-programming / data-movement / cache-maintenance split\n"
+              << "  --sw                 memfd buffer and emulated DMA registers instead of the hardware\n"
+              << "                       (implies --bench)\n"
+              << "  --sw-buffer=N        memfd size in bytes for --sw (default 1048576)\n"
+              << "  --cache=LIST         cached,uncached buffer mappings (default both)\n"
+              << "  --completion=LIST    poll,irq (default poll; irq needs --uio unless --sw)\n"
+              << "  --outstanding=LIST   transfers allowed in flight, e.g. 1,2,4 (default 1,2)\n"
+              << "  --min-bytes=N        smallest transfer (default 64)\n"
+              << "  --max-bytes=N        largest transfer (default half the buffer / outstanding)\n"
+              << "  --iters=N            transfers per size (default 200)\n"
+              << "  --uio=DEV[,DEV]      UIO devices for the MM2S and S2MM interrupts\n";
+}
+
+template <typename T, typename Parse>
+bool parse_list(const std::string& text, std::vector<T>* out, Parse parse) {
+    out->clear();
+    size_t start = 0;
+    while (start <= text.size()) {
+        size_t comma = text.find(',', start);
+        std::string item = text.substr(start, comma == std::string::npos ? std::string::npos : comma - start);
+        T value{};
+        if (item.empty() || !parse(item, &value)) return false;
+        out->push_back(value);
+        if (comma == std::string::npos) break;
+        start = comma + 1;
+    }
+    return !out->empty();
 }
 
 bool parse_size(const std::string& text, size_t* out) {
@@ -47,8 +106,11 @@ bool read_uint64(const std::string& path, uint64_t* out) {
 }
 
 struct UdmabufRegion {
-    bool init(const std::string& name) {
+    // uncached opens with O_SYNC; a cached mapping needs sync_for_device()
+    // before the DMA reads it and sync_for_cpu() before the CPU reads results.
+    bool init(const std::string& name, bool uncached = true) {
         std::string base = "/sys/class/u-dma-buf/" + name;
+        sysfs_ = base;
         uint64_t size_value = 0;
         if (!read_uint64(base + "/size", &size_value)) {
             std::cerr << "[udmabuf] failed to read size for " << name << "\n";
@@ -59,7 +121,7 @@ struct UdmabufRegion {
             return false;
         }
         std::string dev_path = "/dev/" + name;
-        fd_ = ::open(dev_path.c_str(), O_RDWR | O_SYNC);
+        fd_ = ::open(dev_path.c_str(), uncached ? O_RDWR | O_SYNC : O_RDWR);
         if (fd_ < 0) {
             std::perror(("[udmabuf] open " + dev_path).c_str());
             return false;
@@ -76,6 +138,32 @@ struct UdmabufRegion {
         return true;
     }
 
+    // axi_dma_map allocates the buffer; cached ones take the SYNC ioctl.
+    bool init_dma_buf(const std::string& path, size_t bytes, bool uncached = true) {
+        fd_ = ::open(path.c_str(), O_RDWR | O_CLOEXEC);
+        if (fd_ < 0) {
+            std::perror(("[dma-buf] open " + path).c_str());
+            return false;
+        }
+        axi_dma_buf_alloc req{};
+        req.size = bytes;
+        req.flags = uncached ? 0 : AXI_DMA_BUF_CACHED;
+        if (ioctl(fd_, AXI_DMA_BUF_IOC_ALLOC, &req) != 0) {
+            std::perror("[dma-buf] AXI_DMA_BUF_IOC_ALLOC");
+            return false;
+        }
+        void* map = mmap(nullptr, req.size, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+        if (map == MAP_FAILED) {
+            std::perror("[dma-buf] mmap");
+            return false;
+        }
+        virt_ = static_cast<uint8_t*>(map);
+        size_ = static_cast<size_t>(req.size);
+        phys_ = req.bus_addr;
+        dma_buf_ = true;
+        return true;
+    }
+
     ~UdmabufRegion() {
         if (virt_) munmap(virt_, size_);
         if (fd_ >= 0) close(fd_);
@@ -85,13 +173,41 @@ struct UdmabufRegion {
     size_t size() const { return size_; }
     uint64_t phys() const { return phys_; }
 
+    // Cache maintenance over [offset, offset + bytes).
+    // direction: 1 = to device, 2 = from device.
+    bool sync(bool for_device, size_t offset, size_t bytes) const {
+        if (dma_buf_) {
+            axi_dma_buf_sync req{};
+            req.offset = offset;
+            req.size = bytes;
+            req.direction = for_device ? AXI_DMA_BUF_TO_DEVICE : AXI_DMA_BUF_FROM_DEVICE;
+            return ioctl(fd_, AXI_DMA_BUF_IOC_SYNC, &req) == 0;
+        }
+        return write_attr("sync_offset", offset) && write_attr("sync_size", bytes) &&
+               write_attr("sync_direction", for_device ? 1 : 2) &&
+               write_attr(for_device ? "sync_for_device" : "sync_for_cpu", 1);
+    }
+
 private:
+    bool write_attr(const char* attr, uint64_t value) const {
+        std::ofstream ofs(sysfs_ + "/" + attr);
+        ofs << value;
+        return static_cast<bool>(ofs);
+    }
+
+    std::string sysfs_;
     int fd_{-1};
     uint8_t* virt_{nullptr};
     size_t size_{0};
     uint64_t phys_{0};
+    bool dma_buf_{false};
 };
 
+bool open_buffer(UdmabufRegion& buf, const Options& opts, bool uncached = true) {
+    if (!opts.dma_buf.empty()) return buf.init_dma_buf(opts.dma_buf, opts.dma_buf_bytes, uncached);
+    return buf.init(opts.udmabuf, uncached);
+}
+
 struct Device {
     explicit Device(std::string path) : path_(std::move(path)) {}
     bool open_rw() {
@@ -162,10 +278,10 @@ bool wait_for_idle(const Device& dev, off_t status_reg, unsigned timeout_ms, con
 
 int run_test(const Options& opts) {
     UdmabufRegion buf;
-    if (!buf.init(opts.udmabuf)) return 1;
+    if (!open_buffer(buf, opts)) return 1;
     size_t half = buf.size() / 2;
     if (half == 0) {
-        std::cerr << "[axi-dma-test] udmabuf too small\n";
+        std::cerr << "[axi-dma-test] buffer too small\n";
         return 1;
     }
     size_t bytes = opts.bytes ? opts.bytes : half;
@@ -227,6 +343,499 @@ int run_test(const Options& opts) {
     std::cerr << "[axi-dma-test] output mismatches: " << mismatches << "\n";
     return 1;
 }
+
+// ---------------- benchmark ----------------
+
+constexpr uint32_t DMA_CR_RESET = 0x4;
+constexpr uint32_t DMA_SR_HALTED = 0x1;
+constexpr uint32_t DMA_SR_SLVERR = 1u << 5;
+constexpr uint32_t DMA_SR_IOC_IRQ = 1u << 12;
+constexpr uint32_t DMA_SR_ERR_IRQ = 1u << 14;
+constexpr uint32_t DMA_SR_IRQ_MASK = (1u << 12) | (1u << 13) | (1u << 14);  // write-1-to-clear
+constexpr uint32_t DMA_SR_FAULT_MASK = (1u << 4) | (1u << 5) | (1u << 6) | (1u << 7) | DMA_SR_ERR_IRQ;
+
+// Register access for the benchmark: the char device on target or the
+// emulated engine with --sw.
+class RegisterFile {
+public:
+    virtual ~RegisterFile() = default;
+    virtual uint32_t read(off_t offset) = 0;
+    virtual void write(off_t offset, uint32_t value) = 0;
+};
+
+class DeviceRegisters : public RegisterFile {
+public:
+    explicit DeviceRegisters(const Device& dev) : dev_(dev) {}
+    uint32_t read(off_t offset) override { return dev_.read(offset); }
+    void write(off_t offset, uint32_t value) override { dev_.write(offset, value); }
+
+private:
+    const Device& dev_;
+};
+
+// Software stand-in for the loopback design: MM2S reads a frame from the
+// buffer into the stream FIFO (one frame deep, like the FFT core), and S2MM
+// drains it to the destination. Each channel takes one transfer at a time,
+// as in direct-register mode, and the status bits follow the AXI DMA
+// (Halted, Idle, IOC_Irq and Err_Irq, write-1-to-clear). Completion raises
+// an eventfd when IOC_IrqEn is set.
+class EmulatedDma : public RegisterFile {
+public:
+    EmulatedDma(uint8_t* base, size_t size, uint64_t phys) : base_(base), size_(size), phys_(phys) {
+        irq_fd_ = eventfd(0, EFD_CLOEXEC);
+        regs_[MM2S_DMASR / 4] = DMA_SR_HALTED;
+        regs_[S2MM_DMASR / 4] = DMA_SR_HALTED;
+        engine_ = std::thread([this] { run(); });
+    }
+    ~EmulatedDma() override {
+        {
+            std::lock_guard<std::mutex> lk(mu_);
+            stop_ = true;
+        }
+        cv_.notify_all();
+        engine_.join();
+        if (irq_fd_ >= 0) close(irq_fd_);
+    }
+
+    int irq_fd() const { return irq_fd_; }
+
+    uint32_t read(off_t offset) override {
+        std::lock_guard<std::mutex> lk(mu_);
+        return regs_[offset / 4];
+    }
+
+    void write(off_t offset, uint32_t value) override {
+        if (write_locked(offset, value)) cv_.notify_all();
+    }
+
+private:
+    // True when the write started a transfer.
+    bool write_locked(off_t offset, uint32_t value) {
+        std::lock_guard<std::mutex> lk(mu_);
+        uint32_t& reg = regs_[offset / 4];
+        if (offset == MM2S_DMASR || offset == S2MM_DMASR) {
+            reg &= ~(value & DMA_SR_IRQ_MASK);
+            return false;
+        }
+        if (offset == MM2S_DMACR || offset == S2MM_DMACR) {
+            off_t sr = offset + 4;
+            if (value & DMA_CR_RESET) {
+                regs_[offset / 4] = 0;
+                regs_[sr / 4] = DMA_SR_HALTED;
+                (offset == MM2S_DMACR ? mm2s_armed_ : s2mm_armed_) = false;
+                return false;
+            }
+            reg = value;
+            if (value & DMA_CR_RUNSTOP) {
+                regs_[sr / 4] = (regs_[sr / 4] & ~DMA_SR_HALTED) | DMA_SR_IDLE;
+            } else {
+                regs_[sr / 4] |= DMA_SR_HALTED;
+            }
+            return false;
+        }
+        reg = value;
+        if (offset == MM2S_LENGTH && (regs_[MM2S_DMACR / 4] & DMA_CR_RUNSTOP)) {
+            regs_[MM2S_DMASR / 4] &= ~DMA_SR_IDLE;
+            mm2s_armed_ = true;
+            return true;
+        }
+        if (offset == S2MM_LENGTH && (regs_[S2MM_DMACR / 4] & DMA_CR_RUNSTOP)) {
+            regs_[S2MM_DMASR / 4] &= ~DMA_SR_IDLE;
+            s2mm_armed_ = true;
+            return true;
+        }
+        return false;
+    }
+
+    uint8_t* translate(uint32_t lo, uint32_t hi, size_t bytes) const {
+        uint64_t addr = (static_cast<uint64_t>(hi) << 32) | lo;
+        if (addr < phys_ || addr - phys_ > size_ || bytes > size_ - (addr - phys_)) return nullptr;
+        return base_ + (addr - phys_);
+    }
+
+    // Caller holds mu_.
+    void complete(off_t cr, off_t sr, bool ok) {
+        regs_[sr / 4] |= ok ? (DMA_SR_IDLE | DMA_SR_IOC_IRQ) : (DMA_SR_HALTED | DMA_SR_SLVERR | DMA_SR_ERR_IRQ);
+        uint32_t enabled = regs_[cr / 4] & (ok ? DMA_CR_IOC_IrqEn : DMA_CR_ERR_IrqEn);
+        if (enabled) {
+            uint64_t one = 1;
+            if (::write(irq_fd_, &one, sizeof(one)) != sizeof(one)) std::perror("[axi-dma-test] eventfd");
+        }
+    }
+
+    void run() {
+        std::unique_lock<std::mutex> lk(mu_);
+        for (;;) {
+            cv_.wait(lk, [&] { return stop_ || (mm2s_armed_ && fifo_bytes_ == 0) || (s2mm_armed_ && fifo_bytes_ > 0); });
+            if (stop_) return;
+            if (mm2s_armed_ && fifo_bytes_ == 0) {
+                size_t len = regs_[MM2S_LENGTH / 4];
+                uint8_t* src = translate(regs_[MM2S_SA / 4], regs_[MM2S_SA_MSB / 4], len);
+                mm2s_armed_ = false;
+                if (src) {
+                    fifo_.resize(std::max(fifo_.size(), len));
+                    lk.unlock();
+                    std::memcpy(fifo_.data(), src, len);
+                    lk.lock();
+                    fifo_bytes_ = len;
+                }
+                complete(MM2S_DMACR, MM2S_DMASR, src != nullptr);
+            }
+            if (s2mm_armed_ && fifo_bytes_ > 0) {
+                size_t len = std::min<size_t>(regs_[S2MM_LENGTH / 4], fifo_bytes_);
+                uint8_t* dst = translate(regs_[S2MM_DA / 4], regs_[S2MM_DA_MSB / 4], len);
+                s2mm_armed_ = false;
+                if (dst) {
+                    lk.unlock();
+                    std::memcpy(dst, fifo_.data(), len);
+                    lk.lock();
+                    regs_[S2MM_LENGTH / 4] = static_cast<uint32_t>(len);  // bytes received
+                }
+                fifo_bytes_ = 0;
+                complete(S2MM_DMACR, S2MM_DMASR, dst != nullptr);
+            }
+        }
+    }
+
+    uint8_t* base_;
+    size_t size_;
+    uint64_t phys_;
+    int irq_fd_{-1};
+    std::mutex mu_;
+    std::condition_variable cv_;
+    uint32_t regs_[0x60 / 4]{};
+    bool mm2s_armed_{false};
+    bool s2mm_armed_{false};
+    std::vector<uint8_t> fifo_;
+    size_t fifo_bytes_{0};
+    bool stop_{false};
+    std::thread engine_;
+};
+
+// Anonymous shared memory standing in for the udmabuf with --sw. The fake
+// physical base only has to be what the emulated engine translates.
+struct MemfdRegion {
+    static constexpr uint64_t kPhysBase = 0x30000000;
+
+    bool init(size_t bytes) {
+        fd_ = memfd_create("axi_dma_test", MFD_CLOEXEC);
+        if (fd_ < 0 || ftruncate(fd_, static_cast<off_t>(bytes)) != 0) {
+            std::perror("[axi-dma-test] memfd");
+            return false;
+        }
+        void* map = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+        if (map == MAP_FAILED) {
+            std::perror("[axi-dma-test] mmap memfd");
+            return false;
+        }
+        virt_ = static_cast<uint8_t*>(map);
+        size_ = bytes;
+        return true;
+    }
+    ~MemfdRegion() {
+        if (virt_) munmap(virt_, size_);
+        if (fd_ >= 0) close(fd_);
+    }
+
+    uint8_t* virt() const { return virt_; }
+    size_t size() const { return size_; }
+    uint64_t phys() const { return kPhysBase; }
+
+private:
+    int fd_{-1};
+    uint8_t* virt_{nullptr};
+    size_t size_{0};
+};
+
+// Blocks until a completion interrupt. UIO lines are re-enabled by writing 1
+// and deliver a 4-byte count; the emulated engine's eventfd an 8-byte one.
+class IrqLines {
+public:
+    bool open_uio(const std::vector<std::string>& paths) {
+        for (const auto& path : paths) {
+            int fd = ::open(path.c_str(), O_RDWR | O_CLOEXEC);
+            if (fd < 0) {
+                std::perror(("[axi-dma-test] open " + path).c_str());
+                return false;
+            }
+            fds_.push_back(fd);
+        }
+        return !fds_.empty();
+    }
+    void use_eventfd(int fd) {
+        fds_.push_back(fd);
+        borrowed_ = true;
+    }
+    ~IrqLines() {
+        if (!borrowed_) for (int fd : fds_) close(fd);
+    }
+
+    void arm() const {
+        if (borrowed_) return;
+        uint32_t enable = 1;
+        for (int fd : fds_) {
+            if (::write(fd, &enable, sizeof(enable)) != sizeof(enable)) std::perror("[axi-dma-test] uio enable");
+        }
+    }
+
+    bool wait(unsigned timeout_ms) const {
+        std::vector<pollfd> pfds;
+        for (int fd : fds_) pfds.push_back({fd, POLLIN, 0});
+        int n = ::poll(pfds.data(), pfds.size(), static_cast<int>(timeout_ms));
+        if (n <= 0) return false;
+        for (const auto& p : pfds) {
+            if (!(p.revents & POLLIN)) continue;
+            uint64_t count = 0;
+            if (::read(p.fd, &count, borrowed_ ? sizeof(uint64_t) : sizeof(uint32_t)) < 0) return false;
+        }
+        return true;
+    }
+
+private:
+    std::vector<int> fds_;
+    bool borrowed_{false};
+};
+
+// Where the benchmark runs: buffer halves for source and destination,
+// register access, completion interrupts and cache maintenance.
+struct BenchTarget {
+    uint8_t* virt = nullptr;
+    size_t size = 0;
+    uint64_t phys = 0;
+    RegisterFile* regs = nullptr;
+    const IrqLines* irq = nullptr;            // null: poll only
+    const UdmabufRegion* cached = nullptr;    // set when the mapping needs sync
+};
+
+struct TransferTimes {
+    double latency_ns = 0;  // first register write to S2MM completion seen
+    double program_ns = 0;  // register writes for both channels and the IRQ clears
+    double sync_ns = 0;     // cache maintenance around the transfer
+};
+
+struct SizeResult {
+    double mbps = 0;
+    std::vector<TransferTimes> times;
+    bool ok = true;
+    size_t mismatches = 0;
+};
+
+double percentile(std::vector<double> v, double p) {
+    if (v.empty()) return 0.0;
+    std::sort(v.begin(), v.end());
+    return v[std::min(v.size() - 1, static_cast<size_t>(p * static_cast<double>(v.size())))];
+}
+
+// Runs `iters` transfers of `bytes`, with up to `outstanding` in flight.
+// Transfer k uses source/destination slot k % outstanding. S2MM is armed for
+// a transfer as soon as the previous one has landed, and MM2S starts as soon
+// as its channel is free and the window allows, so with two or more in
+// flight the next frame is read while the previous one is still written
+// back. Each channel has one transfer at a time (direct-register mode).
+SizeResult run_size(const BenchTarget& t, size_t bytes, unsigned outstanding, unsigned iters, bool irq,
+                    unsigned timeout_ms) {
+    using clock = std::chrono::steady_clock;
+    auto ns_since = [](clock::time_point a, clock::time_point b) {
+        return std::chrono::duration<double, std::nano>(b - a).count();
+    };
+    SizeResult res;
+    res.times.resize(iters);
+    const size_t half = t.size / 2;
+    const size_t slot_bytes = half / outstanding;
+    auto src_off = [&](unsigned k) { return static_cast<size_t>(k % outstanding) * slot_bytes; };
+    auto dst_off = [&](unsigned k) { return half + static_cast<size_t>(k % outstanding) * slot_bytes; };
+    for (unsigned s = 0; s < outstanding; ++s) {
+        uint8_t* src = t.virt + src_off(s);
+        for (size_t i = 0; i < bytes; ++i) src[i] = static_cast<uint8_t>((i * 7 + s * 13) & 0xFF);
+        std::memset(t.virt + dst_off(s), 0, bytes);
+    }
+
+    RegisterFile& regs = *t.regs;
+    uint32_t cr = DMA_CR_RUNSTOP | (irq ? DMA_CR_IOC_IrqEn | DMA_CR_ERR_IrqEn : 0);
+    regs.write(MM2S_DMASR, 0xFFFFFFFF);
+    regs.write(S2MM_DMASR, 0xFFFFFFFF);
+    regs.write(S2MM_DMACR, cr);
+    regs.write(MM2S_DMACR, cr);
+
+    std::vector<clock::time_point> started(iters);
+    unsigned armed = 0, issued = 0, done = 0;
+    bool mm2s_busy = false, s2mm_busy = false;
+    auto begin = clock::now();
+    while (done < iters) {
+        if (!s2mm_busy && armed < iters && armed == done) {
+            auto t0 = clock::now();
+            if (armed == issued) started[armed] = t0;
+            uint64_t dst = t.phys + dst_off(armed);
+            regs.write(S2MM_DA, static_cast<uint32_t>(dst));
+            regs.write(S2MM_DA_MSB, static_cast<uint32_t>(dst >> 32));
+            regs.write(S2MM_LENGTH, static_cast<uint32_t>(bytes));
+            res.times[armed].program_ns += ns_since(t0, clock::now());
+            s2mm_busy = true;
+            ++armed;
+        }
+        if (!mm2s_busy && issued < iters && issued - done < outstanding) {
+            if (t.cached) {
+                auto s0 = clock::now();
+                t.cached->sync(true, src_off(issued), bytes);
+                res.times[issued].sync_ns += ns_since(s0, clock::now());
+            }
+            auto t0 = clock::now();
+            if (issued >= armed) started[issued] = t0;
+            uint64_t src = t.phys + src_off(issued);
+            regs.write(MM2S_SA, static_cast<uint32_t>(src));
+            regs.write(MM2S_SA_MSB, static_cast<uint32_t>(src >> 32));
+            regs.write(MM2S_LENGTH, static_cast<uint32_t>(bytes));
+            res.times[issued].program_ns += ns_since(t0, clock::now());
+            mm2s_busy = true;
+            ++issued;
+        }
+
+        // Wait for either channel to go idle.
+        uint32_t mm2s_sr = 0, s2mm_sr = 0;
+        auto deadline = clock::now() + std::chrono::milliseconds(timeout_ms);
+        for (;;) {
+            if (irq) t.irq->arm();
+            mm2s_sr = regs.read(MM2S_DMASR);
+            s2mm_sr = regs.read(S2MM_DMASR);
+            if ((mm2s_sr | s2mm_sr) & DMA_SR_FAULT_MASK) {
+                std::cerr << "[axi-dma-test] error status mm2s=0x" << std::hex << mm2s_sr << " s2mm=0x" << s2mm_sr
+                          << std::dec << "\n";
+                res.ok = false;
+                return res;
+            }
+            if ((mm2s_busy && (mm2s_sr & DMA_SR_IDLE)) || (s2mm_busy && (s2mm_sr & DMA_SR_IDLE))) break;
+            if (clock::now() > deadline || (irq && !t.irq->wait(timeout_ms))) {
+                std::cerr << "[axi-dma-test] timeout mm2s=0x" << std::hex << mm2s_sr << " s2mm=0x" << s2mm_sr
+                          << std::dec << "\n";
+                res.ok = false;
+                return res;
+            }
+        }
+        auto seen = clock::now();
+        if (mm2s_busy && (mm2s_sr & DMA_SR_IDLE)) {
+            mm2s_busy = false;
+            auto t0 = clock::now();
+            if (irq) regs.write(MM2S_DMASR, DMA_SR_IOC_IRQ);
+            res.times[issued - 1].program_ns += ns_since(t0, clock::now());
+        }
+        if (s2mm_busy && (s2mm_sr & DMA_SR_IDLE)) {
+            s2mm_busy = false;
+            auto& tt = res.times[done];
+            tt.latency_ns = ns_since(started[done], seen);
+            auto t0 = clock::now();
+            if (irq) regs.write(S2MM_DMASR, DMA_SR_IOC_IRQ);
+            tt.program_ns += ns_since(t0, clock::now());
+            if (t.cached) {
+                auto s0 = clock::now();
+                t.cached->sync(false, dst_off(done), bytes);
+                tt.sync_ns += ns_since(s0, clock::now());
+            }
+            ++done;
+        }
+    }
+    double secs = ns_since(begin, clock::now()) / 1e9;
+    res.mbps = static_cast<double>(bytes) * iters / secs / 1e6;
+
+    for (unsigned s = 0; s < std::min(outstanding, iters); ++s) {
+        const uint8_t* src = t.virt + src_off(s);
+        const uint8_t* dst = t.virt + dst_off(s);
+        for (size_t i = 0; i < bytes; ++i) res.mismatches += src[i] != dst[i];
+    }
+    res.ok = res.mismatches == 0;
+    return res;
+}
+
+void print_size_row(size_t bytes, const SizeResult& r) {
+    std::vector<double> lat, prog, move, sync;
+    for (const auto& t : r.times) {
+        lat.push_back(t.latency_ns / 1000.0);
+        prog.push_back(t.program_ns / 1000.0);
+        move.push_back((t.latency_ns - t.program_ns) / 1000.0);
+        sync.push_back(t.sync_ns / 1000.0);
+    }
+    std::string size = bytes >= 1024 * 1024 ? std::to_string(bytes / (1024 * 1024)) + "M"
+                     : bytes >= 1024        ? std::to_string(bytes / 1024) + "K"
+                                            : std::to_string(bytes);
+    std::cout << "  " << std::setw(6) << size << std::fixed << std::setprecision(1) << std::setw(10) << r.mbps
+              << " MB/s  lat p50=" << std::setw(8) << percentile(lat, 0.5) << "us p90=" << std::setw(8)
+              << percentile(lat, 0.9) << "us p99=" << std::setw(8) << percentile(lat, 0.99)
+              << "us  prog=" << std::setw(6) << percentile(prog, 0.5) << "us move=" << std::setw(8)
+              << percentile(move, 0.5) << "us sync=" << std::setw(6) << percentile(sync, 0.5) << "us"
+              << std::defaultfloat;
+    if (r.mismatches) std::cout << "  MISMATCH(" << r.mismatches << ")";
+    std::cout << "\n";
+}
+
+// One sweep per (cache mode, completion mode, outstanding) combination.
+int run_bench(const Options& opts) {
+    if (opts.iters == 0 || opts.min_bytes == 0) {
+        std::cerr << "[axi-dma-test] --iters and --min-bytes must be positive\n";
+        return 1;
+    }
+    bool want_irq = std::find(opts.irq.begin(), opts.irq.end(), true) != opts.irq.end();
+    if (want_irq && !opts.software && opts.uio.empty()) {
+        std::cerr << "[axi-dma-test] --completion=irq needs --uio=MM2S_DEV[,S2MM_DEV]\n";
+        return 1;
+    }
+
+    std::optional<Device> dev;
+    std::unique_ptr<RegisterFile> regs;
+    IrqLines irq_lines;
+    MemfdRegion memfd;
+    EmulatedDma* emulated = nullptr;
+    if (opts.software) {
+        if (!memfd.init(opts.sw_buffer)) return 1;
+        auto emu = std::make_unique<EmulatedDma>(memfd.virt(), memfd.size(), memfd.phys());
+        emulated = emu.get();
+        irq_lines.use_eventfd(emu->irq_fd());
+        regs = std::move(emu);
+    } else {
+        dev.emplace(opts.device);
+        if (!dev->open_rw()) return 1;
+        regs = std::make_unique<DeviceRegisters>(*dev);
+        if (want_irq && !irq_lines.open_uio(opts.uio)) return 1;
+    }
+    regs->write(MM2S_DMACR, DMA_CR_RESET);
+    regs->write(S2MM_DMACR, DMA_CR_RESET);
+
+    for (bool cached : opts.cached) {
+        // The hardware maps the udmabuf per mode; the memfd is always cached
+        // memory and needs no maintenance, so both modes time the same path.
+        UdmabufRegion buf;
+        BenchTarget target;
+        target.regs = regs.get();
+        if (emulated) {
+            target.virt = memfd.virt();
+            target.size = memfd.size();
+            target.phys = memfd.phys();
+        } else {
+            if (!open_buffer(buf, opts, !cached)) return 1;
+            target.virt = buf.virt();
+            target.size = buf.size();
+            target.phys = buf.phys();
+            if (cached) target.cached = &buf;
+        }
+        for (bool irq : opts.irq) {
+            target.irq = irq ? &irq_lines : nullptr;
+            for (unsigned outstanding : opts.outstanding) {
+                size_t limit = target.size / 2 / outstanding;
+                if (opts.max_bytes) limit = std::min(limit, opts.max_bytes);
+                std::cout << "[axi-dma-test] " << (emulated ? "emulated" : "hw") << " "
+                          << (cached ? "cached" : "uncached") << " " << (irq ? "irq" : "poll")
+                          << " outstanding=" << outstanding << " iters=" << opts.iters << "\n";
+                for (size_t bytes = opts.min_bytes; bytes <= limit; bytes *= 2) {
+                    auto r = run_size(target, bytes, outstanding, opts.iters, irq, opts.timeout_ms);
+                    if (!r.ok && r.mismatches == 0) {
+                        std::cerr << "[axi-dma-test] sweep aborted at " << bytes << " bytes\n";
+                        return 1;
+                    }
+                    print_size_row(bytes, r);
+                }
+            }
+        }
+    }
+    return 0;
+}
 } // namespace
 
 int main(int argc, char** argv) {
@@ -245,6 +854,22 @@ int main(int argc, char** argv) {
             opts.udmabuf = arg.substr(sizeof("--udmabuf=") - 1);
             continue;
         }
+        if (arg == "--dma-buf") {
+            opts.dma_buf = AXI_DMA_BUF_DEVICE;
+            continue;
+        }
+        if (arg.rfind("--dma-buf=", 0) == 0) {
+            opts.dma_buf = arg.substr(sizeof("--dma-buf=") - 1);
+            continue;
+        }
+        if (arg.rfind("--dma-buf-bytes=", 0) == 0) {
+            if (!parse_size(arg.substr(sizeof("--dma-buf-bytes=") - 1), &opts.dma_buf_bytes) ||
+                opts.dma_buf_bytes == 0) {
+                std::cerr << "Invalid dma-buf-bytes value\n";
+                return 1;
+            }
+            continue;
+        }
         if (arg.rfind("--bytes=", 0) == 0) {
             if (!parse_size(arg.substr(sizeof("--bytes=") - 1), &opts.bytes)) {
                 std::cerr << "Invalid bytes value\n";
@@ -252,6 +877,97 @@ int main(int argc, char** argv) {
             }
             continue;
         }
+        if (arg == "--bench") {
+            opts.bench = true;
+            continue;
+        }
+        if (arg == "--sw") {
+            opts.software = true;
+            opts.bench = true;
+            continue;
+        }
+        if (arg.rfind("--sw-buffer=", 0) == 0) {
+            if (!parse_size(arg.substr(sizeof("--sw-buffer=") - 1), &opts.sw_buffer) || opts.sw_buffer < 256) {
+                std::cerr << "Invalid sw-buffer value\n";
+                return 1;
+            }
+            continue;
+        }
+        if (arg.rfind("--min-bytes=", 0) == 0) {
+            if (!parse_size(arg.substr(sizeof("--min-bytes=") - 1), &opts.min_bytes)) {
+                std::cerr << "Invalid min-bytes value\n";
+                return 1;
+            }
+            continue;
+        }
+        if (arg.rfind("--max-bytes=", 0) == 0) {
+            if (!parse_size(arg.substr(sizeof("--max-bytes=") - 1), &opts.max_bytes)) {
+                std::cerr << "Invalid max-bytes value\n";
+                return 1;
+            }
+            continue;
+        }
+        if (arg.rfind("--iters=", 0) == 0) {
+            size_t tmp = 0;
+            if (!parse_size(arg.substr(sizeof("--iters=") - 1), &tmp)) {
+                std::cerr << "Invalid iters value\n";
+                return 1;
+            }
+            opts.iters = static_cast<unsigned>(tmp);
+            continue;
+        }
+        if (arg.rfind("--cache=", 0) == 0) {
+            bool ok = parse_list<bool>(arg.substr(sizeof("--cache=") - 1), &opts.cached,
+                                       [](const std::string& v, bool* out) {
+                                           if (v != "cached" && v != "uncached") return false;
+                                           *out = v == "cached";
+                                           return true;
+                                       });
+            if (!ok) {
+                std::cerr << "Invalid cache list (cached,uncached)\n";
+                return 1;
+            }
+            continue;
+        }
+        if (arg.rfind("--completion=", 0) == 0) {
+            bool ok = parse_list<bool>(arg.substr(sizeof("--completion=") - 1), &opts.irq,
+                                       [](const std::string& v, bool* out) {
+                                           if (v != "poll" && v != "irq") return false;
+                                           *out = v == "irq";
+                                           return true;
+                                       });
+            if (!ok) {
+                std::cerr << "Invalid completion list (poll,irq)\n";
+                return 1;
+            }
+            continue;
+        }
+        if (arg.rfind("--outstanding=", 0) == 0) {
+            bool ok = parse_list<unsigned>(arg.substr(sizeof("--outstanding=") - 1), &opts.outstanding,
+                                           [](const std::string& v, unsigned* out) {
+                                               size_t tmp = 0;
+                                               if (!parse_size(v, &tmp) || tmp == 0 || tmp > 64) return false;
+                                               *out = static_cast<unsigned>(tmp);
+                                               return true;
+                                           });
+            if (!ok) {
+                std::cerr << "Invalid outstanding list (1..64)\n";
+                return 1;
+            }
+            continue;
+        }
+        if (arg.rfind("--uio=", 0) == 0) {
+            bool ok = parse_list<std::string>(arg.substr(sizeof("--uio=") - 1), &opts.uio,
+                                              [](const std::string& v, std::string* out) {
+                                                  *out = v;
+                                                  return true;
+                                              });
+            if (!ok || opts.uio.size() > 2) {
+                std::cerr << "Invalid uio list\n";
+                return 1;
+            }
+            continue;
+        }
         if (arg.rfind("--timeout-ms=", 0) == 0) {
             size_t tmp = 0;
             if (!parse_size(arg.substr(sizeof("--timeout-ms=") - 1), &tmp)) {
@@ -266,5 +982,5 @@ int main(int argc, char** argv) {
         return 1;
     }
 
-    return run_test(opts);
+    return opts.bench ? run_bench(opts) : run_test(opts);
 }
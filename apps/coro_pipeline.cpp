@@ -0,0 +1,122 @@
+// Many logical FFT pipelines as coroutines on a few scheduler workers
+// (dash/coro.hpp). Needs the schedrt_coro target; see SCHEDRT_COROUTINES.
+#include "apps/app_interface.hpp"
+#include "dash/coro.hpp"
+#include "dash/host_buffer.hpp"
+#include "dash/provider.hpp"
+#include "schedrt/accelerator.hpp"
+#include "schedrt/application_registry.hpp"
+#include "schedrt/scheduler.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <latch>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+
+namespace {
+
+struct Options {
+    unsigned pipelines = 256;
+    unsigned stages = 4;  // forward/inverse round trips per pipeline
+    int n = 4096;
+};
+
+Options parse_options(int argc, char** argv) {
+    Options opts;
+    for (int i = 0; i < argc; ++i) {
+        std::string arg(argv[i]);
+        try {
+            if (arg.rfind("--pipelines=", 0) == 0) {
+                opts.pipelines = static_cast<unsigned>(std::stoul(arg.substr(sizeof("--pipelines=") - 1)));
+            } else if (arg.rfind("--stages=", 0) == 0) {
+                opts.stages = static_cast<unsigned>(std::stoul(arg.substr(sizeof("--stages=") - 1)));
+            } else if (arg.rfind("--fft-size=", 0) == 0) {
+                opts.n = std::stoi(arg.substr(sizeof("--fft-size=") - 1));
+            }
+        } catch (const std::exception&) {
+            std::cerr << "[coro] ignoring malformed " << arg << "\n";
+        }
+    }
+    if (opts.n < 1) opts.n = 4096;
+    return opts;
+}
+
+// Threads that resumed a pipeline, to show how few carry all of them.
+std::mutex g_threads_mu;
+std::set<std::thread::id> g_threads;
+
+void note_thread() {
+    std::lock_guard<std::mutex> lk(g_threads_mu);
+    g_threads.insert(std::this_thread::get_id());
+}
+
+// Round trips a tone through forward and inverse FFTs. Between awaits the
+// coroutine runs on whichever worker completed the previous op.
+dash::CoTask<bool> pipeline(unsigned index, const Options& opts) {
+    const size_t n = static_cast<size_t>(opts.n);
+    const size_t bytes = 2 * n * sizeof(float);
+    dash::host_vector<float> signal(2 * n), spectrum(2 * n);
+    const size_t bin = 1 + index % (n / 2 > 1 ? n / 2 - 1 : 1);
+    for (size_t i = 0; i < n; ++i) {
+        double phase = 2.0 * M_PI * static_cast<double>(bin * i) / static_cast<double>(n);
+        signal[2 * i] = static_cast<float>(std::cos(phase));
+        signal[2 * i + 1] = static_cast<float>(std::sin(phase));
+    }
+    co_await dash::on_worker();
+    for (unsigned stage = 0; stage < opts.stages; ++stage) {
+        bool ok = co_await dash::fft({opts.n, false}, {signal.data(), bytes}, {spectrum.data(), bytes});
+        note_thread();
+        // A unit tone puts all of its energy in one bin.
+        if (!ok || std::abs(spectrum[2 * bin] - static_cast<float>(n)) > 1e-3f * static_cast<float>(n)) co_return false;
+        ok = co_await dash::fft({opts.n, true}, {spectrum.data(), bytes}, {signal.data(), bytes});
+        note_thread();
+        if (!ok) co_return false;
+    }
+    co_return std::abs(signal[0] - 1.0f) < 1e-3f;
+}
+
+dash::CoTask<void> run_one(unsigned index, const Options& opts, std::atomic<unsigned>& ok, std::latch& done) {
+    bool passed = co_await pipeline(index, opts);
+    if (passed) ok.fetch_add(1, std::memory_order_relaxed);
+    done.count_down();
+}
+
+} // namespace
+
+using namespace schedrt;
+
+extern "C" void app_initialize(int argc, char** argv, ApplicationRegistry& reg, Scheduler& sched) {
+    (void)argc;
+    (void)argv;
+    if (!reg.lookup("fft")) reg.register_app({"fft", "", "fft_kernel"});
+    sched.add_accelerator(make_cpu_mock(0));
+    dash::register_provider({"fft", ResourceKind::FFT, 0, 0});
+    dash::register_provider({"fft", ResourceKind::CPU, 0, 10});
+}
+
+extern "C" int app_run(int argc, char** argv, Scheduler& sched) {
+    (void)sched;
+    Options opts = parse_options(argc, argv);
+    std::atomic<unsigned> ok{0};
+    std::latch done(static_cast<std::ptrdiff_t>(opts.pipelines));
+
+    auto t0 = std::chrono::steady_clock::now();
+    for (unsigned i = 0; i < opts.pipelines; ++i) dash::spawn(run_one(i, opts, ok, done));
+    done.wait();
+    double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+
+    size_t threads = 0;
+    {
+        std::lock_guard<std::mutex> lk(g_threads_mu);
+        threads = g_threads.size();
+    }
+    std::cout << "[coro] pipelines=" << opts.pipelines << " ok=" << ok.load() << " ffts="
+              << 2ull * opts.pipelines * opts.stages << " n=" << opts.n << " threads=" << threads
+              << " time_ms=" << ms << "\n";
+    return ok.load() == opts.pipelines ? 0 : 1;
+}
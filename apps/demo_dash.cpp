@@ -20,7 +20,7 @@ extern "C" int app_run(int, char**, Scheduler&) {
     std::cout << "zip_execute -> " << (ok_zip ? "OK" : "FAIL") << "\n";
 
     dash::FftPlan plan{1024, false};
-    float fin[1024], fout[1024];
+    float fin[2 * 1024] = {}, fout[2 * 1024]; // interleaved re/im
     auto ok_fft = dash::fft_execute(plan, {fin, sizeof(fin)}, {fout, sizeof(fout)});
     std::cout << "fft_execute -> " << (ok_fft ? "OK" : "FAIL") << "\n";
 
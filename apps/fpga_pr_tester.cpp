@@ -1,5 +1,7 @@
 #include "dash/contexts.hpp"
+#include "dash/fft_cpu.hpp"
 #include "schedrt/accelerator.hpp"
+#include "schedrt/reporting.hpp"
 #include "schedrt/task.hpp"
 
 #include <algorithm>
@@ -12,6 +14,7 @@
 #include <cstdint>
 #include <cstdlib>
 #include <filesystem>
+#include <fstream>
 #include <fcntl.h>
 #include <iomanip>
 #include <iostream>
@@ -43,6 +46,7 @@ struct OverlaySpec {
 };
 
 enum class FftPattern { Impulse, Sine, Ramp, Random };
+enum class SwapPattern { PingPong, RoundRobin, Random };
 
 struct MmioProbe {
     std::string label;
@@ -67,6 +71,12 @@ struct Config {
     std::optional<std::string> dma_base;
     bool dma_debug = false;
     std::vector<MmioProbe> mmio_probes;
+    bool stress = false;
+    SwapPattern stress_pattern = SwapPattern::PingPong;
+    unsigned stress_iters = 100;
+    unsigned stress_fft_every = 0;  // 0 = no interleaved FFTs
+    unsigned stress_seed = 1;
+    std::string stress_csv;
 };
 
 class SigbusGuard {
@@ -163,6 +173,11 @@ void print_usage(const char* prog) {
               << "  --fft-pattern=impulse|sine|ramp|random\n"
               << "  --fft-inverse                        request inverse FFT mode\n"
               << "  --fft-dump                           dump first few FFT outputs per iteration\n"
+              << "  --stress=ping-pong|round-robin|random  cycle overlays across the slots and time every swap\n"
+              << "  --stress-iters=N                     swaps to perform (default 100)\n"
+              << "  --stress-fft-every=N                 run an FFT after every Nth swap to fft (default off)\n"
+              << "  --stress-seed=N                      seed for --stress=random (default 1)\n"
+              << "  --stress-csv=PATH                    write per-swap phase timings as CSV\n"
               << "  --mmio-probe=name:base[:span]        dump a set of registers via /dev/mem\n"
               << "  --mmio-probe-offset=name:offset      add additional offsets for that probe\n"
               << "  --help                               show this message\n";
@@ -436,7 +451,7 @@ bool run_fft_diagnostic(SlotInstance& slot,
         bool ok = result.ok && ctx.ok;
         std::cout << "  iter " << iter << ": "
                   << (ok ? "OK " : "FAIL ")
-                  << result.message << " ("
+                  << schedrt::reporting::describe(result.status, task.app, result.accelerator) << " ("
                   << result.runtime_ns.count() << " ns)\n";
         if (cfg.fft_dump) {
             dump_fft_samples(output, cfg.fft_length);
@@ -446,6 +461,227 @@ bool run_fft_diagnostic(SlotInstance& slot,
     return true;
 }
 
+std::optional<SwapPattern> parse_swap_pattern(const std::string& text) {
+    if (text == "ping-pong" || text == "pingpong") return SwapPattern::PingPong;
+    if (text == "round-robin" || text == "rr") return SwapPattern::RoundRobin;
+    if (text == "random") return SwapPattern::Random;
+    return std::nullopt;
+}
+
+struct SwapRecord {
+    unsigned iter = 0;
+    unsigned slot = 0;
+    std::string from;
+    std::string to;
+    uintmax_t bitstream_bytes = 0;
+    schedrt::ReconfigTiming phases{};
+    std::chrono::nanoseconds total{0};  // ensure_app_loaded as the scheduler calls it
+    int fft = -1;                       // -1 not run, 0 failed, 1 passed
+};
+
+double percentile_us(std::vector<double> v, double p) {
+    if (v.empty()) return 0.0;
+    std::sort(v.begin(), v.end());
+    return v[std::min(v.size() - 1, static_cast<size_t>(p * static_cast<double>(v.size())))];
+}
+
+// One FFT through the freshly swapped slot. On hardware the output is
+// checked against the CPU transform by normalised correlation, which
+// ignores the core's fixed-point scaling; mock slots only run the task.
+bool stress_fft(SlotInstance& slot, const Config& cfg, unsigned iter, std::mt19937& rng) {
+    std::vector<float> input(cfg.fft_length * 2), output(cfg.fft_length * 2, 0.0f), expect(cfg.fft_length * 2);
+    fill_fft_input(input, FftPattern::Random, cfg.fft_length, iter, rng);
+    for (auto& v : input) v *= 0.5f;  // stay inside the Q15 range after the first stages
+
+    dash::FftContext ctx;
+    ctx.plan.n = static_cast<int>(cfg.fft_length);
+    ctx.plan.inverse = cfg.fft_inverse;
+    ctx.in = {input.data(), input.size() * sizeof(float)};
+    ctx.out = {output.data(), output.size() * sizeof(float)};
+    Task task;
+    task.id = 9000 + iter;
+    task.app = slot.desc.app;
+    task.required = ResourceKind::FFT;
+    task.est_runtime_ns = std::chrono::microseconds(100);  // mock sleep
+    task.params.emplace(dash::kFftContextKey, std::to_string(reinterpret_cast<std::uintptr_t>(&ctx)));
+    auto result = slot.slot->run(task, slot.desc);
+    if (!result.ok) {
+        std::cerr << "[tester] stress iter " << iter << ": FFT on " << slot.slot->name() << " failed: "
+                  << schedrt::reporting::describe(result.status, task.app, result.accelerator) << "\n";
+        return false;
+    }
+    if (!cfg.fpga_real) return true;
+    if (!ctx.ok || result.status.cpu_fallback) {
+        std::cerr << "[tester] stress iter " << iter << ": FFT on " << slot.slot->name()
+                  << " did not run on the overlay\n";
+        return false;
+    }
+    dash::fft_cpu_execute(ctx.plan, input.data(), expect.data());
+    double dot = 0, ee = 0, oo = 0;
+    for (size_t i = 0; i < expect.size(); ++i) {
+        dot += static_cast<double>(expect[i]) * output[i];
+        ee += static_cast<double>(expect[i]) * expect[i];
+        oo += static_cast<double>(output[i]) * output[i];
+    }
+    double corr = (ee > 0 && oo > 0) ? dot / std::sqrt(ee * oo) : 0.0;
+    if (corr < 0.99) {
+        std::cerr << "[tester] stress iter " << iter << ": FFT output from " << slot.slot->name()
+                  << " correlates " << corr << " with the CPU reference\n";
+        return false;
+    }
+    return true;
+}
+
+// Cycles overlays across the loaded slots. Swap i goes to slot i % slots
+// (a random slot for --stress=random). ping-pong alternates each slot
+// between its own overlay and the next one listed; round-robin steps it
+// through every listed overlay; random picks any overlay it does not hold.
+bool run_stress(std::vector<SlotInstance>& slots, const std::vector<OverlaySpec>& overlays, const Config& cfg) {
+    std::vector<AppDescriptor> apps;
+    for (const auto& overlay : overlays) {
+        bool seen = std::any_of(apps.begin(), apps.end(), [&](const AppDescriptor& d) { return d.app == overlay.app; });
+        if (seen) continue;
+        AppDescriptor desc;
+        desc.app = overlay.app;
+        desc.kernel_name = overlay.app + "_kernel";
+        desc.bitstream_path = overlay.bitstream_path;
+        desc.kind = resource_for_app(desc.app);
+        apps.push_back(desc);
+    }
+    if (apps.size() < 2 || slots.empty()) {
+        std::cerr << "[tester] --stress needs at least two different overlays (--overlay=fft --overlay=fir)\n";
+        return false;
+    }
+    auto app_index = [&](const std::string& app) {
+        for (size_t i = 0; i < apps.size(); ++i) {
+            if (apps[i].app == app) return i;
+        }
+        return size_t{0};
+    };
+    std::vector<size_t> home(slots.size());
+    for (size_t s = 0; s < slots.size(); ++s) home[s] = app_index(slots[s].desc.app);
+    std::vector<uintmax_t> bytes(apps.size(), 0);
+    for (size_t i = 0; i < apps.size(); ++i) {
+        std::error_code ec;
+        if (auto host = resolve_bitstream_host_path(apps[i].bitstream_path)) {
+            auto size = std::filesystem::file_size(*host, ec);
+            if (!ec) bytes[i] = size;
+        }
+    }
+
+    std::mt19937 rng(cfg.stress_seed);
+    std::vector<SwapRecord> records;
+    records.reserve(cfg.stress_iters);
+    std::cout << "[tester] Stress: " << cfg.stress_iters << " swaps across " << slots.size() << " slot"
+              << (slots.size() == 1 ? "" : "s") << " and " << apps.size() << " overlays\n";
+    unsigned fft_runs = 0, fft_failures = 0;
+    auto wall_start = std::chrono::steady_clock::now();
+    for (unsigned iter = 0; iter < cfg.stress_iters; ++iter) {
+        size_t s = cfg.stress_pattern == SwapPattern::Random ? rng() % slots.size() : iter % slots.size();
+        auto& slot = slots[s];
+        size_t cur = app_index(slot.desc.app);
+        size_t next = cur;
+        switch (cfg.stress_pattern) {
+        case SwapPattern::PingPong:
+            next = cur == home[s] ? (home[s] + 1) % apps.size() : home[s];
+            break;
+        case SwapPattern::RoundRobin:
+            next = (cur + 1) % apps.size();
+            break;
+        case SwapPattern::Random:
+            next = (cur + 1 + rng() % (apps.size() - 1)) % apps.size();
+            break;
+        }
+
+        SwapRecord rec;
+        rec.iter = iter;
+        rec.slot = slot.slot_id;
+        rec.from = slot.desc.app;
+        rec.to = apps[next].app;
+        rec.bitstream_bytes = bytes[next];
+        auto t0 = std::chrono::steady_clock::now();
+        bool loaded = slot.slot->ensure_app_loaded(apps[next]);
+        rec.total = std::chrono::steady_clock::now() - t0;
+        rec.phases = slot.slot->last_reconfig();
+        if (!loaded) {
+            std::cerr << "[tester] stress iter " << iter << ": loading " << rec.to << " on " << slot.slot->name()
+                      << " failed\n";
+            return false;
+        }
+        slot.desc = apps[next];
+        if (cfg.stress_fft_every && slot.desc.app == "fft" && ++fft_runs % cfg.stress_fft_every == 0) {
+            bool ok = stress_fft(slot, cfg, iter, rng);
+            rec.fft = ok ? 1 : 0;
+            if (!ok) ++fft_failures;
+        }
+        records.push_back(std::move(rec));
+    }
+    double wall_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - wall_start).count();
+
+    auto us = [](std::chrono::nanoseconds d) { return std::chrono::duration<double, std::micro>(d).count(); };
+    std::vector<double> decouple, program, release, total;
+    double total_us = 0;
+    for (const auto& r : records) {
+        decouple.push_back(us(r.phases.decouple));
+        program.push_back(us(r.phases.program));
+        release.push_back(us(r.phases.release));
+        total.push_back(us(r.total));
+        total_us += us(r.total);
+    }
+    auto row = [&](const char* label, const std::vector<double>& v) {
+        std::cout << "  " << std::left << std::setw(9) << label << std::right << std::fixed << std::setprecision(1)
+                  << " p50=" << std::setw(9) << percentile_us(v, 0.5) << "us p90=" << std::setw(9)
+                  << percentile_us(v, 0.9) << "us p99=" << std::setw(9) << percentile_us(v, 0.99)
+                  << "us max=" << std::setw(9) << percentile_us(v, 1.0) << "us" << std::defaultfloat << "\n";
+    };
+    // Throughput is over the wall time of the whole loop, interleaved FFTs
+    // included; latency is per swap.
+    std::cout << "[tester] Swap latency (" << records.size() << " swaps, "
+              << std::fixed << std::setprecision(1)
+              << (wall_seconds > 0 ? static_cast<double>(records.size()) / wall_seconds : 0.0)
+              << " swaps/s, mean="
+              << (records.empty() ? 0.0 : total_us / static_cast<double>(records.size()))
+              << "us)" << std::defaultfloat << "\n";
+    row("decouple", decouple);
+    row("program", program);
+    row("release", release);
+    row("total", total);
+    for (size_t i = 0; i < apps.size(); ++i) {
+        std::vector<double> to_app;
+        for (const auto& r : records) {
+            if (r.to == apps[i].app) to_app.push_back(us(r.total));
+        }
+        if (to_app.empty()) continue;
+        std::cout << "  -> " << std::left << std::setw(10) << apps[i].app << std::right << " swaps=" << to_app.size()
+                  << " bytes=" << bytes[i] << std::fixed << std::setprecision(1)
+                  << " p50=" << percentile_us(to_app, 0.5) << "us p99=" << percentile_us(to_app, 0.99) << "us"
+                  << std::defaultfloat << "\n";
+    }
+    if (cfg.stress_fft_every) {
+        unsigned checked = static_cast<unsigned>(
+            std::count_if(records.begin(), records.end(), [](const SwapRecord& r) { return r.fft >= 0; }));
+        std::cout << "[tester] Interleaved FFTs: " << checked << " run, " << fft_failures << " failed"
+                  << (cfg.fpga_real ? "" : " (mock: output not checked)") << "\n";
+    }
+
+    if (!cfg.stress_csv.empty()) {
+        std::ofstream csv(cfg.stress_csv);
+        if (!csv) {
+            std::cerr << "[tester] cannot write " << cfg.stress_csv << "\n";
+            return false;
+        }
+        csv << "iter,slot,from,to,bitstream_bytes,decouple_ns,program_ns,release_ns,total_ns,fft\n";
+        for (const auto& r : records) {
+            csv << r.iter << "," << r.slot << "," << r.from << "," << r.to << "," << r.bitstream_bytes << ","
+                << r.phases.decouple.count() << "," << r.phases.program.count() << ","
+                << r.phases.release.count() << "," << r.total.count() << ","
+                << (r.fft < 0 ? "" : r.fft ? "ok" : "fail") << "\n";
+        }
+        std::cout << "[tester] Per-swap timings written to " << cfg.stress_csv << "\n";
+    }
+    return fft_failures == 0;
+}
+
 bool run_mmio_probe(const MmioProbe& probe) {
     std::ostringstream desc;
     desc << "mmio probe '" << probe.label << "' base=0x" << std::hex << probe.base;
@@ -573,6 +809,32 @@ int main(int argc, char** argv) {
             cfg.fft_dump = true;
             continue;
         }
+        if (arg.rfind("--stress=", 0) == 0) {
+            auto pattern = parse_swap_pattern(arg.substr(sizeof("--stress=") - 1));
+            if (!pattern) {
+                std::cerr << "[tester] Unknown stress pattern in " << arg << "\n";
+                return 1;
+            }
+            cfg.stress = true;
+            cfg.stress_pattern = *pattern;
+            continue;
+        }
+        if (arg.rfind("--stress-iters=", 0) == 0) {
+            cfg.stress_iters = parse_unsigned(arg.substr(sizeof("--stress-iters=") - 1), cfg.stress_iters);
+            continue;
+        }
+        if (arg.rfind("--stress-fft-every=", 0) == 0) {
+            cfg.stress_fft_every = parse_unsigned(arg.substr(sizeof("--stress-fft-every=") - 1), 1);
+            continue;
+        }
+        if (arg.rfind("--stress-seed=", 0) == 0) {
+            cfg.stress_seed = parse_unsigned(arg.substr(sizeof("--stress-seed=") - 1), cfg.stress_seed);
+            continue;
+        }
+        if (arg.rfind("--stress-csv=", 0) == 0) {
+            cfg.stress_csv = arg.substr(sizeof("--stress-csv=") - 1);
+            continue;
+        }
         if (arg.rfind("--mmio-probe=", 0) == 0) {
             auto spec = parse_mmio_probe(arg.substr(sizeof("--mmio-probe=") - 1));
             if (!spec) {
@@ -641,5 +903,9 @@ int main(int argc, char** argv) {
         std::cout << "[tester] Skipping overlay execution (--run-fft not provided)\n";
     }
 
+    if (cfg.stress && !run_stress(slots, overlays, cfg)) {
+        return 1;
+    }
+
     return 0;
 }
@@ -0,0 +1,133 @@
+// Example scheduling-policy plugin (sched_runner --policy-lib=liblru_policy.so).
+// Keeps resident overlays busy and evicts the least recently used one:
+//   - a task goes to a slot already holding its overlay;
+//   - otherwise, while the ready queue is shorter than the worker pool, to a
+//     CPU provider rather than reconfiguring a slot;
+//   - otherwise to the slot whose overlay was used least recently (empty
+//     slots first), which is reconfigured.
+// Preloads use the same victim choice. Arguments (--policy-args=):
+//   threshold=N  ready tasks of an app that trigger a preload (default 2)
+//   order=fifo   release order within a priority, ignoring deadlines
+#include "apps/policy_interface.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+using namespace schedrt;
+
+namespace {
+
+struct LruPolicy {
+    unsigned threshold = 2;
+    std::mutex mu;
+    std::unordered_map<std::string, uint64_t> last_use;  // app -> tick of its last placement
+    uint64_t tick = 0;
+    uint64_t evictions = 0;
+    uint64_t cpu_spills = 0;
+
+    void touch(const char* app) {
+        std::lock_guard<std::mutex> lk(mu);
+        last_use[app] = ++tick;
+    }
+
+    // Empty slot first, then the least recently used overlay; -1 without slots.
+    int victim(const PolicyState& state) {
+        std::lock_guard<std::mutex> lk(mu);
+        int best = -1;
+        uint64_t best_use = 0;
+        for (uint32_t i = 0; i < state.num_accelerators; ++i) {
+            const auto& acc = state.accelerators[i];
+            if (!acc.reconfigurable) continue;
+            if (!*acc.overlay) return static_cast<int>(i);
+            auto it = last_use.find(acc.overlay);
+            uint64_t use = it != last_use.end() ? it->second : 0;
+            if (best < 0 || use < best_use) {
+                best = static_cast<int>(i);
+                best_use = use;
+            }
+        }
+        return best;
+    }
+};
+
+bool fifo_before(void*, const QueueKey& a, const QueueKey& b) {
+    if (a.priority != b.priority) return a.priority > b.priority;
+    if (a.release != b.release) return a.release < b.release;
+    return a.id < b.id;
+}
+
+int lru_map(void* user, const PolicyTaskInfo& task, const PolicyState& state) {
+    auto* p = static_cast<LruPolicy*>(user);
+    int cpu = -1;
+    for (uint32_t i = 0; i < state.num_accelerators; ++i) {
+        const auto& acc = state.accelerators[i];
+        if (!acc.reconfigurable) {
+            if (cpu < 0) cpu = static_cast<int>(i);
+        } else if (state.use_overlays && std::strcmp(acc.overlay, task.app) == 0) {
+            p->touch(task.app);
+            return static_cast<int>(i);
+        }
+    }
+    if (!state.use_overlays || task.required == ResourceKind::CPU) return cpu >= 0 ? cpu : kPolicyDefault;
+    if (cpu >= 0 && state.ready_depth < state.workers) {
+        std::lock_guard<std::mutex> lk(p->mu);
+        ++p->cpu_spills;
+        return cpu;
+    }
+    int slot = p->victim(state);
+    if (slot < 0) return cpu >= 0 ? cpu : kPolicyDefault;
+    p->touch(task.app);
+    std::lock_guard<std::mutex> lk(p->mu);
+    if (*state.accelerators[slot].overlay) ++p->evictions;
+    return slot;
+}
+
+int lru_evict(void* user, const char* app, const PolicyState& state) {
+    auto* p = static_cast<LruPolicy*>(user);
+    int slot = p->victim(state);
+    if (slot < 0) return kPolicyNone;
+    p->touch(app);
+    std::lock_guard<std::mutex> lk(p->mu);
+    if (*state.accelerators[slot].overlay) ++p->evictions;
+    return slot;
+}
+
+void lru_shutdown(void* user) {
+    auto* p = static_cast<LruPolicy*>(user);
+    std::cout << "[lru_policy] evictions=" << p->evictions << " cpu_spills=" << p->cpu_spills << "\n";
+    delete p;
+}
+
+} // namespace
+
+extern "C" bool policy_initialize(int argc, char** argv, PolicyHooks& hooks) {
+    if (hooks.abi_version != kPolicyAbiVersion) return false;
+    auto* p = new LruPolicy;
+    bool fifo = false;
+    for (int i = 0; i < argc; ++i) {
+        std::string arg(argv[i]);
+        try {
+            if (arg.rfind("threshold=", 0) == 0) {
+                p->threshold = static_cast<unsigned>(std::max(1, std::stoi(arg.substr(sizeof("threshold=") - 1))));
+            } else if (arg == "order=fifo") {
+                fifo = true;
+            } else {
+                std::cerr << "[lru_policy] ignoring " << arg << "\n";
+            }
+        } catch (const std::exception&) {
+            std::cerr << "[lru_policy] ignoring malformed " << arg << "\n";
+        }
+    }
+    hooks.name = "lru";
+    hooks.user = p;
+    if (fifo) hooks.before = fifo_before;
+    hooks.map = lru_map;
+    hooks.preload_threshold = p->threshold;
+    hooks.evict = lru_evict;
+    hooks.shutdown = lru_shutdown;
+    return true;
+}
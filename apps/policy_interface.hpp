@@ -0,0 +1,14 @@
+#pragma once
+#include "schedrt/policy_plugin.hpp"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Fills hooks (see schedrt/policy_plugin.hpp); argv holds the plugin's
+// --policy-args. False aborts the run, e.g. on an ABI version mismatch.
+bool policy_initialize(int argc, char** argv, schedrt::PolicyHooks& hooks);
+
+#ifdef __cplusplus
+}
+#endif
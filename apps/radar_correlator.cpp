@@ -1,7 +1,10 @@
 #include "apps/app_interface.hpp"
 #include "dash/contexts.hpp"
 #include "dash/fft.hpp"
+#include "dash/fft_cpu.hpp"
+#include "dash/host_buffer.hpp"
 #include "dash/provider.hpp"
+#include "dash/vec.hpp"
 #include "dash/completion_bus.hpp"
 #include "schedrt/accelerator.hpp"
 #include "schedrt/application_registry.hpp"
@@ -14,7 +17,6 @@
 #include <fstream>
 #include <future>
 #include <iostream>
-#include <limits>
 #include <string>
 #include <thread>
 #include <vector>
@@ -124,30 +126,37 @@ extern "C" int app_run(int argc, char** argv, Scheduler& sched) {
     std::vector<double> received_raw;
     if (!load_data(asset_dir / "received_input.txt", received_raw)) return 1;
 
-    const size_t target_fft_len = 65536;
-    if (time.size() < target_fft_len) time.resize(target_fft_len, 0.0);
-    if (received_raw.size() < 2 * target_fft_len) received_raw.resize(2 * target_fft_len, 0.0);
-
-    size_t n_samples = target_fft_len;
-    size_t fft_len = target_fft_len;
+    // received_input.txt holds interleaved re/im pairs. The correlation is
+    // linear, so the transform only has to cover every lag: any length of at
+    // least n_samples + n_received - 1 avoids wrap-around. The CPU engine takes
+    // the next 5-smooth length. The overlay's FFT core runs fixed power-of-two
+    // frames (its config channel is unused), so only then pad to its size.
+    const size_t overlay_fft_len = 65536;
+    size_t n_samples = time.size();
+    size_t n_received = received_raw.size() / 2;
+    size_t min_len = n_samples + n_received - 1;
+    size_t fft_len = static_cast<size_t>(dash::fft_fast_size(static_cast<int>(min_len)));
+    if (sched.uses_overlays()) {
+        fft_len = overlay_fft_len;
+        while (fft_len < min_len) fft_len *= 2;
+    }
     size_t complex_slots = 2 * fft_len;
 
-    std::vector<float> chirp(complex_slots, 0.0f);
-    std::vector<float> received(complex_slots, 0.0f);
+    dash::host_vector<float> chirp(complex_slots, 0.0f);
+    dash::host_vector<float> received(complex_slots, 0.0f);
     for (size_t i = 0; i < n_samples; ++i) {
         double phase = M_PI * 500000.0 / 0.000512 * (time[i] * time[i]);
         chirp[2 * i] = static_cast<float>(std::sin(phase));
         chirp[2 * i + 1] = static_cast<float>(std::cos(phase));
     }
-    size_t available = std::min(complex_slots, received_raw.size());
-    for (size_t i = 0; i < available; ++i) {
+    for (size_t i = 0; i < 2 * n_received; ++i) {
         received[i] = static_cast<float>(received_raw[i]);
     }
 
-    std::vector<float> X1(complex_slots, 0.0f);
-    std::vector<float> X2(complex_slots, 0.0f);
-    std::vector<float> corr_freq(complex_slots, 0.0f);
-    std::vector<float> corr_time(complex_slots, 0.0f);
+    dash::host_vector<float> X1(complex_slots, 0.0f);
+    dash::host_vector<float> X2(complex_slots, 0.0f);
+    dash::host_vector<float> corr_freq(complex_slots, 0.0f);
+    dash::host_vector<float> corr_time(complex_slots, 0.0f);
 
     auto fft1 = schedule_fft_task(sched, chirp.data(), X1.data(), fft_len, false);
     auto fft2 = schedule_fft_task(sched, received.data(), X2.data(), fft_len, false);
@@ -156,13 +165,10 @@ extern "C" int app_run(int argc, char** argv, Scheduler& sched) {
         return 1;
     }
 
-    for (size_t i = 0; i < fft_len; ++i) {
-        float a = X1[2 * i];
-        float b = X1[2 * i + 1];
-        float c = X2[2 * i];
-        float d = X2[2 * i + 1];
-        corr_freq[2 * i] = (a * c) + (b * d);
-        corr_freq[2 * i + 1] = (b * c) - (a * d);
+    // corr_freq = X1 * conj(X2)
+    if (!dash::vec::execute({dash::vec::Op::MulConj, X1.data(), X2.data(), corr_freq.data(), fft_len})) {
+        std::cerr << "correlation multiply failed\n";
+        return 1;
     }
 
     auto inverse_fft = schedule_fft_task(sched, corr_freq.data(), corr_time.data(), fft_len, true);
@@ -171,17 +177,19 @@ extern "C" int app_run(int argc, char** argv, Scheduler& sched) {
         return 1;
     }
 
-    float max_corr = std::numeric_limits<float>::lowest();
-    size_t max_index = 0;
-    for (size_t i = 0; i < fft_len; ++i) {
-        float real = corr_time[2 * i];
-        if (real > max_corr) {
-            max_corr = real;
-            max_index = i;
-        }
+    dash::vec::ArgMax peak;
+    if (!dash::vec::execute({dash::vec::Op::ArgMaxReal, corr_time.data(), nullptr, nullptr, fft_len}, &peak)) {
+        std::cerr << "peak search failed\n";
+        return 1;
     }
-
-    double lag = static_cast<double>(n_samples - max_index) / 1000.0;
+    float max_corr = peak.value;
+    size_t max_index = peak.index;
+
+    // Indices past the chirp are negative shifts (received trails the chirp),
+    // reported as a positive lag.
+    double shift = max_index < n_samples ? static_cast<double>(max_index)
+                                         : static_cast<double>(max_index) - static_cast<double>(fft_len);
+    double lag = -shift / 1000.0;
     std::cout << "Radar correlator lag = " << lag << " (max_corr=" << max_corr << ")\n";
     std::this_thread::sleep_for(std::chrono::milliseconds(50));
     return 0;
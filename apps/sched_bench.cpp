@@ -0,0 +1,858 @@
+#include "dash/completion_bus.hpp"
+#include "dash/contexts.hpp"
+#include "dash/fft.hpp"
+#include "dash/fft_cpu.hpp"
+#include "dash/fft_fixed.hpp"
+#include "dash/provider.hpp"
+#include "dash/scheduler_binding.hpp"
+#include "dash/vec.hpp"
+#include "schedrt/accelerator.hpp"
+#include "schedrt/application_registry.hpp"
+#include "schedrt/ready_queue.hpp"
+#include "schedrt/reporting.hpp"
+#include "schedrt/scheduler.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <complex>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <optional>
+#include <queue>
+#include <random>
+#include <sstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+struct Options {
+    std::vector<int> fft_sizes = dash::fft_fixed_sizes();
+    unsigned vec_size = 256 * 512;  // one SAR block
+    unsigned min_reps = 20;
+    unsigned budget_ms = 200;
+    std::vector<std::string> suites = {"fft", "precision", "vec", "inversion", "hedge", "batch", "inline", "heap", "policy"};
+    unsigned workers = 2;
+};
+
+void print_usage(const char* prog) {
+    std::cout << "Usage: " << prog << " [--suite=LIST] [--fft-sizes=N,N,...] [--vec-size=N] [--workers=N] [--reps=N] [--budget-ms=N]\n";
+    std::cout << "  --suite=LIST       comma-separated subset of fft,precision,vec,inversion,hedge,batch,inline,heap,policy (default: all)\n";
+    std::cout << "  --fft-sizes=LIST   FFT lengths to compare (default: sizes with fixed kernels)\n";
+    std::cout << "  --vec-size=N       complex samples for the dash::vec kernels (default 131072)\n";
+    std::cout << "  --workers=N        scheduler workers for the scheduling suites (default 2)\n";
+    std::cout << "  --reps=N           minimum timed repetitions per case (default 20)\n";
+    std::cout << "  --budget-ms=N      keep repeating each case for at least this long (default 200)\n";
+}
+
+std::optional<unsigned> parse_unsigned(const std::string& text) {
+    if (text.empty()) return std::nullopt;
+    unsigned value = 0;
+    for (char c : text) {
+        if (c < '0' || c > '9') return std::nullopt;
+        value = value * 10 + static_cast<unsigned>(c - '0');
+    }
+    return value;
+}
+
+std::vector<std::string> split(const std::string& text) {
+    std::vector<std::string> out;
+    std::istringstream iss(text);
+    std::string part;
+    while (std::getline(iss, part, ',')) {
+        if (!part.empty()) out.push_back(part);
+    }
+    return out;
+}
+
+std::optional<std::vector<int>> parse_list(const std::string& text) {
+    std::vector<int> out;
+    std::istringstream iss(text);
+    std::string part;
+    while (std::getline(iss, part, ',')) {
+        auto v = parse_unsigned(part);
+        if (!v || *v == 0) return std::nullopt;
+        out.push_back(static_cast<int>(*v));
+    }
+    if (out.empty()) return std::nullopt;
+    return out;
+}
+
+// Median wall time in nanoseconds of `fn` over the repetition budget.
+template <typename Fn>
+double time_ns(const Options& opts, Fn&& fn) {
+    using clock = std::chrono::steady_clock;
+    fn();  // warm plans, caches and thread-local work buffers
+    std::vector<double> samples;
+    auto start = clock::now();
+    auto budget = std::chrono::milliseconds(opts.budget_ms);
+    while (samples.size() < opts.min_reps || clock::now() - start < budget) {
+        auto t0 = clock::now();
+        fn();
+        samples.push_back(std::chrono::duration<double, std::nano>(clock::now() - t0).count());
+        if (samples.size() >= 100000) break;
+    }
+    std::sort(samples.begin(), samples.end());
+    return samples[samples.size() / 2];
+}
+
+void print_row(const std::string& label, const std::string& algo, double ns, double baseline_ns, double max_err) {
+    std::cout << "  " << std::left << std::setw(18) << label << std::setw(30) << algo << std::right
+              << std::fixed << std::setprecision(1) << std::setw(12) << ns / 1000.0 << " us"
+              << std::setprecision(2) << std::setw(9) << baseline_ns / ns << "x";
+    if (max_err >= 0) std::cout << std::scientific << std::setprecision(1) << "   max_err=" << max_err;
+    std::cout << std::defaultfloat << "\n";
+}
+
+// Specialised kernel vs the generic engine with the same radices vs the
+// fastest generic decomposition.
+void bench_fft(const Options& opts) {
+    std::cout << "[bench] fft (median of >= " << opts.min_reps << " reps, speedup vs generic default)\n";
+    for (int n : opts.fft_sizes) {
+        std::vector<float> in(static_cast<size_t>(n) * 2), ref(in.size()), out(in.size());
+        for (size_t i = 0; i < in.size(); ++i) in[i] = static_cast<float>(std::sin(0.37 * static_cast<double>(i)));
+
+        for (bool inverse : {false, true}) {
+            dash::FftPlan plan{n, inverse};
+            std::cout << "n=" << n << (inverse ? " inverse\n" : " forward\n");
+
+            dash::FftAlgorithm generic = dash::fft_default_algorithm(n);
+            generic.fixed = false;
+            dash::fft_cpu_execute(plan, generic, in.data(), ref.data());
+            double base_ns = time_ns(opts, [&]{ dash::fft_cpu_execute(plan, generic, in.data(), out.data()); });
+            print_row("generic default", dash::to_string(generic), base_ns, base_ns, -1);
+
+            dash::FftAlgorithm best_generic = generic;
+            double best_ns = base_ns;
+            for (const auto& algo : dash::fft_candidate_algorithms(n)) {
+                if (algo.fixed || (algo.radices == generic.radices && !algo.in_place)) continue;
+                double ns = time_ns(opts, [&]{ dash::fft_cpu_execute(plan, algo, in.data(), out.data()); });
+                if (ns < best_ns) {
+                    best_ns = ns;
+                    best_generic = algo;
+                }
+            }
+            print_row("generic best", dash::to_string(best_generic), best_ns, base_ns, -1);
+
+            if (const auto* kernel = dash::fft_fixed_kernel(n)) {
+                dash::FftAlgorithm fixed{kernel->radices, false, true};
+                dash::fft_cpu_execute(plan, fixed, in.data(), out.data());
+                double err = 0.0;
+                for (size_t i = 0; i < out.size(); ++i) err = std::max(err, static_cast<double>(std::fabs(out[i] - ref[i])));
+                double ns = time_ns(opts, [&]{ dash::fft_cpu_execute(plan, fixed, in.data(), out.data()); });
+                print_row("fixed", dash::to_string(fixed), ns, base_ns, err);
+            } else {
+                std::cout << "  fixed             (no specialised kernel for this size)\n";
+            }
+        }
+    }
+}
+
+// Forward DFT in long double: iterative radix-2 for powers of two, direct
+// sums otherwise. Empty when a direct DFT of n would take too long.
+std::vector<std::complex<long double>> reference_dft(const std::vector<float>& in, size_t n) {
+    using cl = std::complex<long double>;
+    const long double pi = std::acos(-1.0L);
+    std::vector<cl> a(n);
+    for (size_t i = 0; i < n; ++i) a[i] = cl(in[2 * i], in[2 * i + 1]);
+    if ((n & (n - 1)) == 0) {
+        for (size_t i = 1, j = 0; i < n; ++i) {
+            size_t bit = n >> 1;
+            for (; j & bit; bit >>= 1) j ^= bit;
+            j ^= bit;
+            if (i < j) std::swap(a[i], a[j]);
+        }
+        for (size_t len = 2; len <= n; len <<= 1) {
+            for (size_t j = 0; j < len / 2; ++j) {
+                long double angle = -2.0L * pi * static_cast<long double>(j) / static_cast<long double>(len);
+                cl w(std::cos(angle), std::sin(angle));
+                for (size_t i = 0; i < n; i += len) {
+                    cl u = a[i + j], v = a[i + j + len / 2] * w;
+                    a[i + j] = u + v;
+                    a[i + j + len / 2] = u - v;
+                }
+            }
+        }
+        return a;
+    }
+    if (n > 8192) return {};
+    std::vector<cl> out(n);
+    for (size_t k = 0; k < n; ++k) {
+        cl sum = 0;
+        for (size_t j = 0; j < n; ++j) {
+            long double angle = -2.0L * pi * static_cast<long double>((j * k) % n) / static_cast<long double>(n);
+            sum += a[j] * cl(std::cos(angle), std::sin(angle));
+        }
+        out[k] = sum;
+    }
+    return out;
+}
+
+// Each FftPrecision on the default algorithm (the fixed kernel where one
+// exists) and on the generic engine: time, speedup over fp64, and error
+// against a long double reference. rel_rms is ||out - ref|| / ||ref||;
+// max_rel is the worst bin error over the reference RMS.
+void bench_precision(const Options& opts) {
+    constexpr dash::FftPrecision kPrecisions[] = {dash::FftPrecision::Fp32, dash::FftPrecision::Mixed,
+                                                  dash::FftPrecision::Fp64};
+    std::cout << "[bench] fft precision (forward, median of >= " << opts.min_reps
+              << " reps, speedup vs fp64, error vs long double reference)\n";
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+    for (int n : opts.fft_sizes) {
+        std::vector<float> in(static_cast<size_t>(n) * 2), out(in.size());
+        for (auto& v : in) v = dist(rng);
+        auto ref = reference_dft(in, static_cast<size_t>(n));
+        long double ref_energy = 0;
+        for (const auto& v : ref) ref_energy += std::norm(v);
+        double ref_rms = std::sqrt(static_cast<double>(ref_energy / n));
+
+        dash::FftAlgorithm generic = dash::fft_default_algorithm(n);
+        generic.fixed = false;
+        std::vector<dash::FftAlgorithm> algos;
+        if (const auto* kernel = dash::fft_fixed_kernel(n)) algos.push_back({kernel->radices, false, true});
+        algos.push_back(generic);
+        std::cout << "n=" << n << "  fp32 bound: rel_rms <= eps*log2(n)/2 = " << std::scientific
+                  << std::setprecision(1) << std::ldexp(1.0, -24) * std::log2(static_cast<double>(n)) / 2
+                  << std::defaultfloat << "\n";
+        for (const auto& algo : algos) {
+            double ns[3] = {};
+            double rel_rms[3] = {}, max_rel[3] = {};
+            for (size_t p = 0; p < 3; ++p) {
+                dash::FftPlan plan{n, false, kPrecisions[p]};
+                dash::fft_cpu_execute(plan, algo, in.data(), out.data());
+                long double err = 0, worst = 0;
+                for (size_t i = 0; i < ref.size(); ++i) {
+                    long double e = std::norm(std::complex<long double>(out[2 * i], out[2 * i + 1]) - ref[i]);
+                    err += e;
+                    worst = std::max(worst, e);
+                }
+                if (!ref.empty()) {
+                    rel_rms[p] = std::sqrt(static_cast<double>(err / ref_energy));
+                    max_rel[p] = std::sqrt(static_cast<double>(worst)) / ref_rms;
+                }
+                ns[p] = time_ns(opts, [&] { dash::fft_cpu_execute(plan, algo, in.data(), out.data()); });
+            }
+            std::cout << "  " << dash::to_string(algo) << "\n";
+            for (size_t p = 0; p < 3; ++p) {
+                std::cout << "    " << std::left << std::setw(6) << dash::to_string(kPrecisions[p]) << std::right
+                          << std::fixed << std::setprecision(1) << std::setw(10) << ns[p] / 1000.0 << " us"
+                          << std::setprecision(2) << std::setw(7) << ns[2] / ns[p] << "x";
+                if (ref.empty()) {
+                    std::cout << "   (no reference for this size)";
+                } else {
+                    std::cout << std::scientific << std::setprecision(1) << "   rel_rms=" << rel_rms[p]
+                              << "  max_rel=" << max_rel[p];
+                }
+                std::cout << std::defaultfloat << "\n";
+            }
+        }
+    }
+}
+
+// dash::vec kernels on one thread vs the scalar loops the apps used to run.
+void bench_vec(const Options& opts) {
+    size_t n = opts.vec_size;
+    std::cout << "[bench] vec n=" << n << " (median, speedup vs scalar loop)\n";
+    std::vector<float> a(2 * n), b(2 * n), out(2 * n);
+    for (size_t i = 0; i < a.size(); ++i) {
+        a[i] = static_cast<float>(std::sin(0.37 * static_cast<double>(i)));
+        b[i] = static_cast<float>(std::cos(0.11 * static_cast<double>(i)));
+    }
+    volatile size_t sink = 0;
+
+    double scalar = time_ns(opts, [&]{
+        for (size_t i = 0; i < n; ++i) {
+            float ar = a[2 * i], ai = a[2 * i + 1], br = b[2 * i], bi = b[2 * i + 1];
+            out[2 * i] = ar * br + ai * bi;
+            out[2 * i + 1] = ai * br - ar * bi;
+        }
+    });
+    print_row("mul_conj", "dash::vec::mul_conj",
+              time_ns(opts, [&]{ dash::vec::mul_conj(a.data(), b.data(), out.data(), n); }), scalar, -1);
+
+    scalar = time_ns(opts, [&]{
+        for (size_t i = 0; i < n; ++i) out[i] = std::sqrt(a[2 * i] * a[2 * i] + a[2 * i + 1] * a[2 * i + 1]);
+    });
+    print_row("magnitude", "dash::vec::magnitude",
+              time_ns(opts, [&]{ dash::vec::magnitude(a.data(), out.data(), n); }), scalar, -1);
+
+    scalar = time_ns(opts, [&]{
+        float best = -1e30f;
+        size_t idx = 0;
+        for (size_t i = 0; i < n; ++i) {
+            if (a[2 * i] > best) {
+                best = a[2 * i];
+                idx = i;
+            }
+        }
+        sink = idx;
+    });
+    print_row("argmax", "dash::vec::argmax_real",
+              time_ns(opts, [&]{ sink = dash::vec::argmax_real(a.data(), n).index; }), scalar, -1);
+
+    scalar = time_ns(opts, [&]{
+        for (size_t i = 0; i < n / 2; ++i) {
+            std::swap(a[2 * i], a[2 * (i + n / 2)]);
+            std::swap(a[2 * i + 1], a[2 * (i + n / 2) + 1]);
+        }
+    });
+    print_row("fftshift", "dash::vec::fftshift",
+              time_ns(opts, [&]{ dash::vec::fftshift(a.data(), out.data(), n); }), scalar, -1);
+    (void)sink;
+}
+
+double percentile(std::vector<double> v, double p) {
+    if (v.empty()) return 0.0;
+    std::sort(v.begin(), v.end());
+    return v[std::min(v.size() - 1, static_cast<size_t>(p * static_cast<double>(v.size())))];
+}
+
+// Mixed load on a live scheduler: every round adds a burst of mid-priority
+// work plus a high-priority task that depends on a low-priority one. Without
+// inheritance the prerequisite queues behind the whole mid backlog.
+void bench_inversion(const Options& opts) {
+    using namespace std::chrono;
+    constexpr unsigned kRounds = 20, kMidPerRound = 8;
+    std::cout << "[bench] priority inversion: " << kRounds << " rounds of " << kMidPerRound
+              << " mid (prio 5, 2ms) + low (prio 0, 1ms) <- high (prio 10, 1ms), " << opts.workers << " workers\n";
+    schedrt::reporting::set_quiet(true);
+    for (bool inherit : {false, true}) {
+        schedrt::ApplicationRegistry reg;
+        reg.register_app({"work", "", "work_kernel"});
+        schedrt::Scheduler sched(reg, schedrt::BackendMode::CPU, opts.workers, 0);
+        sched.add_accelerator(schedrt::make_cpu_mock(0));
+        sched.set_priority_inheritance(inherit);
+        sched.start();
+
+        std::mutex mu;
+        std::vector<double> high_ms, mid_ms;
+        std::atomic<unsigned> done{0};
+        uint64_t next_id = 1;
+        auto make = [&](int prio, milliseconds est, std::vector<double>* sink) {
+            auto t = std::make_shared<schedrt::Task>();
+            t->id = next_id++;
+            t->app = "work";
+            t->priority = prio;
+            t->est_runtime_ns = est;
+            auto start = steady_clock::now();
+            t->on_complete = [&, sink, start](const schedrt::ExecutionResult&) {
+                if (sink) {
+                    std::lock_guard<std::mutex> lk(mu);
+                    sink->push_back(duration<double, std::milli>(steady_clock::now() - start).count());
+                }
+                done.fetch_add(1);
+            };
+            return t;
+        };
+        unsigned total = 0;
+        for (unsigned r = 0; r < kRounds; ++r) {
+            for (unsigned i = 0; i < kMidPerRound; ++i, ++total) sched.submit(make(5, milliseconds(2), &mid_ms));
+            auto low = make(0, milliseconds(1), nullptr);
+            auto high = make(10, milliseconds(1), &high_ms);
+            high->depends_on.push_back(low->id);
+            sched.submit(low);
+            sched.submit(high);
+            total += 2;
+            std::this_thread::sleep_for(milliseconds(4));
+        }
+        while (done.load() < total) std::this_thread::sleep_for(milliseconds(1));
+        sched.stop();
+        std::cout << "  inheritance " << (inherit ? "on " : "off") << std::fixed << std::setprecision(1)
+                  << "  high p50=" << percentile(high_ms, 0.5) << "ms p99=" << percentile(high_ms, 0.99)
+                  << "ms max=" << percentile(high_ms, 1.0) << "ms   mid p50=" << percentile(mid_ms, 0.5)
+                  << "ms" << std::defaultfloat << "\n";
+    }
+    schedrt::reporting::set_quiet(false);
+}
+
+// Mock FFT slot where a few runs stall before starting, as behind a slow DMA
+// or a pending reconfiguration. The stall is the same for a given task id in
+// every run and ends early once the attempt is cancelled.
+class StallingSlot : public schedrt::FpgaSlotAccelerator {
+public:
+    StallingSlot(unsigned slot, unsigned stall_percent, std::chrono::milliseconds stall)
+        : FpgaSlotAccelerator(slot), stall_percent_(stall_percent), stall_(stall) {}
+
+    schedrt::ExecutionResult run(const schedrt::Task& task, const schedrt::AppDescriptor& app) override {
+        std::lock_guard<std::mutex> lk(mu_);
+        if ((task.id * 2654435761u) % 100 < stall_percent_) {
+            auto end = std::chrono::steady_clock::now() + stall_;
+            while (std::chrono::steady_clock::now() < end && !schedrt::cancelled(task))
+                std::this_thread::sleep_for(std::chrono::microseconds(200));
+        }
+        return FpgaSlotAccelerator::run(task, app);
+    }
+
+private:
+    unsigned stall_percent_;
+    std::chrono::milliseconds stall_;
+    std::mutex mu_;
+};
+
+// Open-loop stream of 1ms FFT tasks onto one stalling slot, with and without
+// hedging to the CPU provider. Latency runs from release to completion.
+void bench_hedge(const Options& opts) {
+    using namespace std::chrono;
+    constexpr unsigned kTasks = 2000, kStallPercent = 1;
+    constexpr milliseconds kRuntime(1), kStall(20);
+    constexpr microseconds kPeriod(2000);
+    // A primary stuck on the slot keeps its worker, so duplicates need spare ones.
+    unsigned workers = std::max(opts.workers, 4u);
+    std::cout << "[bench] hedging: " << kTasks << " FFT tasks (1ms) every 2ms on one slot, " << kStallPercent
+              << "% stall 20ms, " << workers << " workers\n";
+    schedrt::reporting::set_quiet(true);
+    for (bool hedge : {false, true}) {
+        schedrt::ApplicationRegistry reg;
+        reg.register_app({"fft", "", "fft_kernel", schedrt::ResourceKind::FFT});
+        schedrt::Scheduler sched(reg, schedrt::BackendMode::FPGA, workers, 0);
+        sched.add_accelerator(std::make_unique<StallingSlot>(0, kStallPercent, kStall));
+        sched.add_accelerator(schedrt::make_cpu_mock(0));
+        schedrt::HedgePolicy policy;
+        policy.enabled = hedge;
+        policy.percentile = 0.95;
+        sched.set_hedging(policy);
+        sched.start();
+
+        std::mutex mu;
+        std::vector<double> ms;
+        std::atomic<unsigned> done{0};
+        auto next = steady_clock::now();
+        for (unsigned i = 0; i < kTasks; ++i) {
+            auto t = std::make_shared<schedrt::Task>();
+            t->id = i + 1;
+            t->app = "fft";
+            t->required = schedrt::ResourceKind::FFT;
+            t->est_runtime_ns = kRuntime;
+            t->hedge = true;
+            auto start = t->release_time;
+            t->on_complete = [&, start](const schedrt::ExecutionResult&) {
+                {
+                    std::lock_guard<std::mutex> lk(mu);
+                    ms.push_back(duration<double, std::milli>(steady_clock::now() - start).count());
+                }
+                done.fetch_add(1);
+            };
+            sched.submit(t);
+            next += kPeriod;
+            std::this_thread::sleep_until(next);
+        }
+        while (done.load() < kTasks) std::this_thread::sleep_for(milliseconds(1));
+        sched.stop();
+        std::cout << "  hedging " << (hedge ? "on " : "off") << std::fixed << std::setprecision(2)
+                  << "  p50=" << percentile(ms, 0.5) << "ms p99=" << percentile(ms, 0.99)
+                  << "ms p99.9=" << percentile(ms, 0.999) << "ms max=" << percentile(ms, 1.0) << "ms"
+                  << std::defaultfloat;
+        if (hedge) {
+            auto hs = sched.hedge_stats();
+            std::cout << "   launched=" << hs.launched << " hedge_wins=" << hs.hedge_wins
+                      << " cancelled=" << hs.cancelled;
+        }
+        std::cout << "\n";
+    }
+    schedrt::reporting::set_quiet(false);
+}
+
+// Concurrent callers each issuing small same-size dash::fft_execute calls,
+// with the coalescer off and at a few batch/window settings.
+void bench_batch(const Options& opts) {
+    using namespace std::chrono;
+    constexpr unsigned kCallers = 8, kCallsPerCaller = 200;
+    constexpr int kSize = 512;
+    struct Setting {
+        unsigned max_batch;
+        unsigned window_us;
+    };
+    // The last one never fills with kCallers callers, so every request waits out the window.
+    const Setting settings[] = {{1, 0}, {4, 50}, {8, 100}, {8, 500}, {16, 500}};
+    std::cout << "[bench] fft batching: " << kCallers << " callers x " << kCallsPerCaller << " " << kSize
+              << "-point FFTs, " << opts.workers << " workers\n";
+    schedrt::reporting::set_quiet(true);
+    dash::register_provider({"fft", schedrt::ResourceKind::CPU, 0, 10});
+    for (const auto& setting : settings) {
+        schedrt::ApplicationRegistry reg;
+        reg.register_app({"fft", "", "fft_kernel", schedrt::ResourceKind::CPU});
+        schedrt::Scheduler sched(reg, schedrt::BackendMode::CPU, opts.workers, 0);
+        sched.add_accelerator(schedrt::make_cpu_mock(0));
+        dash::set_scheduler(&sched);
+        dash::fft_set_batching({setting.max_batch, microseconds(setting.window_us)});
+        auto before = dash::fft_batch_stats();
+        sched.start();
+
+        std::mutex mu;
+        std::vector<double> us;
+        std::atomic<unsigned> failures{0};
+        auto t0 = steady_clock::now();
+        std::vector<std::thread> callers;
+        for (unsigned c = 0; c < kCallers; ++c) {
+            callers.emplace_back([&, c] {
+                std::vector<float> in(2 * kSize), out(2 * kSize);
+                for (int i = 0; i < 2 * kSize; ++i) in[i] = std::sin(0.01f * static_cast<float>(i * (c + 1)));
+                std::vector<double> mine;
+                for (unsigned k = 0; k < kCallsPerCaller; ++k) {
+                    auto start = steady_clock::now();
+                    if (!dash::fft_execute({kSize, false}, {in.data(), in.size() * sizeof(float)},
+                                           {out.data(), out.size() * sizeof(float)}))
+                        failures.fetch_add(1);
+                    mine.push_back(duration<double, std::micro>(steady_clock::now() - start).count());
+                }
+                std::lock_guard<std::mutex> lk(mu);
+                us.insert(us.end(), mine.begin(), mine.end());
+            });
+        }
+        for (auto& t : callers) t.join();
+        double secs = duration<double>(steady_clock::now() - t0).count();
+        sched.stop();
+        auto after = dash::fft_batch_stats();
+        uint64_t batches = after.batches - before.batches;
+        double avg = batches ? static_cast<double>(after.requests - before.requests) / static_cast<double>(batches) : 1.0;
+        std::ostringstream label;
+        if (setting.max_batch > 1) {
+            label << "batch<=" << setting.max_batch << " window=" << setting.window_us << "us";
+        } else {
+            label << "off";
+        }
+        std::cout << "  " << std::left << std::setw(24) << label.str() << std::right << std::fixed
+                  << std::setprecision(0) << std::setw(8) << static_cast<double>(us.size()) / secs << " FFT/s"
+                  << "  p50=" << percentile(us, 0.5) << "us p99=" << percentile(us, 0.99) << "us"
+                  << std::setprecision(1) << "  avg batch=" << avg << std::defaultfloat;
+        if (failures.load()) std::cout << "  failures=" << failures.load();
+        std::cout << "\n";
+    }
+    dash::fft_set_batching({});
+    dash::set_scheduler(nullptr);
+    schedrt::reporting::set_quiet(false);
+}
+
+// End-to-end latency of micro-ops submitted one at a time and waited on, as
+// a DASH caller does: submit to completion-future resolution.
+void bench_inline(const Options& opts) {
+    using namespace std::chrono;
+    constexpr unsigned kOps = 2000;
+    std::cout << "[bench] inline fast path: " << kOps << " sequential micro-ops each, " << opts.workers
+              << " workers\n";
+    schedrt::reporting::set_quiet(true);
+    std::vector<float> fft_in(2 * 64), fft_out(2 * 64);
+    for (size_t i = 0; i < fft_in.size(); ++i) fft_in[i] = std::sin(0.1f * static_cast<float>(i));
+    std::vector<uint8_t> zip_in(256), zip_out(512);
+    for (size_t i = 0; i < zip_in.size(); ++i) zip_in[i] = static_cast<uint8_t>(i % 7);
+
+    for (bool on : {false, true}) {
+        schedrt::ApplicationRegistry reg;
+        reg.register_app({"fft", "", "fft_kernel", schedrt::ResourceKind::CPU});
+        reg.register_app({"zip", "", "zip_kernel", schedrt::ResourceKind::CPU});
+        schedrt::Scheduler sched(reg, schedrt::BackendMode::CPU, opts.workers, 0);
+        sched.add_accelerator(schedrt::make_cpu_mock(0));
+        if (on) sched.set_inline_policy({microseconds(50), 64 * 1024});
+        sched.start();
+
+        uint64_t next_id = 1;
+        auto measure = [&](const char* app, const char* key, const void* ctx) {
+            std::vector<double> us;
+            us.reserve(kOps);
+            for (unsigned i = 0; i < kOps; ++i) {
+                auto t = std::make_shared<schedrt::Task>();
+                t->id = next_id++;
+                t->app = app;
+                t->params.emplace(key, std::to_string(reinterpret_cast<std::uintptr_t>(ctx)));
+                auto start = steady_clock::now();
+                auto fut = dash::subscribe(t->id);
+                sched.submit(t);
+                fut.get();
+                us.push_back(duration<double, std::micro>(steady_clock::now() - start).count());
+            }
+            return us;
+        };
+        dash::FftContext fft;
+        fft.plan = {64, false};
+        fft.in = {fft_in.data(), fft_in.size() * sizeof(float)};
+        fft.out = {fft_out.data(), fft_out.size() * sizeof(float)};
+        size_t zip_actual = 0;
+        dash::ZipContext zip;
+        zip.params.level = 1;
+        zip.in = {zip_in.data(), zip_in.size()};
+        zip.out = {zip_out.data(), zip_out.size()};
+        zip.out_actual = &zip_actual;
+
+        auto fft_us = measure("fft", dash::kFftContextKey, &fft);
+        auto zip_us = measure("zip", dash::kZipContextKey, &zip);
+        sched.stop();
+        std::cout << "  inline " << (on ? "on " : "off") << std::fixed << std::setprecision(1)
+                  << "  fft64 p50=" << percentile(fft_us, 0.5) << "us p99=" << percentile(fft_us, 0.99)
+                  << "us   zip256 p50=" << percentile(zip_us, 0.5) << "us p99=" << percentile(zip_us, 0.99)
+                  << "us" << std::defaultfloat << "\n";
+    }
+    schedrt::reporting::set_quiet(false);
+}
+
+// n ready tasks with mixed priorities, deadlines and release times,
+// allocated in shuffled order.
+std::vector<std::shared_ptr<schedrt::Task>> random_ready_tasks(size_t n, std::mt19937_64& rng) {
+    using namespace std::chrono;
+    auto now = steady_clock::now();
+    std::vector<std::shared_ptr<schedrt::Task>> tasks(n);
+    std::vector<size_t> order(n);
+    for (size_t i = 0; i < n; ++i) order[i] = i;
+    std::shuffle(order.begin(), order.end(), rng);
+    for (size_t i : order) {
+        auto t = std::make_shared<schedrt::Task>();
+        t->id = i + 1;
+        t->effective_priority = static_cast<int>(rng() % 4);
+        if (rng() % 2) t->effective_deadline = now + microseconds(rng() % 100000);
+        t->release_time = now + microseconds(rng() % 1000);
+        tasks[i] = std::move(t);
+    }
+    return tasks;
+}
+
+// Median of run() over a few reps, in ns per task.
+template <typename Fn>
+double median_ns_per(size_t n, Fn&& run) {
+    using namespace std::chrono;
+    std::vector<double> ns;
+    int reps = n < 100000 ? 11 : 3;
+    for (int rep = 0; rep < reps; ++rep) {
+        auto t0 = steady_clock::now();
+        run();
+        ns.push_back(duration<double, std::nano>(steady_clock::now() - t0).count() / static_cast<double>(n));
+    }
+    std::sort(ns.begin(), ns.end());
+    return ns[ns.size() / 2];
+}
+
+// Ready-queue cost at depth: push n ready tasks, then pop them all, with the
+// inline-key 4-ary heap and with a shared_ptr heap on TaskCompare (what the
+// scheduler used before). Tasks are allocated in shuffled order so the
+// baseline's comparisons chase pointers the way a long-running queue does.
+void bench_heap(const Options&) {
+    std::cout << "[bench] ready heap: push n then pop n, ns per push+pop (median)\n";
+    std::mt19937_64 rng(42);
+    for (size_t n : {size_t(1000), size_t(10000), size_t(100000), size_t(1000000)}) {
+        auto tasks = random_ready_tasks(n, rng);
+        auto median_ns = [&](auto&& run) { return median_ns_per(n, run); };
+        uint64_t check_base = 0, check_heap = 0;
+        // Both queues persist across reps, as the scheduler's does.
+        std::mutex base_mu;
+        std::priority_queue<std::shared_ptr<schedrt::Task>, std::vector<std::shared_ptr<schedrt::Task>>,
+                            schedrt::TaskCompare> base;
+        schedrt::ReadyQueue ready;
+        double base_ns = median_ns([&] {
+            for (auto& t : tasks) {
+                std::lock_guard<std::mutex> lk(base_mu);
+                base.push(t);
+            }
+            check_base = 0;
+            while (true) {
+                std::lock_guard<std::mutex> lk(base_mu);
+                if (base.empty()) break;
+                check_base = check_base * 31 + base.top()->id;
+                base.pop();
+            }
+        });
+        double heap_ns = median_ns([&] {
+            for (auto& t : tasks) ready.push(t);
+            check_heap = 0;
+            while (auto t = ready.try_pop()) check_heap = check_heap * 31 + t->id;
+        });
+        std::cout << "  n=" << std::left << std::setw(9) << n << std::right << std::fixed << std::setprecision(1)
+                  << "shared_ptr heap " << std::setw(7) << base_ns << " ns   inline-key heap " << std::setw(7)
+                  << heap_ns << " ns" << std::setprecision(2) << std::setw(8) << base_ns / heap_ns << "x"
+                  << std::defaultfloat << (check_base == check_heap ? "" : "   (pop order differs!)") << "\n";
+    }
+}
+
+// The ordering a runtime-pluggable policy would give the queue: every
+// comparison is a virtual call.
+struct OrderingHook {
+    virtual ~OrderingHook() = default;
+    virtual bool before(const schedrt::QueueKey& a, const schedrt::QueueKey& b) const = 0;
+};
+
+template <class Order>
+struct OrderingHookFor final : OrderingHook {
+    bool before(const schedrt::QueueKey& a, const schedrt::QueueKey& b) const override { return Order::before(a, b); }
+};
+
+const OrderingHook* g_order_hook = nullptr;
+
+struct HookOrder {
+    static bool before(const schedrt::QueueKey& a, const schedrt::QueueKey& b) { return g_order_hook->before(a, b); }
+};
+
+// Completes at once, so only the scheduler's own per-task cost is timed.
+class NullAccelerator final : public schedrt::Accelerator {
+public:
+    std::string name() const override { return "cpu-null"; }
+    bool is_available() override { return true; }
+    bool ensure_app_loaded(const schedrt::AppDescriptor&) override { return true; }
+    schedrt::ExecutionResult run(const schedrt::Task& task, const schedrt::AppDescriptor&) override {
+        return {task.id, true, {}, std::chrono::nanoseconds(0), "cpu-null"};
+    }
+};
+
+// Policy dispatch cost. First the ready queue alone: push n then pop n with
+// the order compiled in, as in a SchedulerCore instantiation, and with the
+// same order behind a virtual call, as a runtime-pluggable policy would have
+// it (reps alternate between the two). Then whole submit-to-completion
+// dispatch of no-op tasks through each stock policy set.
+void bench_policy(const Options& opts) {
+    using namespace std::chrono;
+    std::cout << "[bench] ordering policy: push n then pop n, ns per push+pop (median)\n";
+    std::mt19937_64 rng(7);
+    OrderingHookFor<schedrt::PriorityOrder> priority_hook;
+    OrderingHookFor<schedrt::EdfOrder> edf_hook;
+    for (size_t n : {size_t(1000), size_t(100000), size_t(1000000)}) {
+        auto tasks = random_ready_tasks(n, rng);
+        auto row = [&](const char* name, auto& compiled, const OrderingHook& hook) {
+            schedrt::BasicReadyQueue<HookOrder> dynamic;
+            g_order_hook = &hook;
+            uint64_t check[2] = {0, 0};
+            std::vector<double> ns[2];
+            auto once = [&](auto& queue, int which) {
+                auto t0 = steady_clock::now();
+                for (auto& t : tasks) queue.push(t);
+                check[which] = 0;
+                while (auto t = queue.try_pop()) check[which] = check[which] * 31 + t->id;
+                ns[which].push_back(duration<double, std::nano>(steady_clock::now() - t0).count() /
+                                    static_cast<double>(n));
+            };
+            int reps = n < 100000 ? 21 : 5;
+            for (int rep = 0; rep < reps; ++rep) {
+                once(dynamic, 0);
+                once(compiled, 1);
+            }
+            double virtual_ns = percentile(ns[0], 0.5), compiled_ns = percentile(ns[1], 0.5);
+            std::cout << "  " << std::left << std::setw(9) << name << "n=" << std::setw(9) << n << std::right
+                      << std::fixed << std::setprecision(1) << "virtual " << std::setw(7) << virtual_ns
+                      << " ns   compiled " << std::setw(7) << compiled_ns << " ns" << std::setprecision(2)
+                      << std::setw(8) << virtual_ns / compiled_ns << "x" << std::defaultfloat
+                      << (check[0] == check[1] ? "" : "   (pop order differs!)") << "\n";
+        };
+        schedrt::BasicReadyQueue<schedrt::PriorityOrder> priority_queue;
+        schedrt::BasicReadyQueue<schedrt::EdfOrder> edf_queue;
+        row("priority", priority_queue, priority_hook);
+        row("edf", edf_queue, edf_hook);
+    }
+
+    constexpr unsigned kTasks = 200000;
+    std::cout << "[bench] policy sets: " << kTasks << " no-op tasks submit-to-completion, " << opts.workers
+              << " workers, ns per task (median of 5)\n";
+    schedrt::reporting::set_quiet(true);
+    for (auto policy : {schedrt::SchedulerPolicy::Default, schedrt::SchedulerPolicy::NoPreload,
+                        schedrt::SchedulerPolicy::Edf, schedrt::SchedulerPolicy::Fifo}) {
+        std::vector<double> ns;
+        for (int rep = 0; rep < 5; ++rep) {
+            schedrt::ApplicationRegistry reg;
+            reg.register_app({"work", "", "work_kernel"});
+            schedrt::Scheduler sched(reg, schedrt::BackendMode::CPU, policy, opts.workers, 3);
+            sched.add_accelerator(std::make_unique<NullAccelerator>());
+            sched.start();
+            std::atomic<unsigned> done{0};
+            std::vector<std::shared_ptr<schedrt::Task>> tasks(kTasks);
+            for (unsigned i = 0; i < kTasks; ++i) {
+                auto t = std::make_shared<schedrt::Task>();
+                t->id = i + 1;
+                t->app = "work";
+                t->priority = static_cast<int>(i % 4);
+                t->on_complete = [&done](const schedrt::ExecutionResult&) {
+                    done.fetch_add(1, std::memory_order_relaxed);
+                };
+                tasks[i] = std::move(t);
+            }
+            auto t0 = steady_clock::now();
+            for (auto& t : tasks) sched.submit(t);
+            while (done.load(std::memory_order_relaxed) < kTasks) std::this_thread::yield();
+            ns.push_back(duration<double, std::nano>(steady_clock::now() - t0).count() / kTasks);
+            sched.stop();
+        }
+        std::cout << "  " << std::left << std::setw(16) << schedrt::to_string(policy) << std::right << std::fixed
+                  << std::setprecision(1) << std::setw(7) << percentile(ns, 0.5) << " ns" << std::defaultfloat
+                  << "\n";
+    }
+    schedrt::reporting::set_quiet(false);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options opts;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--help" || arg == "-h") {
+            print_usage(argv[0]);
+            return 0;
+        }
+        if (arg.rfind("--fft-sizes=", 0) == 0) {
+            auto val = parse_list(arg.substr(sizeof("--fft-sizes=") - 1));
+            if (!val) {
+                std::cerr << "Invalid --fft-sizes value\n";
+                return 1;
+            }
+            opts.fft_sizes = *val;
+            continue;
+        }
+        if (arg.rfind("--vec-size=", 0) == 0) {
+            auto val = parse_unsigned(arg.substr(sizeof("--vec-size=") - 1));
+            if (!val || *val == 0) {
+                std::cerr << "Invalid --vec-size value\n";
+                return 1;
+            }
+            opts.vec_size = *val;
+            continue;
+        }
+        if (arg.rfind("--suite=", 0) == 0) {
+            opts.suites = split(arg.substr(sizeof("--suite=") - 1));
+            continue;
+        }
+        if (arg.rfind("--workers=", 0) == 0) {
+            auto val = parse_unsigned(arg.substr(sizeof("--workers=") - 1));
+            if (!val || *val == 0) {
+                std::cerr << "Invalid --workers value\n";
+                return 1;
+            }
+            opts.workers = *val;
+            continue;
+        }
+        if (arg.rfind("--reps=", 0) == 0) {
+            auto val = parse_unsigned(arg.substr(sizeof("--reps=") - 1));
+            if (!val || *val == 0) {
+                std::cerr << "Invalid --reps value\n";
+                return 1;
+            }
+            opts.min_reps = *val;
+            continue;
+        }
+        if (arg.rfind("--budget-ms=", 0) == 0) {
+            auto val = parse_unsigned(arg.substr(sizeof("--budget-ms=") - 1));
+            if (!val) {
+                std::cerr << "Invalid --budget-ms value\n";
+                return 1;
+            }
+            opts.budget_ms = *val;
+            continue;
+        }
+        std::cerr << "Unknown option: " << arg << "\n";
+        print_usage(argv[0]);
+        return 1;
+    }
+
+    auto wants = [&](const char* suite) {
+        return std::find(opts.suites.begin(), opts.suites.end(), suite) != opts.suites.end();
+    };
+    if (wants("fft")) bench_fft(opts);
+    if (wants("precision")) bench_precision(opts);
+    if (wants("vec")) bench_vec(opts);
+    if (wants("inversion")) bench_inversion(opts);
+    if (wants("hedge")) bench_hedge(opts);
+    if (wants("batch")) bench_batch(opts);
+    if (wants("inline")) bench_inline(opts);
+    if (wants("heap")) bench_heap(opts);
+    if (wants("policy")) bench_policy(opts);
+    return 0;
+}
@@ -1,12 +1,19 @@
 #include "apps/app_interface.hpp"
+#include "dash/fft.hpp"
+#include "dash/fft_wisdom.hpp"
 #include "dash/provider.hpp"
 #include "dash/scheduler_binding.hpp"
 #include "schedrt/accelerator.hpp"
+#include "schedrt/federation.hpp"
+#include "schedrt/instrumented_mutex.hpp"
+#include "schedrt/perf_counters.hpp"
+#include "schedrt/policy_plugin.hpp"
 #include "schedrt/reporting.hpp"
 #include "schedrt/scheduler.hpp"
 #include "schedrt/application_registry.hpp"
 
 #include <dlfcn.h>
+#include <csignal>
 #include <cstdlib>
 #include <filesystem>
 #include <iostream>
@@ -15,6 +22,7 @@
 #include <thread>
 #include <unordered_set>
 #include <vector>
+#include <unistd.h>
 
 using namespace schedrt;
 
@@ -23,12 +31,35 @@ namespace {
 void print_usage(const char* prog) {
     std::cout << "Usage: " << prog << " --app-lib=PATH [--backend=auto|cpu|fpga] [--cpu-workers=N] "
               << "[--preload-threshold=N] -- [app args...]\n";
+    std::cout << "  --policy=NAME         scheduling policy set: default, edf, fifo, resident-first or no-preload\n";
+    std::cout << "  --policy-lib=PATH     load a scheduling-policy plugin (policy_initialize); overrides --policy\n";
+    std::cout << "  --policy-args=LIST    comma-separated arguments passed to the policy plugin\n";
     std::cout << "  --csv-report          emit task lines as CSV (id,ok,msg,time_ns)\n";
     std::cout << "  --fpga-debug          enable verbose logging inside the FPGA accelerators\n";
     std::cout << "  --trace-all           enable every available debug/trace log (fpga + DMA)\n";
     std::cout << "  --fpga-pr-gpio=N      GPIO number that gates the PR region (asserted during reconfig)\n";
     std::cout << "  --fpga-pr-gpio-active-low  Treat the PR GPIO as active-low (default active-high)\n";
     std::cout << "  --fpga-pr-gpio-delay-ms=N  Delay after toggling the PR GPIO (default 5ms)\n";
+    std::cout << "  --metrics-summary     print per-app task metrics after the app finishes\n";
+    std::cout << "  --perf-counters       collect per-task cycles/instructions/cache misses/context switches/migrations (implies --metrics-summary)\n";
+    std::cout << "  --worker-times        split each worker's wall time into idle/select/execute/lock wait/report/other and print it at exit\n";
+    std::cout << "  --live-stats[=NAME]   publish live counters to POSIX shm segment NAME (default schedrt) for sched_top\n";
+    std::cout << "  --live-stats-interval-ms=N  live-stats publish period (default 250)\n";
+    std::cout << "  --federation-name=NAME      name advertised to federation peers (default host:pid)\n";
+    std::cout << "  --federation-listen=PORT    accept forwarded tasks from peers on PORT\n";
+    std::cout << "  --federation-peer=HOST:PORT forward tasks to this peer when it has the overlay or a shorter queue (repeatable)\n";
+    std::cout << "  --federation-serve          run without --app-lib, serving peers until SIGINT/SIGTERM\n";
+    std::cout << "  --host-mem-budget=SIZE      cap host memory held by dispatched tasks (bytes, K/M/G suffix)\n";
+    std::cout << "  --device-mem-budget=SIZE    cap udmabuf/DMA staging held by tasks on FPGA overlays\n";
+    std::cout << "  --hedge=APPS                duplicate slow tasks of these apps (comma-separated) on another accelerator\n";
+    std::cout << "  --hedge-percentile=P        hedge once a task runs past this percentile of recent runtimes (default 95)\n";
+    std::cout << "  --hedge-slack-ms=N          also hedge once a task's deadline is less than N ms away\n";
+    std::cout << "  --inline-max-us=N           run ready CPU tasks estimated at N us or less on the submitting thread\n";
+    std::cout << "  --inline-max-bytes=SIZE     same for DASH tasks whose buffers total SIZE or less (K/M/G suffix)\n";
+    std::cout << "  --fft-batch=N               coalesce up to N concurrent same-size FFT requests into one task\n";
+    std::cout << "  --fft-batch-window-us=N     how long the first request waits for others (default 200)\n";
+    std::cout << "  --fft-wisdom=PATH     load CPU FFT wisdom at startup; newly tuned sizes are saved back\n";
+    std::cout << "  --fft-tune            benchmark FFT decompositions for 512 and 65536 points (both directions, every precision) into the wisdom file, then exit\n";
 }
 
 BackendMode parse_backend(const std::string& value) {
@@ -37,6 +68,30 @@ BackendMode parse_backend(const std::string& value) {
     return BackendMode::AUTO;
 }
 
+volatile std::sig_atomic_t g_serve_stop = 0;
+
+void on_serve_signal(int) { g_serve_stop = 1; }
+
+// Owns a loaded policy plugin. Declared before the Scheduler, so on every
+// exit path the hooks outlive the scheduler and the plugin's shutdown hook
+// runs after it, before the library is unloaded.
+class PolicyPluginGuard {
+public:
+    PolicyPluginGuard() = default;
+    PolicyPluginGuard(const PolicyPluginGuard&) = delete;
+    PolicyPluginGuard& operator=(const PolicyPluginGuard&) = delete;
+    ~PolicyPluginGuard() {
+        if (!handle_) return;
+        if (policy_hooks().shutdown) policy_hooks().shutdown(policy_hooks().user);
+        set_policy_hooks({});
+        dlclose(handle_);
+    }
+    void adopt(void* handle) { handle_ = handle; }
+
+private:
+    void* handle_{nullptr};
+};
+
 unsigned parse_unsigned(const std::string& value, unsigned default_value) {
     unsigned result = 0;
     for (char c : value) {
@@ -46,6 +101,39 @@ unsigned parse_unsigned(const std::string& value, unsigned default_value) {
     return result > 0 ? result : default_value;
 }
 
+// "512M", "64K", "1G" or plain bytes; binary units. Returns false on junk.
+bool parse_size(const std::string& value, uint64_t& out) {
+    if (value.empty()) return false;
+    uint64_t result = 0;
+    size_t i = 0;
+    for (; i < value.size() && value[i] >= '0' && value[i] <= '9'; ++i)
+        result = result * 10 + static_cast<uint64_t>(value[i] - '0');
+    if (i == 0) return false;
+    if (i < value.size()) {
+        if (i + 1 != value.size()) return false;
+        switch (value[i]) {
+        case 'k': case 'K': result <<= 10; break;
+        case 'm': case 'M': result <<= 20; break;
+        case 'g': case 'G': result <<= 30; break;
+        default: return false;
+        }
+    }
+    out = result;
+    return true;
+}
+
+std::vector<std::string> split_list(const std::string& value) {
+    std::vector<std::string> out;
+    size_t start = 0;
+    while (start <= value.size()) {
+        size_t comma = value.find(',', start);
+        if (comma == std::string::npos) comma = value.size();
+        if (comma > start) out.push_back(value.substr(start, comma - start));
+        start = comma + 1;
+    }
+    return out;
+}
+
 } // namespace
 
 struct OverlaySpec {
@@ -67,6 +155,9 @@ int main(int argc, char** argv) {
     unsigned cpu_workers = std::thread::hardware_concurrency();
     if (cpu_workers == 0) cpu_workers = 4;
     unsigned preload_threshold = 3;
+    SchedulerPolicy policy = SchedulerPolicy::Default;
+    std::string policy_lib;
+    std::vector<std::string> policy_args;
     bool csv_report = false;
     std::string bitstream_dir = "bitstreams";
     std::string static_bitstream = "bitstreams/static_wrapper.bit";
@@ -77,6 +168,21 @@ int main(int argc, char** argv) {
     bool fpga_pr_gpio_active_low = false;
     unsigned fpga_pr_gpio_delay_ms = 5;
     bool trace_all = false;
+    std::string fft_wisdom;
+    bool fft_tune = false;
+    bool metrics_summary = false;
+    bool perf_counters = false;
+    bool worker_times = false;
+    std::string live_stats;
+    std::string federation_name;
+    unsigned federation_port = 0;
+    std::vector<std::string> federation_peers;
+    bool federation_serve = false;
+    unsigned live_stats_interval_ms = 250;
+    MemoryBudget mem_budget;
+    HedgePolicy hedge;
+    dash::FftBatchOptions fft_batch;
+    InlinePolicy inline_policy;
     std::vector<OverlaySpec> overlays;
 
     int app_arg_start = argc;
@@ -106,6 +212,23 @@ int main(int argc, char** argv) {
             preload_threshold = parse_unsigned(arg.substr(sizeof("--preload-threshold=") - 1), preload_threshold);
             continue;
         }
+        if (arg.rfind("--policy=", 0) == 0) {
+            auto parsed = parse_scheduler_policy(arg.substr(sizeof("--policy=") - 1));
+            if (!parsed) {
+                std::cerr << "Unknown policy: " << arg.substr(sizeof("--policy=") - 1) << "\n";
+                return 1;
+            }
+            policy = *parsed;
+            continue;
+        }
+        if (arg.rfind("--policy-lib=", 0) == 0) {
+            policy_lib = arg.substr(sizeof("--policy-lib=") - 1);
+            continue;
+        }
+        if (arg.rfind("--policy-args=", 0) == 0) {
+            policy_args = split_list(arg.substr(sizeof("--policy-args=") - 1));
+            continue;
+        }
         if (arg.rfind("--bitstream-dir=", 0) == 0) {
             bitstream_dir = arg.substr(sizeof("--bitstream-dir=") - 1);
             continue;
@@ -147,6 +270,14 @@ int main(int argc, char** argv) {
             fpga_pr_gpio_delay_ms = parse_unsigned(arg.substr(sizeof("--fpga-pr-gpio-delay-ms=") - 1), fpga_pr_gpio_delay_ms);
             continue;
         }
+        if (arg.rfind("--fft-wisdom=", 0) == 0) {
+            fft_wisdom = arg.substr(sizeof("--fft-wisdom=") - 1);
+            continue;
+        }
+        if (arg == "--fft-tune") {
+            fft_tune = true;
+            continue;
+        }
         if (arg.rfind("--overlay=", 0) == 0) {
             std::string spec = arg.substr(sizeof("--overlay=") - 1);
             std::vector<std::string> parts;
@@ -166,6 +297,102 @@ int main(int argc, char** argv) {
             }
             continue;
         }
+        if (arg == "--metrics-summary") {
+            metrics_summary = true;
+            continue;
+        }
+        if (arg == "--perf-counters") {
+            perf_counters = true;
+            metrics_summary = true;
+            continue;
+        }
+        if (arg == "--worker-times") {
+            worker_times = true;
+            continue;
+        }
+        if (arg.rfind("--federation-name=", 0) == 0) {
+            federation_name = arg.substr(sizeof("--federation-name=") - 1);
+            continue;
+        }
+        if (arg.rfind("--federation-listen=", 0) == 0) {
+            federation_port = parse_unsigned(arg.substr(sizeof("--federation-listen=") - 1), 0);
+            continue;
+        }
+        if (arg.rfind("--federation-peer=", 0) == 0) {
+            federation_peers.push_back(arg.substr(sizeof("--federation-peer=") - 1));
+            continue;
+        }
+        if (arg == "--federation-serve") {
+            federation_serve = true;
+            continue;
+        }
+        if (arg == "--live-stats") {
+            live_stats = "schedrt";
+            continue;
+        }
+        if (arg.rfind("--live-stats=", 0) == 0) {
+            live_stats = arg.substr(sizeof("--live-stats=") - 1);
+            continue;
+        }
+        if (arg.rfind("--live-stats-interval-ms=", 0) == 0) {
+            live_stats_interval_ms = parse_unsigned(arg.substr(sizeof("--live-stats-interval-ms=") - 1), live_stats_interval_ms);
+            continue;
+        }
+        if (arg.rfind("--host-mem-budget=", 0) == 0) {
+            if (!parse_size(arg.substr(sizeof("--host-mem-budget=") - 1), mem_budget.host_bytes)) {
+                std::cerr << "Invalid --host-mem-budget value\n";
+                return 1;
+            }
+            continue;
+        }
+        if (arg.rfind("--device-mem-budget=", 0) == 0) {
+            if (!parse_size(arg.substr(sizeof("--device-mem-budget=") - 1), mem_budget.device_bytes)) {
+                std::cerr << "Invalid --device-mem-budget value\n";
+                return 1;
+            }
+            continue;
+        }
+        if (arg.rfind("--hedge=", 0) == 0) {
+            hedge.apps = split_list(arg.substr(sizeof("--hedge=") - 1));
+            hedge.enabled = !hedge.apps.empty();
+            continue;
+        }
+        if (arg.rfind("--hedge-percentile=", 0) == 0) {
+            auto value = arg.substr(sizeof("--hedge-percentile=") - 1);
+            char* end = nullptr;
+            double pct = std::strtod(value.c_str(), &end);
+            if (value.empty() || *end != '\0' || pct <= 0.0 || pct > 100.0) {
+                std::cerr << "Invalid --hedge-percentile value\n";
+                return 1;
+            }
+            hedge.percentile = pct / 100.0;
+            continue;
+        }
+        if (arg.rfind("--hedge-slack-ms=", 0) == 0) {
+            hedge.min_slack = std::chrono::milliseconds(parse_unsigned(arg.substr(sizeof("--hedge-slack-ms=") - 1), 0));
+            continue;
+        }
+        if (arg.rfind("--inline-max-us=", 0) == 0) {
+            inline_policy.max_runtime = std::chrono::microseconds(
+                parse_unsigned(arg.substr(sizeof("--inline-max-us=") - 1), 0));
+            continue;
+        }
+        if (arg.rfind("--inline-max-bytes=", 0) == 0) {
+            if (!parse_size(arg.substr(sizeof("--inline-max-bytes=") - 1), inline_policy.max_bytes)) {
+                std::cerr << "Invalid --inline-max-bytes value\n";
+                return 1;
+            }
+            continue;
+        }
+        if (arg.rfind("--fft-batch=", 0) == 0) {
+            fft_batch.max_batch = parse_unsigned(arg.substr(sizeof("--fft-batch=") - 1), 1);
+            continue;
+        }
+        if (arg.rfind("--fft-batch-window-us=", 0) == 0) {
+            fft_batch.window = std::chrono::microseconds(
+                parse_unsigned(arg.substr(sizeof("--fft-batch-window-us=") - 1), 200));
+            continue;
+        }
         if (arg == "--csv-report") {
             csv_report = true;
             continue;
@@ -182,7 +409,38 @@ int main(int argc, char** argv) {
         std::cout << "[sched_runner] trace-all enabled (fpga + DMA verbose logging)\n";
     }
 
-    if (app_lib.empty()) {
+    if (fft_tune) {
+        if (fft_wisdom.empty()) fft_wisdom = "fft_wisdom.txt";
+        dash::fft_wisdom_load(fft_wisdom);
+        for (int n : {512, 65536}) {
+            for (bool inverse : {false, true}) {
+                // Wisdom is keyed by precision too; tune each one so none is left to first use.
+                for (size_t p = 0; p < dash::kFftPrecisionCount; ++p) {
+                    dash::fft_autotune({n, inverse, static_cast<dash::FftPrecision>(p)}, &std::cout);
+                }
+            }
+        }
+        if (!dash::fft_wisdom_save(fft_wisdom)) {
+            std::cerr << "failed to write FFT wisdom to " << fft_wisdom << "\n";
+            return 1;
+        }
+        std::cout << "[sched_runner] FFT wisdom written to " << fft_wisdom << "\n";
+        return 0;
+    }
+
+    if (!fft_wisdom.empty()) {
+        if (!dash::fft_wisdom_load(fft_wisdom)) {
+            std::cout << "[sched_runner] no FFT wisdom at " << fft_wisdom << "; tuning sizes on first use\n";
+        }
+        dash::fft_wisdom_set_path(fft_wisdom);
+        dash::fft_wisdom_set_autotune(true);
+    }
+
+    if (federation_serve && federation_port == 0) {
+        std::cerr << "--federation-serve requires --federation-listen=PORT\n";
+        return 1;
+    }
+    if (app_lib.empty() && !federation_serve) {
         std::cerr << "Missing --app-lib=PATH\n";
         print_usage(argv[0]);
         return 1;
@@ -217,8 +475,42 @@ int main(int argc, char** argv) {
         reg.register_app(desc);
         registered.push_back({desc, overlay.count});
     }
+    // Tasks carrying a dash::VecContext have no overlay and always run on the CPU workers.
+    if (!reg.lookup("vec")) reg.register_app({"vec", "", "vec_kernel", ResourceKind::CPU});
 
-    Scheduler sched(reg, backend, cpu_workers, preload_threshold);
+    // Loaded before the scheduler so its core is built around the hooks.
+    PolicyPluginGuard policy_plugin;
+    if (!policy_lib.empty()) {
+        void* policy_handle = dlopen(policy_lib.c_str(), RTLD_NOW);
+        if (!policy_handle) {
+            std::cerr << "dlopen failed: " << dlerror() << "\n";
+            return 1;
+        }
+        using policy_init_fn = bool (*)(int, char**, PolicyHooks&);
+        auto policy_init = reinterpret_cast<policy_init_fn>(dlsym(policy_handle, "policy_initialize"));
+        if (!policy_init) {
+            std::cerr << "failed to resolve policy_initialize\n";
+            dlclose(policy_handle);
+            return 1;
+        }
+        std::vector<char*> policy_argv;
+        for (auto& a : policy_args) policy_argv.push_back(a.data());
+        policy_argv.push_back(nullptr);
+        PolicyHooks hooks;
+        if (!policy_init(static_cast<int>(policy_args.size()), policy_argv.data(), hooks)) {
+            std::cerr << "policy plugin " << policy_lib << " failed to initialize (ABI " << kPolicyAbiVersion
+                      << ")\n";
+            dlclose(policy_handle);
+            return 1;
+        }
+        set_policy_hooks(hooks);
+        policy_plugin.adopt(policy_handle);
+        policy = SchedulerPolicy::Plugin;
+        std::cout << "[sched_runner] policy plugin " << (hooks.name ? hooks.name : "plugin") << " from "
+                  << policy_lib << "\n";
+    }
+
+    Scheduler sched(reg, backend, policy, cpu_workers, preload_threshold);
     dash::set_scheduler(&sched);
 
     unsigned next_slot_id = 0;
@@ -253,7 +545,67 @@ int main(int argc, char** argv) {
     }
 
     sched.add_accelerator(make_cpu_mock(0));
+    sched.set_memory_budget(mem_budget);
+    sched.set_hedging(hedge);
+    sched.set_inline_policy(inline_policy);
+    sched.set_worker_accounting(worker_times);
+    dash::fft_set_batching(fft_batch);
+    bool mem_limited = mem_budget.host_bytes || mem_budget.device_bytes;
     schedrt::reporting::set_csv(csv_report);
+    schedrt::perf::set_enabled(perf_counters);
+    if (!live_stats.empty() &&
+        !sched.enable_live_stats(live_stats, std::chrono::milliseconds(live_stats_interval_ms))) {
+        std::cerr << "[sched_runner] live stats disabled\n";
+    }
+
+    // Declared after the scheduler so it is torn down first; peers' tasks
+    // reference the scheduler until then.
+    std::unique_ptr<federation::Node> fed;
+    if (federation_port || !federation_peers.empty()) {
+        if (federation_name.empty()) {
+            char host[64] = {};
+            gethostname(host, sizeof(host) - 1);
+            federation_name = std::string(host) + ":" + std::to_string(getpid());
+        }
+        fed = std::make_unique<federation::Node>(sched, federation_name);
+        if (federation_port && !fed->listen(static_cast<uint16_t>(federation_port))) return 1;
+        for (const auto& peer : federation_peers) {
+            auto colon = peer.rfind(':');
+            unsigned port = colon == std::string::npos ? 0 : parse_unsigned(peer.substr(colon + 1), 0);
+            if (port == 0 || port > 65535) {
+                std::cerr << "Invalid --federation-peer " << peer << " (expected HOST:PORT)\n";
+                return 1;
+            }
+            sched.add_accelerator(fed->connect(peer.substr(0, colon), static_cast<uint16_t>(port)));
+        }
+    }
+
+    // Stops the node and scheduler and prints the end-of-run summaries; both
+    // the serving and the app path finish through it.
+    auto finish = [&] {
+        if (fed) fed->stop();
+        sched.stop();
+        if (metrics_summary) schedrt::reporting::write_app_metrics(std::cout, sched.app_metrics());
+        if (mem_limited) schedrt::reporting::write_memory_stats(std::cout, sched.memory_stats());
+        if (hedge.enabled) schedrt::reporting::write_hedge_stats(std::cout, sched.hedge_stats());
+        if (worker_times) schedrt::reporting::write_worker_times(std::cout, sched.worker_times());
+        if (fft_batch.max_batch > 1) {
+            auto fb = dash::fft_batch_stats();
+            std::cout << "[FFT-BATCH] requests=" << fb.requests << " batches=" << fb.batches
+                      << " largest=" << fb.largest << "\n";
+        }
+        if (schedrt::kLockProfiling) schedrt::write_lock_profile(std::cout);
+    };
+
+    if (federation_serve) {
+        std::signal(SIGINT, on_serve_signal);
+        std::signal(SIGTERM, on_serve_signal);
+        sched.start();
+        std::cout << "[sched_runner] serving federation peers; Ctrl-C to stop\n";
+        while (!g_serve_stop) std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        finish();
+        return 0;
+    }
 
     void* handle = dlopen(app_lib.c_str(), RTLD_NOW);
     if (!handle) {
@@ -275,8 +627,7 @@ int main(int argc, char** argv) {
     init(app_argc, app_argv, reg, sched);
     sched.start();
     int app_ret = run(app_argc, app_argv, sched);
-    sched.stop();
-
+    finish();
     dlclose(handle);
     return app_ret;
 }
@@ -0,0 +1,189 @@
+#include "schedrt/live_stats.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <csignal>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <thread>
+
+using namespace schedrt;
+
+namespace {
+
+volatile std::sig_atomic_t g_stop = 0;
+
+void on_signal(int) { g_stop = 1; }
+
+void print_usage(const char* prog) {
+    std::cout << "Usage: " << prog << " [--name=NAME] [--interval-ms=N] [--once]\n";
+    std::cout << "  --name=NAME        shared-memory segment passed to sched_runner --live-stats (default schedrt)\n";
+    std::cout << "  --interval-ms=N    refresh period (default 500)\n";
+    std::cout << "  --once             print a single snapshot without clearing the screen and exit\n";
+}
+
+std::optional<unsigned> parse_unsigned(const std::string& text) {
+    if (text.empty()) return std::nullopt;
+    unsigned value = 0;
+    for (char c : text) {
+        if (c < '0' || c > '9') return std::nullopt;
+        value = value * 10 + static_cast<unsigned>(c - '0');
+    }
+    return value;
+}
+
+std::string fmt_ns(uint64_t ns) {
+    std::ostringstream oss;
+    oss << std::fixed << std::setprecision(1);
+    if (ns >= 1000000000ull) oss << static_cast<double>(ns) / 1e9 << "s";
+    else if (ns >= 1000000ull) oss << static_cast<double>(ns) / 1e6 << "ms";
+    else if (ns >= 1000ull) oss << static_cast<double>(ns) / 1e3 << "us";
+    else oss << ns << "ns";
+    return oss.str();
+}
+
+double busy_pct(uint64_t busy_ns, uint64_t uptime_ns) {
+    return uptime_ns ? 100.0 * static_cast<double>(busy_ns) / static_cast<double>(uptime_ns) : 0.0;
+}
+
+const char* state_name(live::WorkerState s) {
+    switch (s) {
+    case live::WorkerState::Idle: return "idle";
+    case live::WorkerState::Running: return "run";
+    case live::WorkerState::Stopped: return "stopped";
+    }
+    return "?";
+}
+
+// Where each worker's wall time went, when the run has worker accounting on.
+void render_phases(const live::Snapshot& s) {
+    static const char* const kHeaders[kWorkerPhases] = {"IDLE%", "SELECT%", "EXEC%", "LOCK%", "REPORT%", "OTHER%"};
+    uint32_t n = std::min(s.num_workers, live::kMaxWorkers);
+    bool any = false;
+    for (uint32_t i = 0; i < n && !any; ++i)
+        for (auto v : s.workers[i].phase_ns) any = any || v != 0;
+    if (!any) return;
+
+    std::cout << std::left << std::setw(8) << "WORKER" << std::right;
+    for (auto* h : kHeaders) std::cout << std::setw(9) << h;
+    std::cout << "\n";
+    for (uint32_t i = 0; i < n; ++i) {
+        const auto& w = s.workers[i];
+        uint64_t total = 0;
+        for (auto v : w.phase_ns) total += v;
+        std::cout << std::left << std::setw(8) << i << std::right << std::fixed << std::setprecision(1);
+        for (auto v : w.phase_ns) std::cout << std::setw(9) << busy_pct(v, total);
+        std::cout << std::defaultfloat << "\n";
+    }
+    std::cout << "\n";
+}
+
+void render(const live::Snapshot& s, const std::string& name) {
+    std::cout << "sched_top  segment=" << name << "  pid=" << s.pid
+              << "  uptime=" << fmt_ns(s.uptime_ns) << "\n";
+    std::cout << "queue: ready=" << s.ready_depth << " waiting=" << s.waiting_depth
+              << "   tasks: submitted=" << s.submitted << " completed=" << s.completed
+              << " failed=" << s.failed
+              << "   throughput=" << std::fixed << std::setprecision(1) << s.throughput << "/s\n"
+              << std::defaultfloat;
+    std::cout << "latency (release->done): p50<=" << fmt_ns(s.latency_p50_ns)
+              << " p90<=" << fmt_ns(s.latency_p90_ns) << " p99<=" << fmt_ns(s.latency_p99_ns)
+              << " max=" << fmt_ns(s.latency_max_ns) << "\n\n";
+
+    std::cout << std::left << std::setw(8) << "WORKER" << std::setw(9) << "STATE" << std::setw(10) << "TASK"
+              << std::setw(20) << "APP" << std::right << std::setw(10) << "DONE" << std::setw(12) << "BUSY"
+              << std::setw(8) << "BUSY%" << "\n";
+    for (uint32_t i = 0; i < s.num_workers && i < live::kMaxWorkers; ++i) {
+        const auto& w = s.workers[i];
+        bool running = w.state == live::WorkerState::Running;
+        std::cout << std::left << std::setw(8) << i << std::setw(9) << state_name(w.state)
+                  << std::setw(10) << (running ? std::to_string(w.task_id) : "-")
+                  << std::setw(20) << (running ? std::string(w.app) : "-") << std::right
+                  << std::setw(10) << w.tasks << std::setw(12) << fmt_ns(w.busy_ns)
+                  << std::setw(8) << std::fixed << std::setprecision(1) << busy_pct(w.busy_ns, s.uptime_ns)
+                  << std::defaultfloat << "\n";
+    }
+    std::cout << "\n";
+    render_phases(s);
+
+    std::cout << std::left << std::setw(16) << "ACCELERATOR" << std::setw(16) << "OVERLAY" << std::setw(7) << "AVAIL"
+              << std::right << std::setw(10) << "RUNS" << std::setw(12) << "BUSY" << std::setw(8) << "BUSY%" << "\n";
+    for (uint32_t i = 0; i < s.num_slots && i < live::kMaxSlots; ++i) {
+        const auto& a = s.slots[i];
+        std::string overlay = a.reconfigurable ? (a.overlay[0] ? std::string(a.overlay) : "(none)") : "-";
+        std::cout << std::left << std::setw(16) << std::string(a.name) << std::setw(16) << overlay
+                  << std::setw(7) << (a.available ? "yes" : "no") << std::right
+                  << std::setw(10) << a.runs << std::setw(12) << fmt_ns(a.busy_ns)
+                  << std::setw(8) << std::fixed << std::setprecision(1) << busy_pct(a.busy_ns, s.uptime_ns)
+                  << std::defaultfloat << "\n";
+    }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::string name = "schedrt";
+    unsigned interval_ms = 500;
+    bool once = false;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--help" || arg == "-h") {
+            print_usage(argv[0]);
+            return 0;
+        }
+        if (arg.rfind("--name=", 0) == 0) {
+            name = arg.substr(sizeof("--name=") - 1);
+            continue;
+        }
+        if (arg.rfind("--interval-ms=", 0) == 0) {
+            auto val = parse_unsigned(arg.substr(sizeof("--interval-ms=") - 1));
+            if (!val || *val == 0) {
+                std::cerr << "Invalid --interval-ms value\n";
+                return 1;
+            }
+            interval_ms = *val;
+            continue;
+        }
+        if (arg == "--once") {
+            once = true;
+            continue;
+        }
+        std::cerr << "Unknown option: " << arg << "\n";
+        print_usage(argv[0]);
+        return 1;
+    }
+
+    std::signal(SIGINT, on_signal);
+    std::signal(SIGTERM, on_signal);
+    std::string seg_name = live::normalize_name(name);
+
+    std::unique_ptr<live::Reader> reader;
+    bool announced = false;
+    while (!g_stop) {
+        if (!reader) reader = live::Reader::open(seg_name);
+        if (!reader) {
+            if (once) {
+                std::cerr << "No live-stats segment " << seg_name << " (is sched_runner running with --live-stats?)\n";
+                return 1;
+            }
+            if (!announced) {
+                std::cout << "Waiting for live-stats segment " << seg_name << "...\n";
+                announced = true;
+            }
+        } else {
+            live::Snapshot snap;
+            if (reader->read(snap)) {
+                if (!once) std::cout << "\033[H\033[2J";
+                render(snap, seg_name);
+                std::cout.flush();
+                if (once) return 0;
+            }
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(interval_ms));
+    }
+    return 0;
+}
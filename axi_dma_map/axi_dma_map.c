@@ -5,6 +5,13 @@
 #include <linux/fs.h>
 #include <linux/io.h>
 #include <linux/uaccess.h>
+#include <linux/dma-mapping.h>
+#include <linux/mm.h>
+#include <linux/mutex.h>
+#include <linux/slab.h>
+#include <linux/version.h>
+
+#include "axi_dma_map_ioctl.h"
 
 #define DEFAULT_DMA_REG_BASE 0x40400000      /* AXI DMA register base */
 #define DEFAULT_DMA_REG_SIZE 0x00010000      /* 64 KiB window */
@@ -17,6 +24,14 @@ static unsigned int dma_reg_size = DEFAULT_DMA_REG_SIZE;
 module_param(dma_reg_size, uint, 0444);
 MODULE_PARM_DESC(dma_reg_size, "Register window size in bytes");
 
+static unsigned long max_buf_bytes = 64UL << 20;
+module_param(max_buf_bytes, ulong, 0644);
+MODULE_PARM_DESC(max_buf_bytes, "Largest buffer one /dev/axi_dma_buf open may allocate");
+
+static unsigned int dma_addr_bits = 32;
+module_param(dma_addr_bits, uint, 0444);
+MODULE_PARM_DESC(dma_addr_bits, "Address bits the DMA engine can drive");
+
 static void __iomem *dma_regs;
 
 static ssize_t axi_dma_read(struct file *file, char __user *buf,
@@ -64,8 +79,180 @@ static struct miscdevice axi_dma_misc = {
     .fops  = &axi_dma_fops,
 };
 
+/*
+ * /dev/axi_dma_buf: one DMA buffer per open file, sized by the caller.
+ * Coherent buffers come from dma_alloc_coherent, which draws on CMA for
+ * large sizes when the kernel has a cma= pool. Cached buffers come from
+ * dma_alloc_pages and need AXI_DMA_BUF_IOC_SYNC around each transfer.
+ */
+struct axi_dma_buf {
+    struct mutex lock;
+    size_t size;
+    bool cached;
+    void *cpu;
+    struct page *page;
+    dma_addr_t bus;
+};
+
+static struct miscdevice axi_dma_buf_misc;
+
+static struct device *axi_dma_buf_dev(void)
+{
+    return axi_dma_buf_misc.this_device;
+}
+
+static int axi_dma_buf_open(struct inode *inode, struct file *file)
+{
+    struct axi_dma_buf *buf = kzalloc(sizeof(*buf), GFP_KERNEL);
+
+    if (!buf)
+        return -ENOMEM;
+    mutex_init(&buf->lock);
+    file->private_data = buf;
+    return 0;
+}
+
+static int axi_dma_buf_release(struct inode *inode, struct file *file)
+{
+    struct axi_dma_buf *buf = file->private_data;
+
+    if (buf->cpu && buf->cached) {
+#if LINUX_VERSION_CODE >= KERNEL_VERSION(5, 11, 0)
+        dma_free_pages(axi_dma_buf_dev(), buf->size, buf->page, buf->bus, DMA_BIDIRECTIONAL);
+#endif
+    } else if (buf->cpu) {
+        dma_free_coherent(axi_dma_buf_dev(), buf->size, buf->cpu, buf->bus);
+    }
+    kfree(buf);
+    return 0;
+}
+
+static long axi_dma_buf_alloc(struct axi_dma_buf *buf, void __user *argp)
+{
+    struct axi_dma_buf_alloc req;
+    size_t size;
+
+    if (copy_from_user(&req, argp, sizeof(req)))
+        return -EFAULT;
+    if (req.size == 0 || req.size > max_buf_bytes)
+        return -EINVAL;
+    if (req.flags & ~AXI_DMA_BUF_CACHED)
+        return -EINVAL;
+    if (buf->cpu)
+        return -EBUSY;
+
+    size = PAGE_ALIGN(req.size);
+    if (req.flags & AXI_DMA_BUF_CACHED) {
+#if LINUX_VERSION_CODE >= KERNEL_VERSION(5, 11, 0)
+        buf->page = dma_alloc_pages(axi_dma_buf_dev(), size, &buf->bus, DMA_BIDIRECTIONAL, GFP_KERNEL);
+        buf->cpu = buf->page ? page_address(buf->page) : NULL;
+        buf->cached = true;
+#else
+        return -EOPNOTSUPP;
+#endif
+    } else {
+        buf->cpu = dma_alloc_coherent(axi_dma_buf_dev(), size, &buf->bus, GFP_KERNEL);
+    }
+    if (!buf->cpu) {
+        pr_warn("axi_dma_map: %zu byte %s buffer allocation failed\n", size,
+                buf->cached ? "cached" : "coherent");
+        buf->cached = false;
+        return -ENOMEM;
+    }
+    buf->size = size;
+
+    req.size = size;
+    req.bus_addr = buf->bus;
+    if (copy_to_user(argp, &req, sizeof(req)))
+        return -EFAULT;
+    pr_debug("axi_dma_map: allocated %zu bytes @ bus 0x%llx\n", size, (unsigned long long)buf->bus);
+    return 0;
+}
+
+static long axi_dma_buf_sync(struct axi_dma_buf *buf, void __user *argp)
+{
+    struct axi_dma_buf_sync req;
+
+    if (copy_from_user(&req, argp, sizeof(req)))
+        return -EFAULT;
+    if (!buf->cpu)
+        return -ENOMEM;
+    if (req.offset > buf->size || req.size > buf->size - req.offset)
+        return -EINVAL;
+    if (!buf->cached)
+        return 0;
+
+    if (req.direction == AXI_DMA_BUF_TO_DEVICE)
+        dma_sync_single_for_device(axi_dma_buf_dev(), buf->bus + req.offset, req.size, DMA_TO_DEVICE);
+    else if (req.direction == AXI_DMA_BUF_FROM_DEVICE)
+        dma_sync_single_for_cpu(axi_dma_buf_dev(), buf->bus + req.offset, req.size, DMA_FROM_DEVICE);
+    else
+        return -EINVAL;
+    return 0;
+}
+
+static long axi_dma_buf_ioctl(struct file *file, unsigned int cmd, unsigned long arg)
+{
+    struct axi_dma_buf *buf = file->private_data;
+    long ret;
+
+    mutex_lock(&buf->lock);
+    switch (cmd) {
+    case AXI_DMA_BUF_IOC_ALLOC:
+        ret = axi_dma_buf_alloc(buf, (void __user *)arg);
+        break;
+    case AXI_DMA_BUF_IOC_SYNC:
+        ret = axi_dma_buf_sync(buf, (void __user *)arg);
+        break;
+    default:
+        ret = -ENOTTY;
+        break;
+    }
+    mutex_unlock(&buf->lock);
+    return ret;
+}
+
+static int axi_dma_buf_mmap(struct file *file, struct vm_area_struct *vma)
+{
+    struct axi_dma_buf *buf = file->private_data;
+    size_t len = vma->vm_end - vma->vm_start;
+    int ret;
+
+    mutex_lock(&buf->lock);
+    if (!buf->cpu || vma->vm_pgoff != 0 || len > buf->size) {
+        ret = -EINVAL;
+    } else if (buf->cached) {
+#if LINUX_VERSION_CODE >= KERNEL_VERSION(5, 11, 0)
+        ret = dma_mmap_pages(axi_dma_buf_dev(), vma, len, buf->page);
+#else
+        ret = -EOPNOTSUPP;
+#endif
+    } else {
+        /* Same attributes the kernel mapping has: uncached unless the device is coherent. */
+        ret = dma_mmap_coherent(axi_dma_buf_dev(), vma, buf->cpu, buf->bus, len);
+    }
+    mutex_unlock(&buf->lock);
+    return ret;
+}
+
+static const struct file_operations axi_dma_buf_fops = {
+    .owner          = THIS_MODULE,
+    .open           = axi_dma_buf_open,
+    .release        = axi_dma_buf_release,
+    .unlocked_ioctl = axi_dma_buf_ioctl,
+    .mmap           = axi_dma_buf_mmap,
+};
+
+static struct miscdevice axi_dma_buf_misc = {
+    .minor = MISC_DYNAMIC_MINOR,
+    .name  = "axi_dma_buf",
+    .fops  = &axi_dma_buf_fops,
+};
+
 static int __init axi_dma_map_init(void)
 {
+    int ret;
+
     if (dma_reg_size == 0) {
         pr_err("axi_dma_map: dma_reg_size must be > 0\n");
         return -EINVAL;
@@ -78,11 +265,36 @@ static int __init axi_dma_map_init(void)
     }
     pr_info("axi_dma_map: mapped 0x%08lx–0x%08lx as /dev/axi_dma_regs\n",
             dma_reg_base, dma_reg_base + dma_reg_size - 1);
-    return misc_register(&axi_dma_misc);
+    ret = misc_register(&axi_dma_misc);
+    if (ret)
+        goto err_unmap;
+
+    ret = misc_register(&axi_dma_buf_misc);
+    if (ret)
+        goto err_regs;
+    /* The misc device has no DT node, so it gets the platform's default
+     * (non-coherent) DMA ops; only the addressing limit needs setting. */
+    ret = dma_coerce_mask_and_coherent(axi_dma_buf_dev(), DMA_BIT_MASK(dma_addr_bits));
+    if (ret) {
+        pr_err("axi_dma_map: %u-bit DMA mask rejected\n", dma_addr_bits);
+        goto err_buf;
+    }
+    pr_info("axi_dma_map: /dev/axi_dma_buf ready (max %lu bytes per buffer)\n", max_buf_bytes);
+    return 0;
+
+err_buf:
+    misc_deregister(&axi_dma_buf_misc);
+err_regs:
+    misc_deregister(&axi_dma_misc);
+err_unmap:
+    iounmap(dma_regs);
+    dma_regs = NULL;
+    return ret;
 }
 
 static void __exit axi_dma_map_exit(void)
 {
+    misc_deregister(&axi_dma_buf_misc);
     misc_deregister(&axi_dma_misc);
     if (dma_regs)
         iounmap(dma_regs);
@@ -91,8 +303,8 @@ static void __exit axi_dma_map_exit(void)
 
 MODULE_LICENSE("GPL");
 MODULE_AUTHOR("You");
-MODULE_DESCRIPTION("Expose AXI DMA registers via /dev/axi_dma_regs");
-MODULE_VERSION("1.1");
+MODULE_DESCRIPTION("Expose AXI DMA registers via /dev/axi_dma_regs and DMA buffers via /dev/axi_dma_buf");
+MODULE_VERSION("1.2");
 
 module_init(axi_dma_map_init);
 module_exit(axi_dma_map_exit);
@@ -0,0 +1,40 @@
+/* axi_dma_map_ioctl.h - /dev/axi_dma_buf interface, shared with userspace */
+#ifndef AXI_DMA_MAP_IOCTL_H
+#define AXI_DMA_MAP_IOCTL_H
+
+#include <linux/ioctl.h>
+#include <linux/types.h>
+
+#define AXI_DMA_BUF_DEVICE "/dev/axi_dma_buf"
+
+/*
+ * Each open file owns at most one buffer: ALLOC it, mmap the fd at offset 0,
+ * and close the fd to free it.
+ */
+
+/* Normal cacheable memory; SYNC around every transfer. Default is coherent
+ * (uncached on Zynq), which needs no maintenance. */
+#define AXI_DMA_BUF_CACHED 0x1
+
+struct axi_dma_buf_alloc {
+    __u64 size;     /* in: bytes wanted; out: allocated size (page aligned) */
+    __u32 flags;    /* in: AXI_DMA_BUF_* */
+    __u32 reserved;
+    __u64 bus_addr; /* out: address to program into the DMA engine */
+};
+
+#define AXI_DMA_BUF_TO_DEVICE   1 /* CPU wrote, device reads next */
+#define AXI_DMA_BUF_FROM_DEVICE 2 /* device wrote, CPU reads next */
+
+struct axi_dma_buf_sync {
+    __u64 offset;
+    __u64 size;
+    __u32 direction; /* AXI_DMA_BUF_TO_DEVICE or AXI_DMA_BUF_FROM_DEVICE */
+    __u32 reserved;
+};
+
+#define AXI_DMA_BUF_IOC_MAGIC 'X'
+#define AXI_DMA_BUF_IOC_ALLOC _IOWR(AXI_DMA_BUF_IOC_MAGIC, 1, struct axi_dma_buf_alloc)
+#define AXI_DMA_BUF_IOC_SYNC  _IOW(AXI_DMA_BUF_IOC_MAGIC, 2, struct axi_dma_buf_sync)
+
+#endif /* AXI_DMA_MAP_IOCTL_H */
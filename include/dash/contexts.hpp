@@ -1,7 +1,12 @@
 #pragma once
 #include "dash/types.hpp"
+#include "dash/vec.hpp"
+#include "schedrt/task.hpp"
 #include <cstddef>
+#include <cstdint>
+#include <memory>
 #include <string>
+#include <vector>
 
 namespace dash {
 
@@ -11,7 +16,7 @@ struct ZipContext {
     BufferView out{};
     size_t* out_actual = nullptr;
     bool ok = false;
-    std::string message;
+    schedrt::Status status{};
 };
 
 struct FftContext {
@@ -19,10 +24,61 @@ struct FftContext {
     BufferView in{};
     BufferView out{};
     bool ok = false;
-    std::string message;
+    schedrt::Status status{};
+};
+
+// Same-plan FFTs from independent callers coalesced into one task (see
+// fft_set_batching). Each item keeps its caller's buffers and status.
+struct FftBatchContext {
+    FftPlan plan{};
+    std::vector<FftContext> items;
+    bool ok = false;  // every item succeeded
+    schedrt::Status status{};
+};
+
+// One chunk of a dash::vec job; [begin, end) in complex samples.
+struct VecContext {
+    vec::Job job{};
+    size_t begin = 0;
+    size_t end = 0;
+    vec::ArgMax best{};  // ArgMaxReal partial result
+    bool ok = false;
+    schedrt::Status status{};
 };
 
 inline constexpr const char kZipContextKey[] = "dash.zip_ctx";
 inline constexpr const char kFftContextKey[] = "dash.fft_ctx";
+inline constexpr const char kVecContextKey[] = "dash.vec_ctx";
+inline constexpr const char kFftBatchContextKey[] = "dash.fft_batch_ctx";
+
+// Host and device memory a task holds while it runs, from the BufferView
+// sizes of its FFT, FFT batch or ZIP context. Vec chunks work in the caller's arrays and
+// report nothing, as do tasks without a context.
+schedrt::MemoryFootprint task_footprint(const schedrt::Task& task);
+
+// A task's FFT or ZIP context redirected to an output buffer owned here, so
+// two attempts at the same task (hedged execution) can run at once without
+// writing the caller's buffers. In-place jobs also get a private input.
+// commit() copies the status into the caller's context, and the result
+// only when the attempt succeeded.
+class PrivateOutput {
+public:
+    // Null for contexts that cannot be duplicated (vec chunks, FFT batches). Tasks without
+    // a context get a copy with nothing to bind or commit.
+    static std::unique_ptr<PrivateOutput> create(const schedrt::Task& task);
+
+    // Points attempt's context parameter at the private copy.
+    void bind(schedrt::Task& attempt) const;
+    void commit();
+
+private:
+    FftContext* fft_target_ = nullptr;
+    ZipContext* zip_target_ = nullptr;
+    FftContext fft_{};
+    ZipContext zip_{};
+    size_t zip_actual_ = 0;
+    std::vector<uint8_t> in_;
+    std::vector<uint8_t> out_;
+};
 
 } // namespace dash
@@ -0,0 +1,268 @@
+#pragma once
+// C++20 coroutine front end for the DASH ops. Built only with the
+// schedrt_coro target (SCHEDRT_COROUTINES); the blocking C++17 API in
+// fft.hpp/zip.hpp is unchanged and the library itself stays C++17.
+//
+//   dash::CoTask<bool> pipeline(float* a, float* b, size_t n) {
+//       bool ok = co_await dash::fft({int(n), false}, {a, bytes}, {b, bytes});
+//       if (!ok) co_return false;
+//       ...                                   // runs on a scheduler worker
+//       co_return co_await dash::fft({int(n), true}, {b, bytes}, {a, bytes});
+//   }
+//   dash::spawn(pipeline(...));               // or dash::sync_wait(...)
+//
+// An awaited op is submitted as an ordinary task. Its on_complete posts the
+// coroutine back through Scheduler::post, so it resumes on a worker and no
+// thread blocks while the op runs. Do not call the blocking API from inside
+// a coroutine: it would hold a worker until the op completes.
+//
+// GCC 12 miscompiles a co_await that suspends inside an if/while condition
+// (wrong value or a crash); bind the result to a variable first, as above.
+#if __cplusplus < 202002L
+#error "dash/coro.hpp needs C++20; link the schedrt_coro target"
+#endif
+
+#include "dash/contexts.hpp"
+#include "dash/provider.hpp"
+#include "dash/scheduler_binding.hpp"
+#include "schedrt/scheduler.hpp"
+#include "schedrt/task.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <coroutine>
+#include <cstdint>
+#include <exception>
+#include <future>
+#include <memory>
+#include <optional>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+namespace dash {
+
+template <typename T = void>
+class CoTask;
+
+namespace detail {
+
+struct PromiseBase {
+    std::coroutine_handle<> continuation;
+    std::exception_ptr error;
+
+    // Hands control straight to the awaiting coroutine (symmetric transfer),
+    // so long co_await chains do not grow the stack.
+    struct FinalAwaiter {
+        bool await_ready() noexcept { return false; }
+        template <typename P>
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<P> h) noexcept {
+            auto next = h.promise().continuation;
+            return next ? next : std::noop_coroutine();
+        }
+        void await_resume() noexcept {}
+    };
+
+    std::suspend_always initial_suspend() noexcept { return {}; }
+    FinalAwaiter final_suspend() noexcept { return {}; }
+    void unhandled_exception() noexcept { error = std::current_exception(); }
+};
+
+template <typename T>
+struct Promise : PromiseBase {
+    std::optional<T> value;
+    template <typename U>
+    void return_value(U&& v) { value.emplace(std::forward<U>(v)); }
+    T take() {
+        if (error) std::rethrow_exception(error);
+        return std::move(*value);
+    }
+};
+
+template <>
+struct Promise<void> : PromiseBase {
+    void return_void() noexcept {}
+    void take() {
+        if (error) std::rethrow_exception(error);
+    }
+};
+
+// Fire-and-forget frame that owns a CoTask while it runs.
+struct Detached {
+    struct promise_type {
+        Detached get_return_object() noexcept { return {}; }
+        std::suspend_never initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_void() noexcept {}
+        void unhandled_exception() noexcept { std::terminate(); }
+    };
+};
+
+inline uint64_t next_task_id() {
+    static std::atomic<uint64_t> c{9000};
+    return c.fetch_add(1, std::memory_order_relaxed);
+}
+
+// Submits `op` with its context and arranges for h to resume on a worker
+// once it completes. Returns false, with ok = false, if there is nothing to
+// run it on; the caller then continues without suspending. The awaiter (and
+// ctx, ok) live in the suspended frame, so nothing here touches them after
+// submit(): the coroutine may already be running on another worker.
+inline bool submit_op(std::coroutine_handle<> h, const char* op, const char* key, const void* ctx,
+                      std::chrono::nanoseconds est, bool& ok) {
+    auto provs = providers_for(op);
+    auto* sched = scheduler();
+    if (provs.empty() || !sched) {
+        ok = false;
+        return false;
+    }
+    auto t = std::make_shared<schedrt::Task>();
+    t->id = next_task_id();
+    t->app = op;
+    t->required = provs.front().kind;
+    t->est_runtime_ns = est;
+    t->params.emplace(key, std::to_string(reinterpret_cast<std::uintptr_t>(ctx)));
+    t->on_complete = [h, sched, &ok, priority = t->priority](const schedrt::ExecutionResult& r) {
+        ok = r.ok;
+        sched->post([h] { h.resume(); }, priority);
+    };
+    sched->submit(t);
+    return true;
+}
+
+} // namespace detail
+
+// Lazily started coroutine returning T. Awaiting it starts it and resumes
+// the awaiter when it finishes; exceptions propagate to the awaiter.
+template <typename T>
+class [[nodiscard]] CoTask {
+public:
+    struct promise_type : detail::Promise<T> {
+        CoTask get_return_object() noexcept {
+            return CoTask(std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+    };
+    using Handle = std::coroutine_handle<promise_type>;
+
+    CoTask(CoTask&& other) noexcept : h_(std::exchange(other.h_, {})) {}
+    CoTask& operator=(CoTask&& other) noexcept {
+        if (this != &other) {
+            if (h_) h_.destroy();
+            h_ = std::exchange(other.h_, {});
+        }
+        return *this;
+    }
+    CoTask(const CoTask&) = delete;
+    CoTask& operator=(const CoTask&) = delete;
+    ~CoTask() {
+        if (h_) h_.destroy();
+    }
+
+    auto operator co_await() && noexcept {
+        struct Awaiter {
+            Handle h;
+            bool await_ready() const noexcept { return false; }
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) noexcept {
+                h.promise().continuation = awaiting;
+                return h;
+            }
+            T await_resume() { return h.promise().take(); }
+        };
+        return Awaiter{h_};
+    }
+
+private:
+    explicit CoTask(Handle h) : h_(h) {}
+    Handle h_;
+};
+
+// Runs t to completion without an owner. An exception escaping it terminates.
+inline void spawn(CoTask<void> t) {
+    [](CoTask<void> task) -> detail::Detached { co_await std::move(task); }(std::move(t));
+}
+
+// Runs t and blocks the calling thread (not a worker) until it finishes.
+template <typename T>
+T sync_wait(CoTask<T> t) {
+    auto done = std::make_shared<std::promise<T>>();
+    auto result = done->get_future();
+    [](CoTask<T> task, std::shared_ptr<std::promise<T>> p) -> detail::Detached {
+        try {
+            if constexpr (std::is_void_v<T>) {
+                co_await std::move(task);
+                p->set_value();
+            } else {
+                p->set_value(co_await std::move(task));
+            }
+        } catch (...) {
+            p->set_exception(std::current_exception());
+        }
+    }(std::move(t), done);
+    return result.get();
+}
+
+// co_await dash::on_worker(): continue on a scheduler worker, queued at
+// `priority`. Without a bound scheduler it continues in place.
+class WorkerHop {
+public:
+    explicit WorkerHop(int priority) : priority_(priority) {}
+    bool await_ready() const noexcept { return scheduler() == nullptr; }
+    void await_suspend(std::coroutine_handle<> h) const {
+        scheduler()->post([h] { h.resume(); }, priority_);
+    }
+    void await_resume() const noexcept {}
+
+private:
+    int priority_;
+};
+
+inline WorkerHop on_worker(int priority = 0) { return WorkerHop(priority); }
+
+// co_await dash::fft(...) -> bool, the result fft_execute would return.
+// Requests are not coalesced (fft_set_batching applies to fft_execute only).
+class FftAwaiter {
+public:
+    FftAwaiter(const FftPlan& plan, BufferView in, BufferView out) {
+        ctx_.plan = plan;
+        ctx_.in = in;
+        ctx_.out = out;
+    }
+    bool await_ready() const noexcept { return false; }
+    bool await_suspend(std::coroutine_handle<> h) {
+        return detail::submit_op(h, "fft", kFftContextKey, &ctx_, std::chrono::milliseconds(15), ok_);
+    }
+    bool await_resume() const noexcept { return ok_; }
+    const schedrt::Status& status() const { return ctx_.status; }
+
+private:
+    FftContext ctx_{};
+    bool ok_ = false;
+};
+
+inline FftAwaiter fft(const FftPlan& plan, BufferView in, BufferView out) { return FftAwaiter(plan, in, out); }
+
+// co_await dash::zip(...) -> bool, as zip_execute; out_actual is set on success.
+class ZipAwaiter {
+public:
+    ZipAwaiter(const ZipParams& params, BufferView in, BufferView out, size_t& out_actual) {
+        ctx_.params = params;
+        ctx_.in = in;
+        ctx_.out = out;
+        ctx_.out_actual = &out_actual;
+    }
+    bool await_ready() const noexcept { return false; }
+    bool await_suspend(std::coroutine_handle<> h) {
+        return detail::submit_op(h, "zip", kZipContextKey, &ctx_, std::chrono::milliseconds(12), ok_);
+    }
+    bool await_resume() const noexcept { return ok_; }
+
+private:
+    ZipContext ctx_{};
+    bool ok_ = false;
+};
+
+inline ZipAwaiter zip(const ZipParams& params, BufferView in, BufferView out, size_t& out_actual) {
+    return ZipAwaiter(params, in, out, out_actual);
+}
+
+} // namespace dash
@@ -1,7 +1,28 @@
 #pragma once
 #include "dash/types.hpp"
+#include <chrono>
+#include <cstdint>
 
 namespace dash {
 bool fft_execute(const FftPlan& plan, BufferView in, BufferView out);
-} // namespace dash
 
+// Request coalescing for fft_execute. With max_batch > 1, concurrent calls
+// with the same plan are held for up to `window`, or until max_batch of them
+// are waiting, and then run as one task: one hardware session on the FFT
+// overlay or one batched CPU call. Each call still returns its own status.
+// Off (max_batch = 1) by default; a longer window trades latency for larger
+// batches.
+struct FftBatchOptions {
+    unsigned max_batch = 1;
+    std::chrono::microseconds window{200};
+};
+
+struct FftBatchStats {
+    uint64_t requests = 0;  // calls that went through the coalescer
+    uint64_t batches = 0;   // tasks submitted for them
+    uint64_t largest = 0;   // most requests in one batch
+};
+
+void fft_set_batching(const FftBatchOptions& opts);
+FftBatchStats fft_batch_stats();
+} // namespace dash
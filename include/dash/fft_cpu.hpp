@@ -0,0 +1,46 @@
+#pragma once
+#include "dash/types.hpp"
+#include <string>
+#include <vector>
+
+namespace dash {
+
+// Decomposition used by the CPU FFT engine. Radices are applied in order and
+// their product must equal the transform length.
+struct FftAlgorithm {
+    std::vector<int> radices;
+    bool in_place = false;  // digit-reversed DIT in one buffer vs Stockham ping-pong
+    bool fixed = false;     // compile-time kernel from fft_fixed.hpp; radices are informational
+    bool bluestein = false; // chirp-z over an m-point Stockham transform; radices factor m >= 2n - 1
+};
+
+// Text form used by the wisdom file, e.g. "stockham:8x8x8", "inplace:4x4x2", "fixed:8x8x8"
+// or "bluestein:4x4x4x4x4".
+std::string to_string(const FftAlgorithm& algo);
+bool parse_fft_algorithm(const std::string& text, FftAlgorithm& out);
+
+// "fp32", "mixed" or "fp64"; also the precision column of the wisdom file.
+const char* to_string(FftPrecision precision);
+bool parse_fft_precision(const std::string& text, FftPrecision& out);
+
+// Decompositions worth benchmarking for an n-point transform (empty if n < 1).
+std::vector<FftAlgorithm> fft_candidate_algorithms(int n);
+// Heuristic choice used when no wisdom exists for n; the fixed kernel when one exists.
+// Any n >= 1 works: mixed radix, or Bluestein when n has a large prime factor.
+FftAlgorithm fft_default_algorithm(int n);
+// Smallest 5-smooth length >= n, i.e. one that runs on radix-2/3/4/5/8 passes
+// only. Zero-padding to it instead of the next power of two loses nothing on
+// the CPU engine.
+int fft_fast_size(int n);
+
+// n-point complex FFT over interleaved re/im floats; in and out may alias.
+// Inverse transforms are scaled by 1/n. Arithmetic follows plan.precision.
+bool fft_cpu_execute(const FftPlan& plan, const FftAlgorithm& algo, const float* in, float* out);
+// Same, using the algorithm selected by the wisdom store (see fft_wisdom.hpp).
+bool fft_cpu_execute(const FftPlan& plan, const float* in, float* out);
+// count same-plan transforms over separate buffers, in[i] -> out[i]. The
+// algorithm and its twiddle/permutation tables are looked up once for the
+// batch instead of once per call.
+bool fft_cpu_execute_batch(const FftPlan& plan, size_t count, const float* const* in, float* const* out);
+
+} // namespace dash
@@ -0,0 +1,30 @@
+#pragma once
+#include "dash/types.hpp"
+#include <array>
+#include <vector>
+
+namespace dash {
+
+// Compile-time specialised FFT kernels for the production hot sizes (512-point
+// SAR rows, 65536-point radar correlation). Each size is a template
+// instantiation with constexpr twiddle tables and fully unrolled radix-4/8
+// butterflies, built once per FftPrecision; the generic engine in
+// fft_cpu.cpp picks them up as the "fixed:" algorithm.
+using FixedFftKernel = void (*)(const float* in, float* out);  // interleaved re/im, may alias
+
+struct FixedFftEntry {
+    int n;
+    std::vector<int> radices;  // pass order, for reporting
+    // [precision][inverse]; inverse kernels are scaled by 1/n like the generic path.
+    std::array<std::array<FixedFftKernel, 2>, kFftPrecisionCount> kernels;
+
+    FixedFftKernel kernel(FftPrecision precision, bool inverse) const {
+        return kernels[static_cast<size_t>(precision)][inverse ? 1 : 0];
+    }
+};
+
+// nullptr when n has no specialised kernel.
+const FixedFftEntry* fft_fixed_kernel(int n);
+std::vector<int> fft_fixed_sizes();
+
+} // namespace dash
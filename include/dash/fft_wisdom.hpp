@@ -0,0 +1,34 @@
+#pragma once
+#include "dash/fft_cpu.hpp"
+#include "dash/types.hpp"
+#include <optional>
+#include <ostream>
+#include <string>
+
+namespace dash {
+
+// Persisted FFT autotuning results keyed by (n, direction, precision).
+// File format: one "<n> <forward|inverse> <precision> <algorithm>" per line,
+// '#' starts a comment.
+bool fft_wisdom_load(const std::string& path);
+bool fft_wisdom_save(const std::string& path);
+
+// When a path is set, newly tuned entries are written back to it.
+void fft_wisdom_set_path(const std::string& path);
+std::string fft_wisdom_path();
+
+// Benchmark unseen plans on first use instead of using the heuristic default.
+void fft_wisdom_set_autotune(bool enabled);
+bool fft_wisdom_autotune_enabled();
+
+std::optional<FftAlgorithm> fft_wisdom_lookup(const FftPlan& plan);
+void fft_wisdom_record(const FftPlan& plan, const FftAlgorithm& algo);
+
+// Benchmarks every candidate for plan, records and returns the winner.
+// Per-candidate timings are written to log when provided.
+FftAlgorithm fft_autotune(const FftPlan& plan, std::ostream* log = nullptr);
+
+// Wisdom entry if present, otherwise tune (when enabled) or fall back to the default.
+FftAlgorithm fft_select_algorithm(const FftPlan& plan);
+
+} // namespace dash
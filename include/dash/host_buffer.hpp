@@ -0,0 +1,55 @@
+#pragma once
+#include "dash/types.hpp"
+#include <cstddef>
+#include <new>
+#include <vector>
+
+namespace dash {
+
+// Large host buffers for application data and DASH staging.
+//
+// Requests of 64 KiB and up are served from huge pages (explicit hugetlb pages
+// when reserved, otherwise 2 MiB-aligned anonymous memory advised for THP) and
+// are pooled on release, so repeated FFT/zip jobs reuse already-faulted pages.
+// Smaller requests fall back to the regular heap. SCHEDRT_HUGEPAGES=off|thp|explicit
+// restricts the backing (default: try explicit, then THP).
+BufferView alloc_host_buffer(size_t bytes);
+// bytes must match the size passed to alloc_host_buffer.
+void free_host_buffer(BufferView buf);
+// Return pooled large mappings to the OS.
+void host_buffer_trim();
+
+struct HostBufferStats {
+    size_t explicit_bytes = 0;  // mapped with MAP_HUGETLB
+    size_t thp_bytes = 0;       // mapped aligned + MADV_HUGEPAGE
+    size_t heap_bytes = 0;      // live small/fallback allocations
+    size_t pool_hits = 0;
+    size_t pool_misses = 0;
+};
+HostBufferStats host_buffer_stats();
+
+template <typename T>
+struct HostAllocator {
+    using value_type = T;
+
+    HostAllocator() noexcept = default;
+    template <typename U>
+    HostAllocator(const HostAllocator<U>&) noexcept {}
+
+    T* allocate(size_t n) {
+        auto buf = alloc_host_buffer(n * sizeof(T));
+        if (!buf.data) throw std::bad_alloc();
+        return static_cast<T*>(buf.data);
+    }
+    void deallocate(T* p, size_t n) noexcept { free_host_buffer({p, n * sizeof(T)}); }
+
+    template <typename U>
+    bool operator==(const HostAllocator<U>&) const noexcept { return true; }
+    template <typename U>
+    bool operator!=(const HostAllocator<U>&) const noexcept { return false; }
+};
+
+template <typename T>
+using host_vector = std::vector<T, HostAllocator<T>>;
+
+} // namespace dash
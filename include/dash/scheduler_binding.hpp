@@ -1,9 +1,16 @@
 #pragma once
 #include "schedrt/scheduler.hpp"
 
+#include <cstddef>
+#include <functional>
+
 namespace dash {
 
 schedrt::Scheduler* scheduler();
 void set_scheduler(schedrt::Scheduler* sched);
 
+// Scheduler::parallel_for on the bound scheduler, for CPU kernels that split
+// their own loops; without one, fn(begin, end) runs on the caller.
+void parallel_for(size_t begin, size_t end, size_t grain, const std::function<void(size_t, size_t)>& fn);
+
 } // namespace dash
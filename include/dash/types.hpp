@@ -17,9 +17,17 @@ struct ZipParams {
 };
 
 // FFT types
+
+// CPU FFT arithmetic. Fp32 keeps data and twiddles in float (twice the SIMD
+// width of Fp64); Mixed keeps float data but applies twiddles in double.
+// The hardware overlay is Q15 whatever the plan asks for.
+enum class FftPrecision : uint8_t { Fp32, Mixed, Fp64 };
+constexpr size_t kFftPrecisionCount = 3;
+
 struct FftPlan {
     int  n = 0;
     bool inverse = false;
+    FftPrecision precision = FftPrecision::Fp32;
 };
 
 } // namespace dash
@@ -0,0 +1,59 @@
+#pragma once
+#include <cstddef>
+#include <limits>
+
+namespace dash {
+namespace vec {
+
+// Elementwise kernels for the math between FFT stages. Buffers hold
+// interleaved re/im floats like the FFT path; lengths count complex samples.
+// The kernels use NEON on aarch64 and SSE2 on x86-64, with a scalar tail.
+
+enum class Op {
+    Mul,         // out = a * b
+    MulConj,     // out = a * conj(b)
+    Magnitude,   // out[i] = |a[i]| (real output, n floats)
+    ArgMaxReal,  // index/value of the largest real part of a; no output buffer
+    FftShift,    // out = a with the halves swapped (out-of-place)
+};
+
+// One job over n samples. With row > 0, a is n / row rows of row samples:
+// b is a single row applied to every row of a, and FftShift shifts each row
+// on its own. With row == 0 the whole array is one row.
+struct Job {
+    Op op = Op::Mul;
+    const float* a = nullptr;
+    const float* b = nullptr;  // Mul/MulConj only
+    float* out = nullptr;      // may alias a except for FftShift
+    size_t n = 0;
+    size_t row = 0;
+};
+
+struct ArgMax {
+    size_t index = 0;
+    float value = -std::numeric_limits<float>::infinity();
+};
+
+void mul(const float* a, const float* b, float* out, size_t n);
+void mul_conj(const float* a, const float* b, float* out, size_t n);
+void magnitude(const float* in, float* out, size_t n);
+// First index on ties, like a scalar `>` scan; NaNs are skipped.
+ArgMax argmax_real(const float* in, size_t n);
+// numpy-style fftshift by index remap: out[i] = in[(i + (n + 1) / 2) % n].
+void fftshift(const float* in, float* out, size_t n);
+
+bool valid(const Job& job);
+
+// Runs samples [begin, end) of job on the calling thread. With row > 0 the
+// bounds must be row-aligned. ArgMaxReal writes the partial result to *best.
+bool run_range(const Job& job, size_t begin, size_t end, ArgMax* best = nullptr);
+
+// Splits job into row-aligned chunks and runs them with parallel_for on the
+// bound scheduler's workers (see scheduler_binding.hpp), the caller
+// included. Safe to call from a task or continuation. Chunks hold at least
+// 16K samples (or one row, if longer), so arrays up to 16K samples run on
+// the caller alone.
+bool execute(const Job& job, ArgMax* best = nullptr);
+
+} // namespace vec
+} // namespace dash
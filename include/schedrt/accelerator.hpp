@@ -1,5 +1,7 @@
 #pragma once
+#include "instrumented_mutex.hpp"
 #include "task.hpp"
+#include <chrono>
 #include <memory>
 #include <mutex>
 #include <string>
@@ -34,6 +36,15 @@ struct FpgaSlotOptions {
     unsigned pr_gpio_delay_ms = 5;
 };
 
+// Phase timings of a slot's most recent bitstream load; zero for phases
+// that did not run (no PR decouple GPIO, or the load failed early).
+struct ReconfigTiming {
+    std::chrono::nanoseconds decouple{0};  // PR decouple asserted, settle delay included
+    std::chrono::nanoseconds program{0};   // FPGA manager firmware write returned
+    std::chrono::nanoseconds release{0};   // decouple released, settle delay included
+    bool ok{false};
+};
+
 class FpgaSlotAccelerator : public Accelerator {
 public:
     explicit FpgaSlotAccelerator(unsigned slot, FpgaSlotOptions opts = {});
@@ -46,6 +57,7 @@ public:
     std::string current_app() const;
     ResourceKind current_kind() const;
     unsigned slot_id() const;
+    ReconfigTiming last_reconfig() const;
 private:
     bool load_bitstream(const std::string& path);
     bool ensure_pr_gpio_ready();
@@ -55,15 +67,17 @@ private:
     void log_debug(const std::string& msg) const;
 
     unsigned slot_;
+    std::string name_;  // results point into it
     FpgaSlotOptions opts_;
-    mutable std::mutex mu_;
-    std::mutex run_mu_;
+    mutable InstrumentedMutex mu_{"FpgaSlotAccelerator::mu_"};
+    InstrumentedMutex run_mu_{"FpgaSlotAccelerator::run_mu_"};
     std::string current_app_;
     ResourceKind current_kind_{ResourceKind::CPU};
     bool configured_{false};
     bool static_loaded_{false};
     bool pr_gpio_ready_{false};
     std::string pr_gpio_value_path_;
+    ReconfigTiming last_reconfig_{};
 };
 
 /// Factory helpers (implemented in accelerators.cpp)
@@ -1,5 +1,6 @@
 #pragma once
 #include "accelerator.hpp"
+#include "instrumented_mutex.hpp"
 #include <mutex>
 #include <optional>
 #include <string>
@@ -10,17 +11,17 @@ namespace schedrt {
 class ApplicationRegistry {
 public:
     void register_app(const AppDescriptor& d) {
-        std::lock_guard<std::mutex> lk(mu_);
+        std::lock_guard<InstrumentedMutex> lk(mu_);
         apps_[d.app] = d;
     }
     std::optional<AppDescriptor> lookup(const std::string& name) const {
-        std::lock_guard<std::mutex> lk(mu_);
+        std::lock_guard<InstrumentedMutex> lk(mu_);
         auto it = apps_.find(name);
         if (it == apps_.end()) return std::nullopt;
         return it->second;
     }
 private:
-    mutable std::mutex mu_;
+    mutable InstrumentedMutex mu_{"ApplicationRegistry::mu_"};
     std::unordered_map<std::string, AppDescriptor> apps_;
 };
 
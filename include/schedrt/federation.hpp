@@ -0,0 +1,107 @@
+#pragma once
+#include "accelerator.hpp"
+#include "instrumented_mutex.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace schedrt {
+
+class Scheduler;
+
+namespace federation {
+
+// Set on tasks that arrived from a peer so they are never forwarded again.
+inline constexpr const char kOriginKey[] = "federation.origin";
+
+// What a node advertises to the peers connected to it.
+struct LoadSummary {
+    uint64_t ready_depth = 0;
+    uint32_t workers = 0;
+    std::vector<std::string> overlays;  // apps resident in this node's FPGA slots
+};
+
+// The forwarding decision only needs a coarse view of the local node.
+struct LocalLoad {
+    uint64_t ready_depth = 0;
+    uint32_t workers = 1;
+    bool overlay_resident = false;  // a local slot already holds task.app
+};
+
+class PeerLink;
+
+// Accelerator that executes tasks on a remote sched_runner by shipping the
+// task and its DASH payload over a PeerLink.
+class RemoteNodeAccelerator : public Accelerator {
+public:
+    explicit RemoteNodeAccelerator(std::shared_ptr<PeerLink> link);
+    ~RemoteNodeAccelerator() override;
+
+    std::string name() const override;
+    bool is_available() override;
+    bool ensure_app_loaded(const AppDescriptor&) override { return true; }
+    ExecutionResult run(const Task& task, const AppDescriptor& app) override;
+
+    // Non-blocking variant used by the scheduler so forwarded tasks don't pin
+    // a local worker for the round trip. `done` runs on the link thread.
+    using Completion = std::function<void(const ExecutionResult&)>;
+    void forward(const Task& task, const AppDescriptor& app, Completion done);
+
+    // True when the peer is a better place for `task` than this node.
+    bool should_forward(const Task& task, const LocalLoad& local) const;
+
+private:
+    std::shared_ptr<PeerLink> link_;
+};
+
+// Serves tasks forwarded by peers to the local scheduler, and creates the
+// outbound links used by RemoteNodeAccelerator.
+//
+// Wire format: every frame is a little-endian u32 length followed by a u8
+// type and the body. Outbound links send HELLO and TASK frames. The serving
+// side answers with RESULT frames and pushes a SUMMARY every summary_period.
+class Node {
+public:
+    Node(Scheduler& sched, std::string name,
+         std::chrono::milliseconds summary_period = std::chrono::milliseconds(100));
+    ~Node();
+    Node(const Node&) = delete;
+    Node& operator=(const Node&) = delete;
+
+    // Accept peers on `port` (0.0.0.0). Returns false if the socket cannot be bound.
+    bool listen(uint16_t port);
+
+    // Outbound link to host:port; reconnects in the background until the node stops.
+    std::unique_ptr<RemoteNodeAccelerator> connect(const std::string& host, uint16_t port);
+
+    void stop();
+    const std::string& name() const { return name_; }
+
+private:
+    struct Inbound;
+
+    void accept_loop();
+    void serve(std::shared_ptr<Inbound> conn);
+    void summary_loop();
+
+    Scheduler& sched_;
+    std::string name_;
+    std::chrono::milliseconds summary_period_;
+    std::atomic<bool> running_{true};
+    int listen_fd_{-1};
+    std::thread accept_thread_;
+    std::thread summary_thread_;
+
+    InstrumentedMutex mu_{"federation::Node::mu_"};
+    std::vector<std::shared_ptr<Inbound>> inbound_;  // each owns its serve() thread
+    std::vector<std::shared_ptr<PeerLink>> links_;
+};
+
+} // namespace federation
+} // namespace schedrt
@@ -0,0 +1,113 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace schedrt {
+
+// Totals for every lock constructed with the same name.
+struct LockStats {
+    std::string name;
+    uint64_t acquisitions = 0;
+    uint64_t contended = 0;        // acquisitions that had to block
+    uint64_t wait_ns = 0;          // time spent blocked in lock()
+    uint64_t max_wait_ns = 0;
+    uint64_t hold_ns = 0;          // time between lock() returning and unlock()
+    uint64_t max_hold_ns = 0;
+};
+
+#if defined(SCHEDRT_LOCK_PROFILING) && SCHEDRT_LOCK_PROFILING
+inline constexpr bool kLockProfiling = true;
+
+namespace detail {
+struct LockCounters {
+    std::atomic<uint64_t> acquisitions{0};
+    std::atomic<uint64_t> contended{0};
+    std::atomic<uint64_t> wait_ns{0};
+    std::atomic<uint64_t> max_wait_ns{0};
+    std::atomic<uint64_t> hold_ns{0};
+    std::atomic<uint64_t> max_hold_ns{0};
+};
+LockCounters* lock_counters_for(const char* name);
+} // namespace detail
+
+// std::mutex with acquisition/contention/wait/hold accounting per name.
+class InstrumentedMutex {
+public:
+    explicit InstrumentedMutex(const char* name) : counters_(detail::lock_counters_for(name)) {}
+    InstrumentedMutex(const InstrumentedMutex&) = delete;
+    InstrumentedMutex& operator=(const InstrumentedMutex&) = delete;
+
+    void lock() {
+        if (mu_.try_lock()) {
+            on_acquired(0);
+            return;
+        }
+        auto t0 = Clock::now();
+        mu_.lock();
+        auto waited = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - t0).count();
+        counters_->contended.fetch_add(1, std::memory_order_relaxed);
+        on_acquired(static_cast<uint64_t>(waited));
+    }
+
+    bool try_lock() {
+        if (!mu_.try_lock()) return false;
+        on_acquired(0);
+        return true;
+    }
+
+    void unlock() {
+        auto held = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - acquired_at_).count();
+        counters_->hold_ns.fetch_add(static_cast<uint64_t>(held), std::memory_order_relaxed);
+        bump_max(counters_->max_hold_ns, static_cast<uint64_t>(held));
+        mu_.unlock();
+    }
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    void on_acquired(uint64_t waited_ns) {
+        acquired_at_ = Clock::now();
+        counters_->acquisitions.fetch_add(1, std::memory_order_relaxed);
+        if (waited_ns) {
+            counters_->wait_ns.fetch_add(waited_ns, std::memory_order_relaxed);
+            bump_max(counters_->max_wait_ns, waited_ns);
+        }
+    }
+
+    static void bump_max(std::atomic<uint64_t>& slot, uint64_t value) {
+        uint64_t cur = slot.load(std::memory_order_relaxed);
+        while (value > cur && !slot.compare_exchange_weak(cur, value, std::memory_order_relaxed)) {}
+    }
+
+    std::mutex mu_;
+    detail::LockCounters* counters_;
+    Clock::time_point acquired_at_{};
+};
+
+using LockCondVar = std::condition_variable_any;
+using UniqueLock = std::unique_lock<InstrumentedMutex>;
+#else
+inline constexpr bool kLockProfiling = false;
+
+// Profiling disabled: a plain std::mutex that accepts (and drops) a name.
+class InstrumentedMutex : public std::mutex {
+public:
+    explicit InstrumentedMutex(const char*) noexcept {}
+};
+
+using LockCondVar = std::condition_variable;
+using UniqueLock = std::unique_lock<std::mutex>;
+#endif
+
+// Snapshot of every named lock, sorted by total wait time (empty when disabled).
+std::vector<LockStats> lock_profile_snapshot();
+// Contention table suitable for printing at shutdown.
+void write_lock_profile(std::ostream& os);
+
+} // namespace schedrt
@@ -0,0 +1,114 @@
+#pragma once
+#include "worker_time.hpp"
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace schedrt {
+namespace live {
+
+// Layout of the POSIX shared-memory segment published by the scheduler.
+// Everything below is trivially copyable so a reader in another process can
+// memcpy it under the seqlock in Segment::seq.
+inline constexpr uint32_t kMagic = 0x53544154;  // "STAT"
+inline constexpr uint32_t kVersion = 2;
+inline constexpr unsigned kMaxWorkers = 64;
+inline constexpr unsigned kMaxSlots = 16;
+inline constexpr unsigned kNameLen = 32;
+inline constexpr unsigned kLatencyBuckets = 48;  // bucket i counts latencies in [2^i, 2^(i+1)) ns
+
+enum class WorkerState : uint32_t { Idle = 0, Running = 1, Stopped = 2 };
+
+struct WorkerStats {
+    WorkerState state;
+    uint32_t reserved;
+    uint64_t task_id;        // task currently running (valid when state == Running)
+    char app[kNameLen];
+    uint64_t tasks;          // tasks finished by this worker
+    uint64_t busy_ns;        // time spent inside Accelerator::run
+    uint64_t phase_ns[kWorkerPhases];  // by WorkerPhase; zero without worker accounting
+};
+
+struct SlotStats {
+    char name[kNameLen];
+    char overlay[kNameLen];  // loaded app, empty for CPU accelerators / unconfigured slots
+    uint32_t reconfigurable;
+    uint32_t available;
+    uint64_t runs;
+    uint64_t busy_ns;
+};
+
+struct Snapshot {
+    uint64_t pid;
+    uint64_t uptime_ns;
+    uint64_t ready_depth;    // tasks in the ready queue
+    uint64_t waiting_depth;  // tasks blocked on dependencies
+    uint64_t submitted;
+    uint64_t completed;
+    uint64_t failed;
+    double throughput;       // completions/s over the last publish interval
+    uint64_t latency_p50_ns; // release -> completion, over the whole run
+    uint64_t latency_p90_ns;
+    uint64_t latency_p99_ns;
+    uint64_t latency_max_ns;
+    uint64_t latency_hist[kLatencyBuckets];
+    uint32_t num_workers;
+    uint32_t num_slots;
+    WorkerStats workers[kMaxWorkers];
+    SlotStats slots[kMaxSlots];
+};
+
+struct Segment {
+    uint32_t magic;
+    uint32_t version;
+    std::atomic<uint64_t> seq;  // odd while the writer is mid-update
+    Snapshot data;
+};
+
+// Upper bound of a latency histogram bucket from the cumulative counts.
+uint64_t latency_percentile(const uint64_t (&hist)[kLatencyBuckets], double fraction);
+
+// Owns a shm_open segment for the lifetime of a run; unlinks it on destruction.
+class Publisher {
+public:
+    // Returns nullptr (with the reason on stderr) if the segment cannot be
+    // created, including when the name already exists.
+    static std::unique_ptr<Publisher> create(const std::string& name);
+    ~Publisher();
+    Publisher(const Publisher&) = delete;
+    Publisher& operator=(const Publisher&) = delete;
+
+    // Single writer; readers retry while an update is in flight.
+    void publish(const Snapshot& snap);
+    const std::string& name() const { return name_; }
+
+private:
+    Publisher(std::string name, Segment* seg) : name_(std::move(name)), seg_(seg) {}
+    std::string name_;
+    Segment* seg_;
+};
+
+// Read-only mapping used by viewers such as sched_top.
+class Reader {
+public:
+    // Null unless the segment is fully sized and initialised at this version.
+    static std::unique_ptr<Reader> open(const std::string& name);
+    ~Reader();
+    Reader(const Reader&) = delete;
+    Reader& operator=(const Reader&) = delete;
+
+    // Consistent copy of the current snapshot; false before the first publish
+    // or if the writer kept it busy.
+    bool read(Snapshot& out) const;
+
+private:
+    explicit Reader(const Segment* seg) : seg_(seg) {}
+    const Segment* seg_;
+};
+
+// shm_open names need a leading '/'; accept "sched" as shorthand for "/sched".
+std::string normalize_name(const std::string& name);
+
+} // namespace live
+} // namespace schedrt
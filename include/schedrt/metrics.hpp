@@ -0,0 +1,40 @@
+#pragma once
+#include "perf_counters.hpp"
+#include "task.hpp"
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+
+namespace schedrt {
+
+// Per-app totals accumulated by the scheduler as tasks complete.
+struct AppMetrics {
+    uint64_t tasks = 0;
+    uint64_t failures = 0;
+    uint64_t inline_tasks = 0;  // run on the submitting thread (InlinePolicy)
+    std::chrono::nanoseconds total_runtime{0};
+    uint64_t perf_tasks = 0;  // tasks that carried a PerfSample
+    PerfSample perf;          // summed over perf_tasks
+};
+
+using AppMetricsMap = std::unordered_map<std::string, AppMetrics>;
+
+// Outstanding task memory as tracked by the scheduler's admission control.
+struct MemoryStats {
+    MemoryFootprint in_use;
+    MemoryFootprint peak;
+    uint64_t deferred_now = 0;    // tasks currently parked waiting for memory
+    uint64_t deferred_total = 0;  // times a task was parked
+};
+
+// Hedged execution counters (Scheduler::set_hedging).
+struct HedgeStats {
+    uint64_t tasks = 0;       // tasks dispatched under the hedging policy
+    uint64_t launched = 0;    // duplicates started
+    uint64_t hedge_wins = 0;  // tasks whose duplicate finished first
+    uint64_t cancelled = 0;   // losing attempts cancelled or discarded
+};
+
+} // namespace schedrt
@@ -0,0 +1,43 @@
+#pragma once
+#include <cstdint>
+
+namespace schedrt {
+
+// Hardware/software counter deltas for one task execution. Counters the
+// platform can't provide (e.g. no PMU inside a VM) stay zero and are left
+// out of `available`.
+struct PerfSample {
+    enum Counter : uint32_t {
+        Cycles = 1u << 0,
+        Instructions = 1u << 1,
+        CacheMisses = 1u << 2,
+        ContextSwitches = 1u << 3,
+        CpuMigrations = 1u << 4,
+    };
+
+    uint64_t cycles = 0;
+    uint64_t instructions = 0;
+    uint64_t cache_misses = 0;
+    uint64_t context_switches = 0;
+    uint64_t cpu_migrations = 0;
+    uint32_t available = 0;  // Counter bits that were collected
+
+    bool valid() const { return available != 0; }
+    bool has(Counter c) const { return (available & c) != 0; }
+    PerfSample& operator+=(const PerfSample& other);
+};
+
+namespace perf {
+
+// Global switch read by the scheduler at start(); off by default.
+void set_enabled(bool value);
+bool enabled();
+
+// Counter group for the calling thread, opened lazily via perf_event_open on
+// first use. Returns a sample with available == 0 if nothing could be opened.
+PerfSample read_thread_counters();
+
+PerfSample delta(const PerfSample& start, const PerfSample& end);
+
+} // namespace perf
+} // namespace schedrt
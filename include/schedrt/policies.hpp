@@ -0,0 +1,166 @@
+#pragma once
+#include "accelerator.hpp"
+#include "task.hpp"
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <vector>
+
+namespace schedrt {
+
+// Policies the scheduler core is compiled against. Each is a stateless type
+// with static members, so its calls inline into the dispatch path; a
+// PolicySet bundles one of each. SchedulerPolicy (scheduler.hpp) names the
+// combinations instantiated in libschedrt; policy_plugin.hpp has the set
+// that forwards to a plugin loaded at run time.
+
+// ---- Ordering: which ready task a worker pops next ----
+//
+// The ready queue copies a QueueKey out of each task when it is queued or
+// re-keyed, and orders keys with Order::before(a, b): true if a is
+// dispatched first. before() must be a strict weak order; the id makes
+// every key distinct.
+struct QueueKey {
+    int64_t deadline;  // steady_clock ticks; INT64_MAX without one
+    int64_t release;
+    uint64_t id;
+    int32_t priority;
+    uint32_t slot;     // ready-queue bookkeeping, not part of the order
+};
+
+inline QueueKey queue_key(const Task& t, uint32_t slot = 0) {
+    QueueKey k;
+    k.deadline = t.effective_deadline ? t.effective_deadline->time_since_epoch().count()
+                                      : std::numeric_limits<int64_t>::max();
+    k.release = t.release_time.time_since_epoch().count();
+    k.id = t.id;
+    k.priority = t.effective_priority;
+    k.slot = slot;
+    return k;
+}
+
+// Effective priority, then earliest deadline (having one first), then
+// release time and id. The default.
+struct PriorityOrder {
+    static bool before(const QueueKey& a, const QueueKey& b) {
+        if (a.priority != b.priority) return a.priority > b.priority;
+        if (a.deadline != b.deadline) return a.deadline < b.deadline;
+        if (a.release != b.release) return a.release < b.release;
+        return a.id < b.id;
+    }
+};
+
+// Earliest deadline first; priority only breaks ties, so tasks without a
+// deadline run once no deadline is pending.
+struct EdfOrder {
+    static bool before(const QueueKey& a, const QueueKey& b) {
+        if (a.deadline != b.deadline) return a.deadline < b.deadline;
+        if (a.priority != b.priority) return a.priority > b.priority;
+        if (a.release != b.release) return a.release < b.release;
+        return a.id < b.id;
+    }
+};
+
+// Release order, ignoring priority and deadline (and so inheritance).
+struct FifoOrder {
+    static bool before(const QueueKey& a, const QueueKey& b) {
+        if (a.release != b.release) return a.release < b.release;
+        return a.id < b.id;
+    }
+};
+
+// std heap comparator for an ordering: true if a is dispatched after b.
+template <class Order>
+struct TaskOrder {
+    bool operator()(const std::shared_ptr<Task>& a, const std::shared_ptr<Task>& b) const {
+        return Order::before(queue_key(*b), queue_key(*a));
+    }
+};
+
+// ---- Mapping: which local accelerator runs a dispatched task ----
+//
+// Mapping::pick(task, app, view) sees the available local accelerators.
+// Federation forwarding has already been decided by then; a task reaching
+// pick() runs on this node. Null fails the task with NoAccelerator.
+struct MappingView {
+    const std::vector<Accelerator*>& cpu;             // non-reconfigurable providers
+    const std::vector<Accelerator*>& reconfigurable;  // FPGA slots
+    bool use_overlays;                                // false on the CPU backend
+    uint64_t ready_depth;                             // ready tasks still queued
+    unsigned workers;
+};
+
+// A slot holding the task's overlay, else any slot that loads it, else the
+// first CPU provider. The default.
+struct OverlayFirstMapping {
+    static Accelerator* pick(const Task& task, const AppDescriptor& app, const MappingView& v) {
+        if (v.use_overlays && task.required != ResourceKind::CPU) {
+            for (auto* acc : v.reconfigurable) {
+                auto* slot = dynamic_cast<FpgaSlotAccelerator*>(acc);
+                if (!slot) continue;
+                if (slot->current_app() == task.app || slot->ensure_app_loaded(app)) return acc;
+            }
+        }
+        if (!v.cpu.empty()) return v.cpu.front();
+        if (v.use_overlays && !v.reconfigurable.empty()) return v.reconfigurable.front();
+        return nullptr;
+    }
+};
+
+// A slot already holding the overlay, else a CPU provider; slots are only
+// reconfigured on dispatch when there is no CPU provider. Overlays still
+// arrive through preload, so bursty mixes stop thrashing the slots.
+struct ResidentFirstMapping {
+    static Accelerator* pick(const Task& task, const AppDescriptor& app, const MappingView& v) {
+        bool overlay = v.use_overlays && task.required != ResourceKind::CPU;
+        if (overlay) {
+            for (auto* acc : v.reconfigurable) {
+                auto* slot = dynamic_cast<FpgaSlotAccelerator*>(acc);
+                if (slot && slot->current_app() == task.app) return acc;
+            }
+        }
+        if (!v.cpu.empty()) return v.cpu.front();
+        return OverlayFirstMapping::pick(task, app, v);
+    }
+};
+
+// ---- Preload: when to load an overlay ahead of dispatch ----
+//
+// With kTracksDemand the core counts ready tasks per app and asks
+// wants(queued, threshold) each time one is queued, under the counts lock.
+// On true, and when no slot holds the overlay yet, it calls load() outside
+// any lock to place it. Without kTracksDemand the per-app counts (a mutex
+// and a map update per queued task) are compiled out.
+struct PreloadView {
+    const std::vector<FpgaSlotAccelerator*>& slots;  // available slots; none holds the app
+    uint64_t ready_depth;
+    unsigned workers;
+};
+
+struct ThresholdPreload {
+    static constexpr bool kTracksDemand = true;
+    static bool wants(int queued, unsigned threshold) {
+        return threshold > 0 && queued >= static_cast<int>(threshold);
+    }
+    // The first slot that takes the overlay.
+    static void load(const AppDescriptor& app, int, const PreloadView& v) {
+        for (auto* slot : v.slots) {
+            if (slot->ensure_app_loaded(app)) return;
+        }
+    }
+};
+
+struct NoPreload {
+    static constexpr bool kTracksDemand = false;
+    static bool wants(int, unsigned) { return false; }
+    static void load(const AppDescriptor&, int, const PreloadView&) {}
+};
+
+template <class OrderT, class MappingT, class PreloadT>
+struct PolicySet {
+    using Order = OrderT;
+    using Mapping = MappingT;
+    using Preload = PreloadT;
+};
+
+} // namespace schedrt
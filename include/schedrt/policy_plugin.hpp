@@ -0,0 +1,107 @@
+#pragma once
+#include "accelerator.hpp"
+#include "policies.hpp"
+#include "ready_queue.hpp"
+#include <cstdint>
+
+namespace schedrt {
+
+// Scheduling-policy plugins: a shared object, loaded with
+// sched_runner --policy-lib=PATH, that takes over the ordering, accelerator
+// mapping and preload/eviction decisions of a SchedulerPolicy::Plugin
+// scheduler (see apps/policy_interface.hpp for the entry point). It fills
+// a PolicyHooks; a null hook keeps the default rule for that decision.
+//
+// Hooks run on worker and submitting threads, concurrently; the plugin
+// synchronises its own state. The state they receive is a snapshot built
+// for the call, valid only during it. Only plain structs and C strings cross
+// the boundary. kPolicyAbiVersion changes whenever one of them does.
+constexpr uint32_t kPolicyAbiVersion = 2;
+
+// Return values of map() and evict(), besides an accelerator index.
+constexpr int kPolicyDefault = -1;  // fall back to the default rule
+constexpr int kPolicyNone = -2;     // map(): fail the task; evict(): load nothing
+
+struct PolicyTaskInfo {
+    uint64_t id;
+    const char* app;
+    int32_t priority;        // effective, after inheritance
+    int64_t deadline;        // effective; steady_clock ticks, INT64_MAX without one
+    int64_t release;         // steady_clock ticks
+    int64_t est_runtime_ns;  // 0 if unknown
+    ResourceKind required;
+};
+
+struct PolicyAcceleratorInfo {
+    const char* name;
+    const char* overlay;  // app loaded on a slot; "" for CPU providers and empty slots
+    bool reconfigurable;
+};
+
+// Queue and accelerator state at the time of the call. `accelerators` holds
+// the available local candidates (CPU providers first, then slots) for
+// map(), and the slots that could take the overlay for evict().
+struct PolicyState {
+    uint64_t ready_depth;  // ready tasks queued
+    uint32_t workers;
+    bool use_overlays;     // false on the CPU backend
+    const PolicyAcceleratorInfo* accelerators;
+    uint32_t num_accelerators;
+};
+
+struct PolicyHooks {
+    uint32_t abi_version = kPolicyAbiVersion;  // the loader's; reject a mismatch
+    const char* name = "plugin";
+    void* user = nullptr;
+
+    // Ready-queue order: true if a is dispatched before b. Must be a strict
+    // weak order on keys, and cheap: it runs inside every heap sift.
+    bool (*before)(void* user, const QueueKey& a, const QueueKey& b) = nullptr;
+
+    // Index into state.accelerators for a dispatched task. A slot without
+    // the task's overlay is reconfigured first; if that fails the default
+    // mapping decides.
+    int (*map)(void* user, const PolicyTaskInfo& task, const PolicyState& state) = nullptr;
+
+    // Ready tasks of an app before its overlay is considered for preload at
+    // all; 0 keeps the scheduler's (sched_runner --preload-threshold).
+    // Below it no hook is called, so the enqueue path stays cheap.
+    uint32_t preload_threshold = 0;
+
+    // Called each time a task of `app` is queued, with the app's ready count
+    // at or above preload_threshold, while no slot holds its overlay. True
+    // preloads it.
+    bool (*preload)(void* user, const char* app, int queued, const PolicyState& state) = nullptr;
+
+    // Which slot a preload reconfigures, evicting its overlay; the default
+    // is the first slot that loads it.
+    int (*evict)(void* user, const char* app, const PolicyState& state) = nullptr;
+
+    // After the scheduler stopped, before the library is unloaded.
+    void (*shutdown)(void* user) = nullptr;
+};
+
+// Installs the hooks SchedulerPolicy::Plugin schedulers call. Set them before
+// constructing such a scheduler and leave them alone while it runs.
+void set_policy_hooks(const PolicyHooks& hooks);
+const PolicyHooks& policy_hooks();
+
+// The PolicySet behind SchedulerPolicy::Plugin: each forwards to its hook,
+// or to the default rule while the hook is null.
+struct PluginOrder {
+    static bool before(const QueueKey& a, const QueueKey& b);
+};
+
+struct PluginMapping {
+    static Accelerator* pick(const Task& task, const AppDescriptor& app, const MappingView& v);
+};
+
+struct PluginPreload {
+    static constexpr bool kTracksDemand = true;
+    static bool wants(int queued, unsigned threshold);
+    static void load(const AppDescriptor& app, int queued, const PreloadView& v);
+};
+
+extern template class BasicReadyQueue<PluginOrder>;
+
+} // namespace schedrt
@@ -0,0 +1,213 @@
+#pragma once
+#include "instrumented_mutex.hpp"
+#include "policies.hpp"
+#include "task.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace schedrt {
+
+// Ready tasks waiting for a worker, popped in Order (policies.hpp). The heap
+// is 4-ary over compact keys copied out of each Task at push time, so sifts
+// compare contiguous 32-byte entries and never touch a Task or a shared_ptr
+// refcount. Tasks sit in a slot table until popped. Task::queue_pos holds a
+// queued task's slot, so raise() can re-key it in O(log n).
+template <class Order>
+class BasicReadyQueue {
+public:
+    static constexpr size_t kNotQueued = static_cast<size_t>(-1);
+    static constexpr size_t kDispatched = static_cast<size_t>(-2);
+    static constexpr size_t kParked = static_cast<size_t>(-3);
+
+    void push(const std::shared_ptr<Task>& t);
+    // Blocks until a task is ready; null once stop() was called.
+    std::shared_ptr<Task> pop_blocking();
+    // Null when empty. Still hands out queued tasks after stop().
+    std::shared_ptr<Task> try_pop();
+    // Marks a popped task as held back by the caller (e.g. parked for memory)
+    // until it is pushed again; raise() keeps lifting its fields meanwhile.
+    void park(Task& t);
+
+    // Lifts t's effective priority/deadline to at least (priority, deadline)
+    // and restores heap order if it is queued. Parked tasks only get their
+    // fields lifted; tasks already handed to a worker are left alone. Returns
+    // true if anything changed.
+    bool raise(Task& t, int priority, const std::optional<std::chrono::steady_clock::time_point>& deadline);
+
+    // True if a queued task would be dispatched before t.
+    bool outranks(const Task& t) const;
+
+    size_t size() const;
+    void stop();
+
+private:
+    static constexpr size_t kArity = 4;
+
+    std::shared_ptr<Task> take_front();
+    void place(size_t i, const QueueKey& k);
+    void sift_up(size_t i);
+    void sift_down(size_t i);
+
+    std::vector<QueueKey> heap_;
+    std::vector<std::shared_ptr<Task>> tasks_;  // by slot
+    std::vector<uint32_t> pos_;                 // slot -> heap index
+    std::vector<uint32_t> free_;                // unused slots
+    mutable InstrumentedMutex mu_{"ReadyQueue::mu_"};
+    LockCondVar cv_;
+    bool stop_{false};
+};
+
+using ReadyQueue = BasicReadyQueue<PriorityOrder>;
+
+template <class Order>
+void BasicReadyQueue<Order>::push(const std::shared_ptr<Task>& t) {
+    {
+        std::lock_guard<InstrumentedMutex> lk(mu_);
+        uint32_t slot;
+        if (!free_.empty()) {
+            slot = free_.back();
+            free_.pop_back();
+            tasks_[slot] = t;
+        } else {
+            slot = static_cast<uint32_t>(tasks_.size());
+            tasks_.push_back(t);
+            pos_.push_back(0);
+        }
+        t->queue_pos = slot;
+        heap_.push_back(queue_key(*t, slot));
+        sift_up(heap_.size() - 1);
+    }
+    cv_.notify_one();
+}
+
+template <class Order>
+std::shared_ptr<Task> BasicReadyQueue<Order>::pop_blocking() {
+    UniqueLock lk(mu_);
+    cv_.wait(lk, [&]{ return stop_ || !heap_.empty(); });
+    if (stop_) return nullptr;
+    return take_front();
+}
+
+template <class Order>
+std::shared_ptr<Task> BasicReadyQueue<Order>::try_pop() {
+    std::lock_guard<InstrumentedMutex> lk(mu_);
+    if (heap_.empty()) return nullptr;
+    return take_front();
+}
+
+// Caller holds mu_ and the heap is not empty.
+template <class Order>
+std::shared_ptr<Task> BasicReadyQueue<Order>::take_front() {
+    uint32_t slot = heap_.front().slot;
+    auto t = std::move(tasks_[slot]);
+    free_.push_back(slot);
+    t->queue_pos = kDispatched;
+    if (heap_.size() > 1) place(0, heap_.back());
+    heap_.pop_back();
+    if (!heap_.empty()) sift_down(0);
+    return t;
+}
+
+template <class Order>
+void BasicReadyQueue<Order>::park(Task& t) {
+    std::lock_guard<InstrumentedMutex> lk(mu_);
+    t.queue_pos = kParked;
+}
+
+template <class Order>
+bool BasicReadyQueue<Order>::raise(Task& t, int priority,
+                                   const std::optional<std::chrono::steady_clock::time_point>& deadline) {
+    std::lock_guard<InstrumentedMutex> lk(mu_);
+    if (t.queue_pos == kDispatched) return false;
+    bool changed = false;
+    if (priority > t.effective_priority) {
+        t.effective_priority = priority;
+        changed = true;
+    }
+    if (deadline && (!t.effective_deadline || *deadline < *t.effective_deadline)) {
+        t.effective_deadline = deadline;
+        changed = true;
+    }
+    if (changed && t.queue_pos != kNotQueued && t.queue_pos != kParked) {
+        auto slot = static_cast<uint32_t>(t.queue_pos);
+        size_t i = pos_[slot];
+        heap_[i] = queue_key(t, slot);
+        // A raise never moves a task later, but an order may ignore the
+        // fields that changed, so restore order both ways.
+        sift_up(i);
+        sift_down(pos_[slot]);
+    }
+    return changed;
+}
+
+template <class Order>
+bool BasicReadyQueue<Order>::outranks(const Task& t) const {
+    std::lock_guard<InstrumentedMutex> lk(mu_);
+    return !heap_.empty() && !Order::before(queue_key(t), heap_.front());
+}
+
+template <class Order>
+size_t BasicReadyQueue<Order>::size() const {
+    std::lock_guard<InstrumentedMutex> lk(mu_);
+    return heap_.size();
+}
+
+template <class Order>
+void BasicReadyQueue<Order>::stop() {
+    {
+        std::lock_guard<InstrumentedMutex> lk(mu_);
+        stop_ = true;
+    }
+    cv_.notify_all();
+}
+
+template <class Order>
+void BasicReadyQueue<Order>::place(size_t i, const QueueKey& k) {
+    heap_[i] = k;
+    pos_[k.slot] = static_cast<uint32_t>(i);
+}
+
+template <class Order>
+void BasicReadyQueue<Order>::sift_up(size_t i) {
+    QueueKey k = heap_[i];
+    while (i > 0) {
+        size_t parent = (i - 1) / kArity;
+        if (!Order::before(k, heap_[parent])) break;
+        place(i, heap_[parent]);
+        i = parent;
+    }
+    place(i, k);
+}
+
+template <class Order>
+void BasicReadyQueue<Order>::sift_down(size_t i) {
+    QueueKey k = heap_[i];
+    size_t n = heap_.size();
+    for (;;) {
+        size_t first = kArity * i + 1;
+        if (first >= n) break;
+        size_t best = first;
+        size_t last = std::min(first + kArity, n);
+        for (size_t c = first + 1; c < last; ++c) {
+            if (Order::before(heap_[c], heap_[best])) best = c;
+        }
+        if (!Order::before(heap_[best], k)) break;
+        place(i, heap_[best]);
+        i = best;
+    }
+    place(i, k);
+}
+
+// Compiled once in ready_queue.cpp for the stock orders.
+extern template class BasicReadyQueue<PriorityOrder>;
+extern template class BasicReadyQueue<EdfOrder>;
+extern template class BasicReadyQueue<FifoOrder>;
+
+} // namespace schedrt
@@ -1,5 +1,12 @@
 #pragma once
+#include "metrics.hpp"
+#include "task.hpp"
+#include "worker_time.hpp"
 #include <atomic>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
 
 namespace schedrt {
 namespace reporting {
@@ -7,5 +14,30 @@ namespace reporting {
 void set_csv(bool value);
 bool csv_enabled();
 
+// Suppress the per-task [RESULT]/CSV lines (benchmarks); metrics still accumulate.
+void set_quiet(bool value);
+bool quiet();
+
+// Human-readable text for a run's status, e.g. "fft: computed n=512" or
+// "Executed <app> on <accelerator>". Only called when a result is printed.
+void write_status(std::ostream& os, const Status& status, const std::string& app, std::string_view accelerator);
+std::string describe(const Status& status, const std::string& app, std::string_view accelerator);
+
+// " cycles=... instructions=..." for the counters present in sample.
+void write_perf_fields(std::ostream& os, const PerfSample& sample);
+
+// One "[METRICS]" line per app, including averaged counters when collected.
+void write_app_metrics(std::ostream& os, const AppMetricsMap& metrics);
+
+// One "[MEMORY]" line with peak outstanding host/device bytes and deferrals.
+void write_memory_stats(std::ostream& os, const MemoryStats& stats);
+
+// One "[HEDGE]" line with hedged tasks, duplicates launched and won.
+void write_hedge_stats(std::ostream& os, const HedgeStats& stats);
+
+// One "[WORKER]" line per worker with its wall time split by WorkerPhase, in
+// percent, then (with several workers) an id=all line summed over the pool.
+void write_worker_times(std::ostream& os, const std::vector<WorkerTimes>& workers);
+
 } // namespace reporting
 } // namespace schedrt
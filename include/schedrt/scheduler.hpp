@@ -1,41 +1,180 @@
 #pragma once
 #include "accelerator.hpp"
 #include "application_registry.hpp"
+#include "federation.hpp"
+#include "instrumented_mutex.hpp"
+#include "metrics.hpp"
+#include "policies.hpp"
 #include "task.hpp"
+#include "worker_time.hpp"
 #include <atomic>
 #include <condition_variable>
+#include <cstddef>
+#include <functional>
 #include <memory>
 #include <mutex>
+#include <optional>
 #include <queue>
+#include <string>
 #include <thread>
+#include <utility>
 #include <vector>
 
 namespace schedrt {
 
 enum class BackendMode { AUTO, FPGA, CPU };
 
-struct TaskCompare {
-    bool operator()(const std::shared_ptr<Task>& a, const std::shared_ptr<Task>& b) const {
-        if (a->priority != b->priority) return a->priority < b->priority; // max-heap
-        if (a->release_time != b->release_time) return a->release_time > b->release_time;
-        return a->id > b->id;
-    }
+// Default dispatch order (PriorityOrder): effective priority, then earliest
+// effective deadline (tasks with one go first), then release time and id.
+// As a std heap comparator: true if a is dispatched after b.
+struct TaskCompare : TaskOrder<PriorityOrder> {};
+
+// Policy combinations compiled into libschedrt (see policies.hpp).
+enum class SchedulerPolicy {
+    Default,        // PriorityOrder, OverlayFirstMapping, ThresholdPreload
+    Edf,            // EdfOrder, OverlayFirstMapping, ThresholdPreload
+    Fifo,           // FifoOrder, OverlayFirstMapping, ThresholdPreload
+    ResidentFirst,  // PriorityOrder, ResidentFirstMapping, ThresholdPreload
+    NoPreload,      // PriorityOrder, OverlayFirstMapping, NoPreload: for CPU-only runs
+    Plugin,         // hooks from a policy plugin (policy_plugin.hpp)
+};
+
+// "default", "edf", "fifo", "resident-first", "no-preload", "plugin".
+const char* to_string(SchedulerPolicy policy);
+std::optional<SchedulerPolicy> parse_scheduler_policy(const std::string& name);
+
+// Caps on the memory held by dispatched tasks; 0 leaves a pool unlimited.
+struct MemoryBudget {
+    uint64_t host_bytes = 0;
+    uint64_t device_bytes = 0;
+};
+
+// Hedged execution for tail-latency-critical tasks. A task under the policy
+// gets a duplicate on another accelerator (a CPU provider, or another slot)
+// once it has run past `percentile` of its app's recent runtimes, or once
+// its deadline slack drops below min_slack. The first successful attempt is
+// reported and the other is cancelled. The duplicate never goes to the
+// primary's own accelerator, so a CPU-only setup with a single CPU provider
+// never hedges.
+struct HedgePolicy {
+    bool enabled = false;
+    double percentile = 0.95;                 // of recent runtimes; est_runtime_ns until there is history
+    std::chrono::nanoseconds min_slack{0};    // 0 disables the deadline trigger
+    std::vector<std::string> apps;            // hedged apps, besides tasks that set Task::hedge
+};
+
+// Inline fast path: a small task that is ready at submit(), bound for a
+// CPU provider, and outranked by nothing queued runs on the submitting thread
+// instead of going through the ready queue. Tasks with a DASH context are
+// sized by their host footprint, others by est_runtime_ns. 0 disables a limit.
+struct InlinePolicy {
+    std::chrono::nanoseconds max_runtime{0};
+    uint64_t max_bytes = 0;
 };
 
 class Scheduler {
 public:
     Scheduler(ApplicationRegistry& reg, BackendMode mode, unsigned cpu_workers = 0,
               unsigned overlay_preload_threshold = 2);
+    // Same, with the core compiled for `policy` instead of Default. The
+    // policies are fixed for the scheduler's lifetime.
+    Scheduler(ApplicationRegistry& reg, BackendMode mode, SchedulerPolicy policy, unsigned cpu_workers = 0,
+              unsigned overlay_preload_threshold = 2);
     ~Scheduler();
 
     void add_accelerator(std::unique_ptr<Accelerator> acc);
     void submit(const std::shared_ptr<Task>& t);
+    // Executor for continuations (e.g. coroutine resumption, see dash/coro.hpp):
+    // fn runs on a worker thread, queued in the ready queue at `priority`
+    // alongside tasks. Whatever is still queued, parked or waiting on
+    // prerequisites when stop() has joined the workers is settled on the
+    // stopping thread: continuations run, tasks fail with StatusCode::Stopped.
+    void post(std::function<void()> fn, int priority = 0);
+    // True on a CPU worker thread of any running Scheduler, i.e. inside a
+    // task, a continuation or a parallel_for chunk. Code that would block
+    // waiting for other callers checks it so as not to hold a worker.
+    static bool on_worker_thread();
     void start();
     void stop();
 
-private:
-    // PIMPL-ish internal helpers kept in .cpp
+    // Whether start() chose FPGA overlays for FFT/ZIP tasks (false on the CPU
+    // backend). Apps use it to size work for the hardware, e.g. pad FFTs to a
+    // power of two only when the FFT core will run them.
+    bool uses_overlays() const;
+
+    // Snapshot of per-app totals for tasks completed so far.
+    AppMetricsMap app_metrics() const;
+
+    // Ready-queue depth, worker count and resident overlays, as advertised to federation peers.
+    federation::LoadSummary load_summary() const;
+
+    // Tasks whose footprint would push outstanding host or device memory past
+    // the budget are parked and dispatched, in priority order, as running
+    // tasks complete. A task larger than the whole budget runs alone.
+    // Device bytes only count when FPGA overlays are in use.
+    void set_memory_budget(const MemoryBudget& budget);
+    MemoryStats memory_stats() const;
+
+    // On by default: a task's prerequisites inherit the maximum priority and
+    // earliest deadline of everything waiting on them, transitively, and
+    // queued prerequisites are re-keyed in place. Call before start().
+    void set_priority_inheritance(bool enabled);
+
+    // Attempts write FFT/ZIP outputs to private copies and only the winner's
+    // is copied to the caller's buffer. Call before start().
+    void set_hedging(const HedgePolicy& policy);
+    HedgeStats hedge_stats() const;
+
+    // Off by default. Call before start().
+    void set_inline_policy(const InlinePolicy& policy);
+
+    // Off by default. Each worker splits its wall time into WorkerPhase
+    // buckets (worker_time.hpp), with one clock read per phase change; the
+    // totals also go to the live-stats segment. Call before start().
+    void set_worker_accounting(bool enabled);
+    // One entry per CPU worker, empty with accounting off; live while running, final after stop().
+    std::vector<WorkerTimes> worker_times() const;
+
+    // Publish queue/worker/slot/latency counters to the POSIX shm segment
+    // `name` every `period` (see live_stats.hpp). Call before start().
+    bool enable_live_stats(const std::string& name,
+                           std::chrono::milliseconds period = std::chrono::milliseconds(250));
+
+    SchedulerPolicy policy() const;
+
+    // Fork-join on the CPU workers. parallel_for splits [begin, end) into
+    // chunks of at least `grain` indices (a few per worker) and calls
+    // fn(chunk_begin, chunk_end) for each. The calling thread runs chunks too,
+    // and returns once all have run; the first exception thrown by fn is
+    // rethrown there, and chunks not yet started are skipped.
+    //
+    // Chunks are claimed, not assigned: the caller keeps running unclaimed
+    // chunks itself instead of blocking on the helpers it posts, so calling
+    // this from a task, a continuation or another chunk cannot starve the
+    // pool. Helpers that reach a worker after the work is gone do nothing.
+    // Without running workers everything runs on the caller.
+    void parallel_for(size_t begin, size_t end, size_t grain, const std::function<void(size_t, size_t)>& fn);
+
+    // Runs each callable as one parallel_for chunk; no callables is a no-op.
+    template <class... Fns>
+    void parallel_invoke(Fns&&... fns) {
+        if constexpr (sizeof...(Fns) > 0) {
+            std::function<void()> calls[] = {std::function<void()>(std::forward<Fns>(fns))...};
+            parallel_for(0, sizeof...(Fns), 1, [&calls](size_t lo, size_t hi) {
+                for (size_t i = lo; i < hi; ++i) calls[i]();
+            });
+        }
+    }
+
+    // CPU workers parallel_for spreads over; 0 when the scheduler is not running.
+    unsigned parallelism() const;
+
+    // Type-erased core, opaque outside scheduler.cpp: one virtual call per API
+    // call, while everything behind it (queue order, mapping, preload) is
+    // compiled per policy set.
     class Impl;
+
+private:
     std::unique_ptr<Impl> impl_;
 };
 
@@ -1,7 +1,9 @@
 #pragma once
+#include "perf_counters.hpp"
 #include <atomic>
 #include <chrono>
 #include <cstdint>
+#include <functional>
 #include <optional>
 #include <string>
 #include <unordered_map>
@@ -11,6 +13,17 @@ namespace schedrt {
 
 enum class ResourceKind { CPU, ZIP, FFT, FIR };
 
+struct ExecutionResult;
+
+// Memory a task holds from dispatch until it completes: host DRAM for its
+// buffers and device (udmabuf/DMA staging) memory on an FPGA overlay.
+struct MemoryFootprint {
+    uint64_t host_bytes{0};
+    uint64_t device_bytes{0};
+
+    bool empty() const { return host_bytes == 0 && device_bytes == 0; }
+};
+
 struct Task {
     using TaskId = uint64_t;
 
@@ -23,15 +36,74 @@ struct Task {
     std::unordered_map<std::string, std::string> params{};
     std::chrono::nanoseconds est_runtime_ns{0};
     ResourceKind required{ResourceKind::CPU};
+    MemoryFootprint footprint{};  // derived from the DASH context on submit when left empty
     std::atomic<bool> ready{false};
+    std::function<void(const ExecutionResult&)> on_complete{};  // called by the worker after reporting
+    // Set only on Scheduler::post() continuations: the worker calls it itself
+    // instead of dispatching to an accelerator, and nothing is reported.
+    std::function<void()> resume{};
+    bool hedge{false};  // eligible for hedged execution (Scheduler::set_hedging)
+    // Set on hedged attempts; an accelerator abandons the attempt once it reads true.
+    const std::atomic<bool>* cancel{nullptr};
+
+    // Maintained by the scheduler from submit() on. Dependents waiting on
+    // this task lend it their priority and deadline (priority inheritance),
+    // and dispatch order uses these instead of priority/deadline.
+    int effective_priority{0};
+    std::optional<std::chrono::steady_clock::time_point> effective_deadline{};
+    size_t queue_pos{static_cast<size_t>(-1)};  // ReadyQueue slot while queued
+};
+
+inline bool cancelled(const Task& task) {
+    return task.cancel && task.cancel->load(std::memory_order_relaxed);
+}
+
+// What a run did. Accelerators record a code and its numeric details; the
+// text ("zip: compressed (a -> b)") is only built by the reporting sink
+// (reporting::write_status) when a result is printed.
+enum class StatusCode : uint8_t {
+    Executed,           // generic run: "Executed <app> on <accelerator>"
+    Cancelled,          // hedged attempt abandoned
+    UnknownApp,         // app not in the registry
+    NoAccelerator,      // nothing can run the app (or take a hedge duplicate)
+    LoadFailed,         // overlay for the app could not be loaded
+    MissingContext,     // FFT overlay task without an FFT context
+    ZipCompressed,      // detail = {input bytes, output bytes}
+    ZipDecompressed,    // detail = {input bytes, output bytes}
+    ZipMissingBuffers,
+    ZipError,           // detail[0] = zlib return code
+    FftComputed,        // detail[0] = n
+    FftHw,              // detail[0] = n
+    FftBatch,           // detail = {items, n}
+    FftHwBatch,         // detail = {items, n}
+    FftMissingBuffers,
+    FftBufferTooSmall,
+    FftUnsupported,     // detail[0] = n
+    FftDmaFailure,
+    VecComputed,        // detail = {begin, end}
+    VecInvalid,
+    PeerNotConnected,   // federation link to the peer is down
+    PeerSendFailed,
+    PeerLinkLost,       // link dropped with the task in flight
+    Stopped,            // scheduler stopped before the task ran
+};
+
+struct Status {
+    StatusCode code{StatusCode::Executed};
+    bool cpu_fallback{false};  // FPGA run fell back to the CPU path
+    bool hedge{false};         // result came from the hedged duplicate
+    int64_t detail[2]{};
 };
 
 struct ExecutionResult {
     Task::TaskId id{};
     bool ok{false};
-    std::string message;
+    Status status{};
     std::chrono::nanoseconds runtime_ns{0};
-    std::string accelerator;
+    // Name of what ran it: a string owned by the accelerator, or a literal
+    // such as "none", valid while the scheduler and its accelerators live.
+    const char* accelerator{""};
+    PerfSample perf{};  // filled by the worker when perf::enabled()
 };
 
 } // namespace schedrt
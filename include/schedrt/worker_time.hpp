@@ -0,0 +1,89 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+namespace schedrt {
+
+// Per-worker wall-time accounting (Scheduler::set_worker_accounting). A
+// worker is always in exactly one phase; at each transition it reads
+// steady_clock once and charges the elapsed time to the phase it leaves.
+// Nothing is sampled between transitions.
+enum class WorkerPhase : uint32_t {
+    Idle = 0,      // blocked in the ready queue waiting for work
+    Select = 1,    // choosing an accelerator (select_accelerator, federation, mapping)
+    Execute = 2,   // inside Accelerator::run or a posted continuation
+    LockWait = 3,  // blocked on a contended slot run lock or the report lock
+    Report = 4,    // completion bookkeeping, metrics and output under the report lock
+    Other = 5,     // everything else: queue bookkeeping, admission, hedging
+};
+inline constexpr unsigned kWorkerPhases = 6;
+
+// "idle", "select", "execute", "lock_wait", "report", "other".
+const char* to_string(WorkerPhase phase);
+
+struct WorkerTimes {
+    uint64_t ns[kWorkerPhases] = {};  // indexed by WorkerPhase
+    uint64_t tasks = 0;               // tasks and continuations popped
+
+    uint64_t total_ns() const;
+    uint64_t operator[](WorkerPhase phase) const { return ns[static_cast<unsigned>(phase)]; }
+    WorkerTimes& operator+=(const WorkerTimes& other);
+};
+
+// One worker's accumulators. Only the worker itself calls start/enter/stop;
+// read() may run on any thread and includes the time spent so far in the
+// current phase, so a live total can be a transition's worth off.
+class WorkerClock {
+public:
+    // Begins accounting in Other.
+    void start();
+    // Switches to `phase` and returns the phase left.
+    WorkerPhase enter(WorkerPhase phase);
+    // Charges the current phase and stops the clock; read() is exact afterwards.
+    void stop();
+    void count_task() { tasks_.fetch_add(1, std::memory_order_relaxed); }
+    WorkerTimes read() const;
+
+private:
+    static int64_t now() { return std::chrono::steady_clock::now().time_since_epoch().count(); }
+
+    std::atomic<uint64_t> ns_[kWorkerPhases]{};
+    std::atomic<uint64_t> tasks_{0};
+    std::atomic<uint32_t> phase_{static_cast<uint32_t>(WorkerPhase::Other)};
+    std::atomic<int64_t> since_{0};  // steady_clock ticks; 0 while stopped
+};
+
+// The clock of the worker running on this thread, or null (accounting off,
+// or not a scheduler worker).
+WorkerClock* current_worker_clock();
+void set_current_worker_clock(WorkerClock* clock);
+
+// Charges a scope to `phase` on the calling worker and restores the phase
+// it interrupted. No-op on threads without a clock.
+class WorkerPhaseScope {
+public:
+    explicit WorkerPhaseScope(WorkerPhase phase) : clock_(current_worker_clock()) {
+        if (clock_) prev_ = clock_->enter(phase);
+    }
+    ~WorkerPhaseScope() {
+        if (clock_) clock_->enter(prev_);
+    }
+    WorkerPhaseScope(const WorkerPhaseScope&) = delete;
+    WorkerPhaseScope& operator=(const WorkerPhaseScope&) = delete;
+
+private:
+    WorkerClock* clock_;
+    WorkerPhase prev_{WorkerPhase::Other};
+};
+
+// Locks m, charging the wait to LockWait only when it is contended; the
+// uncontended path costs one try_lock and no clock read.
+template <class Mutex>
+void lock_accounted(Mutex& m) {
+    if (m.try_lock()) return;
+    WorkerPhaseScope wait(WorkerPhase::LockWait);
+    m.lock();
+}
+
+} // namespace schedrt
@@ -1,10 +1,13 @@
 #include "dash/contexts.hpp"
+#include "dash/fft_cpu.hpp"
+#include "dash/scheduler_binding.hpp"
 #include "schedrt/accelerator.hpp"
+#include "schedrt/worker_time.hpp"
 
 #include <algorithm>
+#include <atomic>
 #include <chrono>
 #include <cmath>
-#include <complex>
 #include <csetjmp>
 #include <csignal>
 #include <cstdlib>
@@ -22,11 +25,15 @@
 #include <string>
 #include <thread>
 #include <utility>
+#include <vector>
 #include <fcntl.h>
+#include <sys/ioctl.h>
 #include <sys/mman.h>
 #include <unistd.h>
 #include <zlib.h>
 
+#include "axi_dma_map_ioctl.h"
+
 namespace {
 class SigbusScope;
 
@@ -127,10 +134,95 @@ dash::FftContext* fft_context(const schedrt::Task& task) {
     return context_from_task<dash::FftContext>(task, dash::kFftContextKey);
 }
 
+dash::FftBatchContext* fft_batch_context(const schedrt::Task& task) {
+    return context_from_task<dash::FftBatchContext>(task, dash::kFftBatchContextKey);
+}
+
+dash::VecContext* vec_context(const schedrt::Task& task) {
+    return context_from_task<dash::VecContext>(task, dash::kVecContextKey);
+}
+
+using schedrt::StatusCode;
+
+schedrt::Status make_status(StatusCode code, int64_t a = 0, int64_t b = 0) {
+    schedrt::Status st;
+    st.code = code;
+    st.detail[0] = a;
+    st.detail[1] = b;
+    return st;
+}
+
+// Compression splits inputs of at least two chunks into one raw deflate
+// stream per chunk, compressed in parallel. Each is primed with the 32 KiB
+// before it as a dictionary, so the ratio barely moves. Streams end on a
+// sync flush and are concatenated under one zlib header and Adler-32, the
+// same layout pigz uses. The result is an ordinary zlib stream for
+// uncompress(). Decompression stays serial.
+constexpr size_t kZipChunk = 256 * 1024;
+constexpr size_t kZipWindow = 32 * 1024;
+
+// Raw deflate of in[0, len) after dict; byte-aligned unless it is the last.
+bool deflate_chunk(const Bytef* dict, size_t dict_len, const Bytef* in, size_t len, int level, bool last,
+                   std::vector<Bytef>& out) {
+    z_stream zs{};
+    if (deflateInit2(&zs, level, Z_DEFLATED, -15, 8, Z_DEFAULT_STRATEGY) != Z_OK) return false;
+    bool ok = dict_len == 0 || deflateSetDictionary(&zs, dict, static_cast<uInt>(dict_len)) == Z_OK;
+    if (ok) {
+        out.resize(deflateBound(&zs, static_cast<uLong>(len)) + 16);  // + the sync-flush marker
+        zs.next_in = const_cast<Bytef*>(in);
+        zs.avail_in = static_cast<uInt>(len);
+        zs.next_out = out.data();
+        zs.avail_out = static_cast<uInt>(out.size());
+        int ret = deflate(&zs, last ? Z_FINISH : Z_SYNC_FLUSH);
+        ok = last ? ret == Z_STREAM_END : ret == Z_OK && zs.avail_in == 0 && zs.avail_out > 0;
+        out.resize(zs.total_out);
+    }
+    deflateEnd(&zs);
+    return ok;
+}
+
+// compress2() with the chunked layout above; same return codes.
+int compress_chunked(Bytef* dst, uLongf* dst_len, const Bytef* src, size_t len, int level) {
+    size_t chunks = (len + kZipChunk - 1) / kZipChunk;
+    std::vector<std::vector<Bytef>> parts(chunks);
+    std::vector<uLong> sums(chunks);
+    std::atomic<bool> ok{true};
+    dash::parallel_for(0, chunks, 1, [&](size_t lo, size_t hi) {
+        for (size_t c = lo; c < hi; ++c) {
+            size_t begin = c * kZipChunk, n = std::min(kZipChunk, len - begin);
+            size_t dict = std::min(begin, kZipWindow);
+            if (!deflate_chunk(src + begin - dict, dict, src + begin, n, level, c + 1 == chunks, parts[c]))
+                ok.store(false, std::memory_order_relaxed);
+            sums[c] = adler32(adler32(0L, Z_NULL, 0), src + begin, static_cast<uInt>(n));
+        }
+    });
+    if (!ok) return Z_STREAM_ERROR;
+
+    size_t total = 2 + 4;
+    for (const auto& p : parts) total += p.size();
+    if (total > *dst_len) return Z_BUF_ERROR;
+    // Header as deflate writes it: 32 KiB window, FLEVEL from the level, FCHECK.
+    unsigned flevel = level < 2 ? 0 : level < 6 ? 1 : level == 6 ? 2 : 3;
+    unsigned header = (0x78u << 8) | (flevel << 6);
+    header += 31 - header % 31;
+    Bytef* out = dst;
+    *out++ = static_cast<Bytef>(header >> 8);
+    *out++ = static_cast<Bytef>(header & 0xff);
+    uLong sum = sums[0];
+    for (size_t c = 0; c < chunks; ++c) {
+        std::memcpy(out, parts[c].data(), parts[c].size());
+        out += parts[c].size();
+        if (c) sum = adler32_combine(sum, sums[c], static_cast<z_off_t>(std::min(kZipChunk, len - c * kZipChunk)));
+    }
+    for (int shift = 24; shift >= 0; shift -= 8) *out++ = static_cast<Bytef>((sum >> shift) & 0xff);
+    *dst_len = static_cast<uLongf>(total);
+    return Z_OK;
+}
+
 bool run_zip_operation(dash::ZipContext& ctx) {
     if (!ctx.in.data || !ctx.out.data) {
         ctx.ok = false;
-        ctx.message = "zip: buffers missing";
+        ctx.status = make_status(StatusCode::ZipMissingBuffers);
         return false;
     }
     auto* dst = static_cast<Bytef*>(ctx.out.data);
@@ -139,61 +231,145 @@ bool run_zip_operation(dash::ZipContext& ctx) {
     int level = std::clamp(ctx.params.level, 0, 9);
     int ret = Z_OK;
     if (ctx.params.mode == dash::ZipMode::Compress) {
-        ret = compress2(dst, &dest_len, src, ctx.in.bytes, level);
+        auto* sched = dash::scheduler();
+        bool split = ctx.in.bytes >= 2 * kZipChunk && sched && sched->parallelism() > 0;
+        ret = split ? compress_chunked(dst, &dest_len, src, ctx.in.bytes, level)
+                    : compress2(dst, &dest_len, src, ctx.in.bytes, level);
     } else {
         ret = uncompress(dst, &dest_len, src, ctx.in.bytes);
     }
     ctx.ok = (ret == Z_OK);
     if (ctx.out_actual) *ctx.out_actual = static_cast<size_t>(dest_len);
     if (ctx.ok) {
-        ctx.message = "zip: " + std::string(ctx.params.mode == dash::ZipMode::Compress ? "compressed" : "decompressed")
-            + " (" + std::to_string(ctx.in.bytes) + " -> " + std::to_string(dest_len) + ")";
+        ctx.status = make_status(ctx.params.mode == dash::ZipMode::Compress ? StatusCode::ZipCompressed
+                                                                            : StatusCode::ZipDecompressed,
+                                 static_cast<int64_t>(ctx.in.bytes), static_cast<int64_t>(dest_len));
         return true;
     }
-    ctx.message = "zip: zlib error " + std::to_string(ret);
+    ctx.status = make_status(StatusCode::ZipError, ret);
     return false;
 }
 
 bool run_fft_operation(dash::FftContext& ctx) {
     if (!ctx.in.data || !ctx.out.data) {
         ctx.ok = false;
-        ctx.message = "fft: missing buffers";
+        ctx.status = make_status(StatusCode::FftMissingBuffers);
         return false;
     }
+    // Buffers hold interleaved real/imag samples, matching the hardware runner.
     auto* in = static_cast<const float*>(ctx.in.data);
     auto* out = static_cast<float*>(ctx.out.data);
-    size_t max_in = ctx.in.bytes / sizeof(float);
-    size_t max_out = ctx.out.bytes / sizeof(float);
+    size_t max_in = ctx.in.bytes / (2 * sizeof(float));
+    size_t max_out = ctx.out.bytes / (2 * sizeof(float));
     size_t n = ctx.plan.n ? ctx.plan.n : std::min(max_in, max_out);
     if (n == 0 || max_in < n || max_out < n) {
         ctx.ok = false;
-        ctx.message = "fft: buffer sizes insufficient";
+        ctx.status = make_status(StatusCode::FftBufferTooSmall);
         return false;
     }
-    const double two_pi = 2.0 * M_PI;
-    double sign = ctx.plan.inverse ? 1.0 : -1.0;
-    for (size_t k = 0; k < n; ++k) {
-        std::complex<double> sum(0.0, 0.0);
-        for (size_t j = 0; j < n; ++j) {
-            double angle = two_pi * static_cast<double>(k) * static_cast<double>(j) / static_cast<double>(n);
-            sum += std::complex<double>(in[j], 0.0) * std::polar(1.0, angle * sign);
-        }
-        if (ctx.plan.inverse && n > 0) sum /= static_cast<double>(n);
-        out[k] = static_cast<float>(sum.real());
+    dash::FftPlan plan = ctx.plan;
+    plan.n = static_cast<int>(n);
+    if (!dash::fft_cpu_execute(plan, in, out)) {
+        ctx.ok = false;
+        ctx.status = make_status(StatusCode::FftUnsupported, static_cast<int64_t>(n));
+        return false;
     }
     ctx.ok = true;
-    ctx.message = "fft: computed n=" + std::to_string(n);
+    ctx.status = make_status(StatusCode::FftComputed, static_cast<int64_t>(n));
     return true;
 }
 
+// Items with unusable buffers fail on their own; the rest are split across workers.
+bool run_fft_batch_operation(dash::FftBatchContext& batch) {
+    size_t n = batch.plan.n > 0 ? static_cast<size_t>(batch.plan.n) : 0;
+    std::vector<const float*> ins;
+    std::vector<float*> outs;
+    std::vector<dash::FftContext*> runnable;
+    for (auto& item : batch.items) {
+        if (n == 0 || !item.in.data || !item.out.data ||
+            item.in.bytes < n * 2 * sizeof(float) || item.out.bytes < n * 2 * sizeof(float)) {
+            item.ok = false;
+            item.status = make_status(StatusCode::FftBufferTooSmall);
+            continue;
+        }
+        ins.push_back(static_cast<const float*>(item.in.data));
+        outs.push_back(static_cast<float*>(item.out.data));
+        runnable.push_back(&item);
+    }
+    // Transforms are independent; each chunk of them looks the plan up once.
+    std::atomic<bool> ran{n > 0};
+    dash::parallel_for(0, runnable.size(), 1, [&](size_t lo, size_t hi) {
+        if (!dash::fft_cpu_execute_batch(batch.plan, hi - lo, ins.data() + lo, outs.data() + lo))
+            ran.store(false, std::memory_order_relaxed);
+    });
+    for (auto* item : runnable) {
+        item->ok = ran;
+        item->status = make_status(ran ? StatusCode::FftComputed : StatusCode::FftUnsupported, static_cast<int64_t>(n));
+    }
+    batch.ok = ran && runnable.size() == batch.items.size();
+    batch.status = make_status(StatusCode::FftBatch, static_cast<int64_t>(batch.items.size()), static_cast<int64_t>(n));
+    return batch.ok;
+}
+
+bool run_vec_operation(dash::VecContext& ctx) {
+    ctx.ok = dash::vec::run_range(ctx.job, ctx.begin, ctx.end, &ctx.best);
+    ctx.status = ctx.ok ? make_status(StatusCode::VecComputed, static_cast<int64_t>(ctx.begin),
+                                      static_cast<int64_t>(ctx.end))
+                        : make_status(StatusCode::VecInvalid);
+    return ctx.ok;
+}
+
+// DMA staging buffer. init_dma_buf() allocates one of the requested size
+// from axi_dma_map's /dev/axi_dma_buf and can be called again to resize;
+// init() maps a u-dma-buf device whose size was fixed when it was loaded.
 class UdmabufRegion {
 public:
-    ~UdmabufRegion() {
+    ~UdmabufRegion() { reset(); }
+
+    void reset() {
         if (virt_) munmap(virt_, size_);
         if (fd_ >= 0) close(fd_);
+        fd_ = -1;
+        virt_ = nullptr;
+        size_ = 0;
+        phys_ = 0;
+        allocated_ = false;
+        cached_ = false;
+    }
+
+    bool init_dma_buf(const std::string& dev_path, size_t bytes, bool cached) {
+        reset();
+        fd_ = ::open(dev_path.c_str(), O_RDWR | O_CLOEXEC);
+        if (fd_ < 0) {
+            if (errno != ENOENT) {
+                std::cerr << "[dma-buf] open(" << dev_path << ") failed: " << strerror(errno) << "\n";
+            }
+            return false;
+        }
+        axi_dma_buf_alloc req{};
+        req.size = bytes;
+        req.flags = cached ? AXI_DMA_BUF_CACHED : 0;
+        if (ioctl(fd_, AXI_DMA_BUF_IOC_ALLOC, &req) != 0) {
+            std::cerr << "[dma-buf] allocating " << bytes << " bytes failed: " << strerror(errno) << "\n";
+            reset();
+            return false;
+        }
+        void* map = mmap(nullptr, req.size, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+        if (map == MAP_FAILED) {
+            std::cerr << "[dma-buf] mmap failed: " << strerror(errno) << "\n";
+            reset();
+            return false;
+        }
+        virt_ = map;
+        size_ = static_cast<size_t>(req.size);
+        phys_ = req.bus_addr;
+        allocated_ = true;
+        cached_ = cached;
+        return true;
     }
 
     bool init(const std::string& dev_name, size_t min_size_bytes) {
+        reset();
         std::string sysfs_base = "/sys/class/u-dma-buf/" + dev_name;
         uint64_t size_value = 0;
         if (!read_value(sysfs_base + "/size", &size_value)) return false;
@@ -225,8 +401,24 @@ public:
     void* virt() const { return virt_; }
     size_t size() const { return size_; }
     uint64_t phys() const { return phys_; }
+    bool resizable() const { return allocated_; }
+    bool cached() const { return cached_; }
+
+    // Cache maintenance for cached allocations; the other mappings are
+    // uncached and these are no-ops.
+    bool sync_for_device(size_t offset, size_t bytes) const { return sync(AXI_DMA_BUF_TO_DEVICE, offset, bytes); }
+    bool sync_for_cpu(size_t offset, size_t bytes) const { return sync(AXI_DMA_BUF_FROM_DEVICE, offset, bytes); }
 
 private:
+    bool sync(uint32_t direction, size_t offset, size_t bytes) const {
+        if (!cached_) return true;
+        axi_dma_buf_sync req{};
+        req.offset = offset;
+        req.size = bytes;
+        req.direction = direction;
+        return ioctl(fd_, AXI_DMA_BUF_IOC_SYNC, &req) == 0;
+    }
+
     static bool read_value(const std::string& path, uint64_t* out) {
         std::ifstream ifs(path);
         if (!ifs) return false;
@@ -244,6 +436,8 @@ private:
     void* virt_{nullptr};
     size_t size_{0};
     uint64_t phys_{0};
+    bool allocated_{false};
+    bool cached_{false};
 };
 
 class AxiDmaController {
@@ -517,14 +711,7 @@ public:
     FftHwRunner() = default;
 
     bool initialize() {
-        std::string udmabuf_name = "udmabuf0";
-        if (const char* env = std::getenv("SCHEDRT_UDMABUF")) udmabuf_name = env;
-        if (!buffer_.init(udmabuf_name, 1 << 19)) {
-            std::cerr << "[fft-hw] missing udmabuf (" << udmabuf_name << ")\n";
-            return false;
-        }
-        std::cout << "[fft-hw] udmabuf '" << udmabuf_name << "' size=" << buffer_.size()
-                  << " bytes phys=0x" << std::hex << buffer_.phys() << std::dec << "\n";
+        if (!init_buffer()) return false;
 
         // AXI DMA control registers live at 0x40410000 in the top_reconfig design.
         uintptr_t dma_base = 0x40410000;
@@ -553,12 +740,53 @@ public:
         return true;
     }
 
+    // Prefers a buffer from axi_dma_map, sized by SCHEDRT_DMA_BUF_BYTES and
+    // grown on demand; falls back to the preallocated u-dma-buf device.
+    bool init_buffer() {
+        if (const char* env = std::getenv("SCHEDRT_DMA_BUF")) dma_buf_path_ = env;
+        if (const char* env = std::getenv("SCHEDRT_DMA_BUF_BYTES")) {
+            try {
+                dma_buf_bytes_ = static_cast<size_t>(std::stoull(env, nullptr, 0));
+            } catch (...) {
+                std::cerr << "[fft-hw] invalid SCHEDRT_DMA_BUF_BYTES value\n";
+            }
+        }
+        if (const char* env = std::getenv("SCHEDRT_DMA_BUF_MAX")) {
+            try {
+                dma_buf_max_ = static_cast<size_t>(std::stoull(env, nullptr, 0));
+            } catch (...) {
+                std::cerr << "[fft-hw] invalid SCHEDRT_DMA_BUF_MAX value\n";
+            }
+        }
+        dma_buf_cached_ = std::getenv("SCHEDRT_DMA_BUF_CACHED") != nullptr;
+        if (!dma_buf_path_.empty() && buffer_.init_dma_buf(dma_buf_path_, dma_buf_bytes_, dma_buf_cached_)) {
+            std::cout << "[fft-hw] " << dma_buf_path_ << " " << (buffer_.cached() ? "cached" : "coherent")
+                      << " size=" << buffer_.size() << " bytes bus=0x" << std::hex << buffer_.phys() << std::dec
+                      << "\n";
+            return true;
+        }
+
+        std::string udmabuf_name = "udmabuf0";
+        if (const char* env = std::getenv("SCHEDRT_UDMABUF")) udmabuf_name = env;
+        if (!buffer_.init(udmabuf_name, 1 << 19)) {
+            std::cerr << "[fft-hw] no DMA buffer (" << (dma_buf_path_.empty() ? "" : dma_buf_path_ + " or ")
+                      << udmabuf_name << ")\n";
+            return false;
+        }
+        std::cout << "[fft-hw] udmabuf '" << udmabuf_name << "' size=" << buffer_.size()
+                  << " bytes phys=0x" << std::hex << buffer_.phys() << std::dec << "\n";
+        return true;
+    }
+
     bool available() const { return ready_; }
 
-    bool execute(dash::FftContext& ctx) {
+    // cancel is checked once the DMA engine is ours; a transfer in flight is not aborted.
+    bool execute(dash::FftContext& ctx, const std::atomic<bool>* cancel = nullptr) {
         if (!ready_) return false;
         if (!ctx.in.data || !ctx.out.data) return false;
-        std::lock_guard<std::mutex> lk(mu_);
+        schedrt::lock_accounted(mu_);  // waiting for the DMA engine counts as lock wait
+        std::lock_guard<schedrt::InstrumentedMutex> lk(mu_, std::adopt_lock);
+        if (cancel && cancel->load(std::memory_order_relaxed)) return false;
 
         size_t sample_count = ctx.plan.n;
         if (sample_count == 0) {
@@ -566,11 +794,12 @@ public:
             sample_count = complex_floats;
         }
         if (sample_count == 0) return false;
+        // The FFT core takes power-of-two frames only; other lengths fall back to the CPU.
+        if ((sample_count & (sample_count - 1)) != 0) return false;
         size_t bytes = sample_count * sizeof(int16_t) * 2;
         fft_trace_log(std::string("execute start samples=") + std::to_string(sample_count)
                       + " bytes=" + std::to_string(bytes));
-        size_t half_buf = buffer_.size() / 2;
-        if (bytes > half_buf) {
+        if (!reserve(bytes, 1)) {
             std::cerr << "[fft-hw] requested transfer exceeds buffer size\n";
             return false;
         }
@@ -585,12 +814,8 @@ public:
         auto* hw_in = reinterpret_cast<int16_t*>(static_cast<uint8_t*>(buffer_.virt()) + input_offset_);
         auto* hw_out = reinterpret_cast<int16_t*>(static_cast<uint8_t*>(buffer_.virt()) + output_offset_);
 
-        for (size_t i = 0; i < sample_count * 2; ++i) {
-            float value = input[i];
-            if (value > 0.999969f) value = 0.999969f;
-            if (value < -1.0f) value = -1.0f;
-            hw_in[i] = static_cast<int16_t>(std::lrint(value * 32767.0f));
-        }
+        quantize(input, hw_in, sample_count);
+        buffer_.sync_for_device(input_offset_, bytes);
         {
             std::ostringstream oss;
             oss << "input quantized, launching DMA src=0x"
@@ -603,33 +828,130 @@ public:
         if (!dma_->transfer(buffer_.phys() + input_offset_, buffer_.phys() + output_offset_, bytes)) {
             fft_trace_log("DMA transfer failed for current task");
             ctx.ok = false;
-            ctx.message = "fft: hw DMA failure";
+            ctx.status = make_status(StatusCode::FftDmaFailure);
             return false;
         }
         fft_trace_log("DMA transfer complete, converting results back to floats");
+        buffer_.sync_for_cpu(output_offset_, bytes);
 
-        for (size_t i = 0; i < sample_count * 2; ++i) {
-            output[i] = static_cast<float>(hw_out[i]) / 32768.0f;
-        }
+        dequantize(hw_out, output, sample_count);
         ctx.ok = true;
-        ctx.message = "fft: hw n=" + std::to_string(sample_count);
+        ctx.status = make_status(StatusCode::FftHw, static_cast<int64_t>(sample_count));
         fft_trace_log(std::string("execute finished samples=") + std::to_string(sample_count));
         return true;
     }
 
+    // Same-plan transforms in one session: the runner lock is taken once, as
+    // many inputs as fit in the input half are quantized up front and their
+    // frames go out back to back. Each frame is still its own DMA transfer,
+    // since the core closes every frame with TLAST.
+    bool execute_batch(dash::FftBatchContext& batch, const std::atomic<bool>* cancel = nullptr) {
+        if (!ready_ || batch.items.empty() || batch.plan.n <= 0) return false;
+        size_t sample_count = static_cast<size_t>(batch.plan.n);
+        if ((sample_count & (sample_count - 1)) != 0) return false;
+        size_t bytes = sample_count * sizeof(int16_t) * 2;
+        for (const auto& item : batch.items) {
+            if (!item.in.data || !item.out.data || item.in.bytes < sample_count * 2 * sizeof(float) ||
+                item.out.bytes < sample_count * 2 * sizeof(float)) {
+                return false;
+            }
+        }
+        schedrt::lock_accounted(mu_);  // waiting for the DMA engine counts as lock wait
+        std::lock_guard<schedrt::InstrumentedMutex> lk(mu_, std::adopt_lock);
+        if (cancel && cancel->load(std::memory_order_relaxed)) return false;
+        if (!reserve(bytes, batch.items.size())) {
+            std::cerr << "[fft-hw] requested transfer exceeds buffer size\n";
+            return false;
+        }
+        size_t half_buf = buffer_.size() / 2;
+        fft_trace_log("execute_batch start items=" + std::to_string(batch.items.size())
+                      + " samples=" + std::to_string(sample_count));
+
+        auto* base = static_cast<uint8_t*>(buffer_.virt());
+        size_t frames = half_buf / bytes;
+        for (size_t first = 0; first < batch.items.size(); first += frames) {
+            size_t count = std::min(frames, batch.items.size() - first);
+            for (size_t k = 0; k < count; ++k) {
+                quantize(static_cast<const float*>(batch.items[first + k].in.data),
+                         reinterpret_cast<int16_t*>(base + input_offset_ + k * bytes), sample_count);
+            }
+            buffer_.sync_for_device(input_offset_, count * bytes);
+            for (size_t k = 0; k < count; ++k) {
+                if (!dma_->transfer(buffer_.phys() + input_offset_ + k * bytes,
+                                    buffer_.phys() + output_offset_ + k * bytes, bytes)) {
+                    fft_trace_log("DMA transfer failed in batch");
+                    batch.ok = false;
+                    batch.status = make_status(StatusCode::FftDmaFailure);
+                    return false;
+                }
+            }
+            buffer_.sync_for_cpu(output_offset_, count * bytes);
+            for (size_t k = 0; k < count; ++k) {
+                auto& item = batch.items[first + k];
+                dequantize(reinterpret_cast<const int16_t*>(base + output_offset_ + k * bytes),
+                           static_cast<float*>(item.out.data), sample_count);
+                item.ok = true;
+                item.status = make_status(StatusCode::FftHw, static_cast<int64_t>(sample_count));
+            }
+        }
+        batch.ok = true;
+        batch.status = make_status(StatusCode::FftHwBatch, static_cast<int64_t>(batch.items.size()),
+                                   static_cast<int64_t>(sample_count));
+        fft_trace_log("execute_batch finished items=" + std::to_string(batch.items.size()));
+        return true;
+    }
+
 private:
+    // Makes each half hold at least one `frame_bytes` frame, and up to
+    // `frames` of them within SCHEDRT_DMA_BUF_MAX. Only allocated buffers
+    // grow; the old one is freed first, so a failed grow falls back to its
+    // previous size. Caller holds mu_.
+    bool reserve(size_t frame_bytes, size_t frames) {
+        size_t half = buffer_.size() / 2;
+        if (!buffer_.resizable()) return frame_bytes <= half;
+        size_t want = std::max(frame_bytes, std::min(frames * frame_bytes, dma_buf_max_ / 2));
+        if (want <= half) return true;
+        size_t previous = buffer_.size();
+        if (!buffer_.init_dma_buf(dma_buf_path_, 2 * want, dma_buf_cached_) &&
+            !buffer_.init_dma_buf(dma_buf_path_, previous, dma_buf_cached_)) {
+            std::cerr << "[fft-hw] lost the DMA buffer while resizing\n";
+            return false;
+        }
+        output_offset_ = buffer_.size() / 2;
+        fft_trace_log("DMA buffer now " + std::to_string(buffer_.size()) + " bytes");
+        return frame_bytes <= buffer_.size() / 2;
+    }
+
+    // Q15 I/Q samples for the FFT core; inputs are clamped to its range.
+    static void quantize(const float* in, int16_t* out, size_t samples) {
+        for (size_t i = 0; i < samples * 2; ++i) {
+            float value = in[i];
+            if (value > 0.999969f) value = 0.999969f;
+            if (value < -1.0f) value = -1.0f;
+            out[i] = static_cast<int16_t>(std::lrint(value * 32767.0f));
+        }
+    }
+
+    static void dequantize(const int16_t* in, float* out, size_t samples) {
+        for (size_t i = 0; i < samples * 2; ++i) out[i] = static_cast<float>(in[i]) / 32768.0f;
+    }
+
     UdmabufRegion buffer_;
+    std::string dma_buf_path_{AXI_DMA_BUF_DEVICE};
+    size_t dma_buf_bytes_{1 << 19};
+    size_t dma_buf_max_{8 << 20};
+    bool dma_buf_cached_{false};
     std::unique_ptr<AxiDmaController> dma_;
     size_t input_offset_{0};
     size_t output_offset_{0};
     bool ready_{false};
-    std::mutex mu_;
+    schedrt::InstrumentedMutex mu_{"FftHwRunner::mu_"};
 };
 
 std::shared_ptr<FftHwRunner> acquire_fft_runner() {
-    static std::mutex runner_mu;
+    static schedrt::InstrumentedMutex runner_mu{"acquire_fft_runner::runner_mu"};
     static std::shared_ptr<FftHwRunner> runner;
-    std::lock_guard<std::mutex> lk(runner_mu);
+    std::lock_guard<schedrt::InstrumentedMutex> lk(runner_mu);
     if (!runner) {
         auto tmp = std::make_shared<FftHwRunner>();
         if (tmp->initialize()) {
@@ -641,44 +963,78 @@ std::shared_ptr<FftHwRunner> acquire_fft_runner() {
 } // namespace
 
 namespace schedrt {
+namespace {
+
+constexpr Status kCancelled{StatusCode::Cancelled};
+
+// Mock execution time, slept in short steps so a cancelled hedge attempt
+// gives its worker back early. False if the attempt was cancelled.
+bool sleep_unless_cancelled(const Task& task, std::chrono::nanoseconds dur) {
+    if (!task.cancel) {
+        std::this_thread::sleep_for(dur);
+        return true;
+    }
+    constexpr std::chrono::nanoseconds kStep = std::chrono::microseconds(200);
+    auto end = std::chrono::steady_clock::now() + dur;
+    for (;;) {
+        if (cancelled(task)) return false;
+        auto now = std::chrono::steady_clock::now();
+        if (now >= end) return true;
+        std::this_thread::sleep_for(std::min<std::chrono::nanoseconds>(kStep, end - now));
+    }
+}
+
+} // namespace
 
 // ---------------- CPU mock ----------------
 class CpuMockAccelerator : public Accelerator {
 public:
-    explicit CpuMockAccelerator(unsigned id) : id_(id) {}
-    std::string name() const override { return "cpu-mock-" + std::to_string(id_); }
+    explicit CpuMockAccelerator(unsigned id) : name_("cpu-mock-" + std::to_string(id)) {}
+    std::string name() const override { return name_; }
     bool is_available() override { return true; }
     bool ensure_app_loaded(const AppDescriptor&) override { return true; }
-    ExecutionResult run(const Task& task, const AppDescriptor& app) override {
+    ExecutionResult run(const Task& task, const AppDescriptor&) override {
         auto t0 = std::chrono::steady_clock::now();
         bool ok = true;
-        std::string message = "Executed " + app.app + " on mock CPU";
-        if (auto* ctx = zip_context(task)) {
+        Status status{};
+        if (cancelled(task)) {
+            ok = false;
+            status = kCancelled;
+        } else if (auto* ctx = zip_context(task)) {
             ok = run_zip_operation(*ctx);
-            message = ctx->message;
+            status = ctx->status;
         } else if (auto* ctx = fft_context(task)) {
             ok = run_fft_operation(*ctx);
-            message = ctx->message;
+            status = ctx->status;
+        } else if (auto* ctx = fft_batch_context(task)) {
+            ok = run_fft_batch_operation(*ctx);
+            status = ctx->status;
+        } else if (auto* ctx = vec_context(task)) {
+            ok = run_vec_operation(*ctx);
+            status = ctx->status;
         } else {
             auto dur = task.est_runtime_ns.count() > 0 ? task.est_runtime_ns
                                                        : std::chrono::nanoseconds(10000000);
-            std::this_thread::sleep_for(dur);
+            if (!sleep_unless_cancelled(task, dur)) {
+                ok = false;
+                status = kCancelled;
+            }
         }
         auto t1 = std::chrono::steady_clock::now();
-        return {task.id, ok, message,
+        return {task.id, ok, status,
                 std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0),
-                name()};
+                name_.c_str()};
     }
 private:
-    unsigned id_;
+    std::string name_;  // results point into it
 };
 
 // --------------- FPGA PR slot ----------------
 FpgaSlotAccelerator::FpgaSlotAccelerator(unsigned slot, FpgaSlotOptions opts)
-    : slot_(slot), opts_(std::move(opts)) {}
+    : slot_(slot), name_("fpga-slot-" + std::to_string(slot)), opts_(std::move(opts)) {}
 
 std::string FpgaSlotAccelerator::name() const {
-    return "fpga-slot-" + std::to_string(slot_);
+    return name_;
 }
 
 bool FpgaSlotAccelerator::is_available() {
@@ -688,7 +1044,7 @@ bool FpgaSlotAccelerator::is_available() {
 }
 
 bool FpgaSlotAccelerator::ensure_app_loaded(const AppDescriptor& app) {
-    std::lock_guard<std::mutex> lk(mu_);
+    std::lock_guard<InstrumentedMutex> lk(mu_);
     log_debug("ensure_app_loaded app=" + app.app + " kind=" + std::to_string(static_cast<int>(app.kind))
               + " bitstream=" + app.bitstream_path);
     if (configured_ && current_app_ == app.app) return true;
@@ -704,7 +1060,7 @@ bool FpgaSlotAccelerator::ensure_app_loaded(const AppDescriptor& app) {
 }
 
 bool FpgaSlotAccelerator::prepare_static() {
-    std::lock_guard<std::mutex> lk(mu_);
+    std::lock_guard<InstrumentedMutex> lk(mu_);
     if (static_loaded_ || opts_.static_bitstream.empty()) return true;
     log_debug("prepare_static shell=" + opts_.static_bitstream);
     if (!load_bitstream(opts_.static_bitstream)) {
@@ -717,14 +1073,17 @@ bool FpgaSlotAccelerator::prepare_static() {
 }
 
 ExecutionResult FpgaSlotAccelerator::run(const Task& task, const AppDescriptor& app) {
-    std::lock_guard<std::mutex> run_lk(run_mu_);
+    lock_accounted(run_mu_);  // time queued behind another run counts as lock wait
+    std::lock_guard<InstrumentedMutex> run_lk(run_mu_, std::adopt_lock);
     log_debug("run task id=" + std::to_string(task.id) + " app=" + task.app);
+    // A hedge may have won while this attempt waited for the slot; skip the reconfiguration too.
+    if (cancelled(task)) return {task.id, false, kCancelled, std::chrono::nanoseconds(0), name_.c_str()};
     if (!ensure_app_loaded(app)) {
-        return {task.id, false, "Failed to ensure " + app.app + " on " + name(), std::chrono::nanoseconds(0), name()};
+        return {task.id, false, {StatusCode::LoadFailed}, std::chrono::nanoseconds(0), name_.c_str()};
     }
     auto t0 = std::chrono::steady_clock::now();
     bool ok = true;
-    std::string message = "Executed " + app.app + " on " + name();
+    Status status{};
 if (!opts_.mock_mode && task.app == "fft") {
         auto* ctx = fft_context(task);
         bool ran_hw = false;
@@ -732,37 +1091,58 @@ if (!opts_.mock_mode && task.app == "fft") {
             log_debug("fft context available for task=" + std::to_string(task.id));
             auto runner = acquire_fft_runner();
             if (runner && runner->available()) {
-                ran_hw = runner->execute(*ctx);
+                ran_hw = runner->execute(*ctx, task.cancel);
                 ok = ran_hw && ctx->ok;
-                message = ctx->message;
+                status = ctx->status;
             }
-            if (!ran_hw) {
+            if (cancelled(task)) {
+                ok = false;
+                status = kCancelled;
+            } else if (!ran_hw) {
                 log_debug("fft task fallback to CPU path (id=" + std::to_string(task.id) + ")");
                 ok = run_fft_operation(*ctx);
-                message = ctx->message + " (cpu fallback)";
+                status = ctx->status;
+                status.cpu_fallback = true;
+            }
+        } else if (auto* batch = fft_batch_context(task)) {
+            auto runner = acquire_fft_runner();
+            if (runner && runner->available()) ran_hw = runner->execute_batch(*batch, task.cancel);
+            ok = ran_hw && batch->ok;
+            status = batch->status;
+            if (cancelled(task)) {
+                ok = false;
+                status = kCancelled;
+            } else if (!ran_hw) {
+                log_debug("fft batch fallback to CPU path (id=" + std::to_string(task.id) + ")");
+                ok = run_fft_batch_operation(*batch);
+                status = batch->status;
+                status.cpu_fallback = true;
             }
         } else {
             log_debug("fft task missing execution context (id=" + std::to_string(task.id) + ")");
             ok = false;
-            message = "fft: missing execution context";
+            status.code = StatusCode::MissingContext;
         }
     } else {
         auto dur = task.est_runtime_ns.count() > 0 ? task.est_runtime_ns
                                                    : std::chrono::nanoseconds(15000000);
-        std::this_thread::sleep_for(dur);
+        if (!sleep_unless_cancelled(task, dur)) {
+            ok = false;
+            status = kCancelled;
+        }
     }
     auto t1 = std::chrono::steady_clock::now();
     std::chrono::nanoseconds elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0);
-    return {task.id, ok, message, elapsed, name()};
+    return {task.id, ok, status, elapsed, name_.c_str()};
 }
 
 std::string FpgaSlotAccelerator::current_app() const {
-    std::lock_guard<std::mutex> lk(mu_);
+    std::lock_guard<InstrumentedMutex> lk(mu_);
     return current_app_;
 }
 
 ResourceKind FpgaSlotAccelerator::current_kind() const {
-    std::lock_guard<std::mutex> lk(mu_);
+    std::lock_guard<InstrumentedMutex> lk(mu_);
     return current_kind_;
 }
 
@@ -770,14 +1150,24 @@ unsigned FpgaSlotAccelerator::slot_id() const {
     return slot_;
 }
 
+ReconfigTiming FpgaSlotAccelerator::last_reconfig() const {
+    std::lock_guard<InstrumentedMutex> lk(mu_);
+    return last_reconfig_;
+}
+
+// Caller holds mu_.
 bool FpgaSlotAccelerator::load_bitstream(const std::string& path) {
+    using Clock = std::chrono::steady_clock;
     log_debug("load_bitstream start path=" + path);
+    last_reconfig_ = {};
     if (path.empty()) {
         log("No bitstream path provided; skipping load");
+        last_reconfig_.ok = true;
         return true;
     }
     if (opts_.mock_mode) {
         log("Mock loading " + path);
+        last_reconfig_.ok = true;
         return true;
     }
     struct DecoupleGuard {
@@ -787,6 +1177,7 @@ bool FpgaSlotAccelerator::load_bitstream(const std::string& path) {
             if (slot && engaged) slot->set_decouple_gpio(false);
         }
     } guard{this, false};
+    auto t0 = Clock::now();
     if (has_pr_gpio()) {
         if (!set_decouple_gpio(true)) {
             log("Failed to assert PR decouple GPIO");
@@ -794,16 +1185,29 @@ bool FpgaSlotAccelerator::load_bitstream(const std::string& path) {
         }
         guard.engaged = true;
     }
-    std::ofstream ofs(opts_.manager_path);
-    if (!ofs) {
-        log("Unable to open FPGA manager at " + opts_.manager_path);
-        return false;
+    auto t1 = Clock::now();
+    last_reconfig_.decouple = t1 - t0;
+    {
+        std::ofstream ofs(opts_.manager_path);
+        if (!ofs) {
+            log("Unable to open FPGA manager at " + opts_.manager_path);
+            return false;
+        }
+        ofs << path << "\n";
+        ofs.flush();  // the manager reconfigures inside this write
+        if (!ofs.good()) {
+            log("Write failed for bitstream " + path);
+            return false;
+        }
     }
-    ofs << path << "\n";
-    if (!ofs.good()) {
-        log("Write failed for bitstream " + path);
-        return false;
+    auto t2 = Clock::now();
+    last_reconfig_.program = t2 - t1;
+    if (guard.engaged) {
+        guard.engaged = false;
+        set_decouple_gpio(false);
+        last_reconfig_.release = Clock::now() - t2;
     }
+    last_reconfig_.ok = true;
     log("Requested reconfiguration " + path);
     return true;
 }
@@ -0,0 +1,106 @@
+#include "dash/contexts.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+namespace dash {
+namespace {
+
+template <typename T>
+T* context_from_task(const schedrt::Task& task, const char* key) {
+    auto it = task.params.find(key);
+    if (it == task.params.end() || it->second.empty()) return nullptr;
+    return reinterpret_cast<T*>(static_cast<std::uintptr_t>(std::stoull(it->second)));
+}
+
+std::string pointer_param(const void* p) {
+    return std::to_string(reinterpret_cast<std::uintptr_t>(p));
+}
+
+// Private buffer for `view`; the input copy also takes its contents.
+BufferView private_view(const BufferView& view, std::vector<uint8_t>& storage, bool copy) {
+    if (copy) {
+        auto* src = static_cast<const uint8_t*>(view.data);
+        storage.assign(src, src + view.bytes);
+    } else {
+        storage.resize(view.bytes);
+    }
+    return {storage.data(), view.bytes};
+}
+
+uint64_t host_bytes(const BufferView& in, const BufferView& out) {
+    // In-place jobs hold one buffer, not two.
+    if (in.data && in.data == out.data) return std::max(in.bytes, out.bytes);
+    return static_cast<uint64_t>(in.bytes) + out.bytes;
+}
+
+// The FFT overlay stages int16 I/Q samples in the udmabuf: one half in, one half out.
+uint64_t fft_device_bytes(const FftContext& fft) {
+    size_t n = fft.plan.n > 0 ? static_cast<size_t>(fft.plan.n) : fft.in.bytes / (2 * sizeof(float));
+    return 2 * n * 2 * sizeof(int16_t);
+}
+
+} // namespace
+
+schedrt::MemoryFootprint task_footprint(const schedrt::Task& task) {
+    schedrt::MemoryFootprint fp;
+    if (const auto* fft = context_from_task<FftContext>(task, kFftContextKey)) {
+        fp.host_bytes = host_bytes(fft->in, fft->out);
+        fp.device_bytes = fft_device_bytes(*fft);
+    } else if (const auto* batch = context_from_task<FftBatchContext>(task, kFftBatchContextKey)) {
+        for (const auto& item : batch->items) {
+            fp.host_bytes += host_bytes(item.in, item.out);
+            fp.device_bytes += fft_device_bytes(item);
+        }
+    } else if (const auto* zip = context_from_task<ZipContext>(task, kZipContextKey)) {
+        // zlib runs on the host even on a ZIP overlay; nothing is staged in the udmabuf.
+        fp.host_bytes = host_bytes(zip->in, zip->out);
+    }
+    return fp;
+}
+
+std::unique_ptr<PrivateOutput> PrivateOutput::create(const schedrt::Task& task) {
+    if (task.params.count(kVecContextKey) || task.params.count(kFftBatchContextKey)) return nullptr;
+    std::unique_ptr<PrivateOutput> p(new PrivateOutput);
+    if (auto* fft = context_from_task<FftContext>(task, kFftContextKey)) {
+        if (!fft->out.data) return nullptr;
+        p->fft_target_ = fft;
+        p->fft_.plan = fft->plan;
+        p->fft_.in = fft->in.data == fft->out.data ? private_view(fft->in, p->in_, true) : fft->in;
+        p->fft_.out = private_view(fft->out, p->out_, false);
+    } else if (auto* zip = context_from_task<ZipContext>(task, kZipContextKey)) {
+        if (!zip->out.data) return nullptr;
+        p->zip_target_ = zip;
+        p->zip_.params = zip->params;
+        p->zip_.in = zip->in.data == zip->out.data ? private_view(zip->in, p->in_, true) : zip->in;
+        p->zip_.out = private_view(zip->out, p->out_, false);
+        p->zip_.out_actual = &p->zip_actual_;
+    }
+    return p;
+}
+
+void PrivateOutput::bind(schedrt::Task& attempt) const {
+    if (fft_target_) attempt.params[kFftContextKey] = pointer_param(&fft_);
+    if (zip_target_) attempt.params[kZipContextKey] = pointer_param(&zip_);
+}
+
+// A failed or cancelled attempt leaves the caller's buffer untouched; only
+// its status is passed on.
+void PrivateOutput::commit() {
+    if (fft_target_) {
+        if (fft_.ok) std::memcpy(fft_target_->out.data, out_.data(), out_.size());
+        fft_target_->ok = fft_.ok;
+        fft_target_->status = fft_.status;
+    } else if (zip_target_) {
+        if (zip_.ok) {
+            std::memcpy(zip_target_->out.data, out_.data(), std::min(zip_actual_, out_.size()));
+            if (zip_target_->out_actual) *zip_target_->out_actual = zip_actual_;
+        }
+        zip_target_->ok = zip_.ok;
+        zip_target_->status = zip_.status;
+    }
+}
+
+} // namespace dash
@@ -1,46 +1,161 @@
 #include "dash/contexts.hpp"
-#include "dash/contexts.hpp"
 #include "dash/fft.hpp"
 #include "dash/provider.hpp"
 #include "dash/scheduler_binding.hpp"
 #include "dash/completion_bus.hpp"
+#include "schedrt/instrumented_mutex.hpp"
 #include "schedrt/scheduler.hpp"
 #include "schedrt/task.hpp"
 
+#include <algorithm>
 #include <atomic>
 #include <chrono>
 #include <cstdint>
+#include <future>
+#include <map>
 #include <memory>
+#include <tuple>
+#include <utility>
+#include <vector>
 
 namespace {
 uint64_t next_id() {
     static std::atomic<uint64_t> c{1000};
     return c.fetch_add(1, std::memory_order_relaxed);
 }
-}
-
-namespace dash {
-bool fft_execute(const FftPlan& plan, BufferView in, BufferView out) {
-    auto provs = providers_for("fft");
-    if (provs.empty()) return false;
-
-    auto kind = provs.front().kind;
-    auto ctx = std::make_shared<FftContext>();
-    ctx->plan = plan;
-    ctx->in = in;
-    ctx->out = out;
 
+std::shared_ptr<schedrt::Task> make_task(schedrt::ResourceKind kind, const char* key, const void* ctx) {
     auto t = std::make_shared<schedrt::Task>();
     t->id = next_id();
     t->app = "fft";
     t->required = kind;
     t->est_runtime_ns = std::chrono::nanoseconds(15000000);
-    t->params.emplace(kFftContextKey, std::to_string(reinterpret_cast<std::uintptr_t>(ctx.get())));
+    t->params.emplace(key, std::to_string(reinterpret_cast<std::uintptr_t>(ctx)));
+    return t;
+}
+
+bool run_single(schedrt::ResourceKind kind, const dash::FftPlan& plan, dash::BufferView in, dash::BufferView out) {
+    auto ctx = std::make_shared<dash::FftContext>();
+    ctx->plan = plan;
+    ctx->in = in;
+    ctx->out = out;
 
-    auto fut = dash::subscribe(t->id);
     auto* sched = dash::scheduler();
     if (!sched) return false;
+    auto t = make_task(kind, dash::kFftContextKey, ctx.get());
+    auto fut = dash::subscribe(t->id);
     sched->submit(t);
     return fut.get();
 }
+
+// One caller waiting in the coalescer.
+struct Request {
+    dash::BufferView in;
+    dash::BufferView out;
+    std::promise<bool> done;
+};
+
+// Requests for one plan gathered into one task. The first caller to find no
+// open batch for its plan leads: it waits out the window (or until the batch
+// is sealed full), runs the batch and resolves every request. Callers that
+// arrive after the seal open the next batch while this one is in flight.
+// Scheduler workers never lead; with no open batch they run alone.
+struct Batch {
+    std::vector<Request*> requests;
+    bool sealed = false;
+    schedrt::LockCondVar full;
+};
+
+schedrt::InstrumentedMutex g_batch_mu{"dash::fft_batch"};
+dash::FftBatchOptions g_batch_opts;
+dash::FftBatchStats g_batch_stats;
+std::map<std::tuple<int, bool, dash::FftPrecision>, std::shared_ptr<Batch>> g_open;  // per plan
+
+void run_batch(schedrt::ResourceKind kind, const dash::FftPlan& plan, const std::vector<Request*>& batch) {
+    if (batch.size() == 1) {
+        batch.front()->done.set_value(run_single(kind, plan, batch.front()->in, batch.front()->out));
+        return;
+    }
+    auto ctx = std::make_shared<dash::FftBatchContext>();
+    ctx->plan = plan;
+    ctx->items.resize(batch.size());
+    for (size_t i = 0; i < batch.size(); ++i) {
+        ctx->items[i].plan = plan;
+        ctx->items[i].in = batch[i]->in;
+        ctx->items[i].out = batch[i]->out;
+    }
+    bool ran = false;
+    if (auto* sched = dash::scheduler()) {
+        auto t = make_task(kind, dash::kFftBatchContextKey, ctx.get());
+        auto fut = dash::subscribe(t->id);
+        sched->submit(t);
+        ran = fut.get();
+    }
+    // The task's status is the batch's; each caller gets its own item's.
+    for (size_t i = 0; i < batch.size(); ++i) batch[i]->done.set_value(ran && ctx->items[i].ok);
+}
+} // namespace
+
+namespace dash {
+bool fft_execute(const FftPlan& plan, BufferView in, BufferView out) {
+    auto provs = providers_for("fft");
+    if (provs.empty()) return false;
+    auto kind = provs.front().kind;
+
+    schedrt::UniqueLock lk(g_batch_mu);
+    unsigned max_batch = g_batch_opts.max_batch;
+    // Plans with n = 0 take their length from the buffers, so they never share a batch.
+    if (max_batch <= 1 || plan.n <= 0) {
+        lk.unlock();
+        return run_single(kind, plan, in, out);
+    }
+
+    Request req{in, out, {}};
+    auto result = req.done.get_future();
+    ++g_batch_stats.requests;
+    auto& open = g_open[{plan.n, plan.inverse, plan.precision}];
+    if (open) {
+        open->requests.push_back(&req);
+        if (open->requests.size() >= max_batch) {
+            open->sealed = true;
+            open->full.notify_one();
+            open.reset();
+        }
+        lk.unlock();
+        return result.get();
+    }
+
+    // Leading means sleeping out the window; on a worker that would hold the
+    // worker idle, so worker callers only join batches other threads lead.
+    if (schedrt::Scheduler::on_worker_thread()) {
+        ++g_batch_stats.batches;
+        g_batch_stats.largest = std::max<uint64_t>(g_batch_stats.largest, 1);
+        lk.unlock();
+        return run_single(kind, plan, in, out);
+    }
+
+    auto batch = std::make_shared<Batch>();
+    batch->requests.push_back(&req);
+    open = batch;
+    batch->full.wait_for(lk, g_batch_opts.window, [&] { return batch->sealed; });
+    if (!batch->sealed) {
+        batch->sealed = true;
+        g_open.erase({plan.n, plan.inverse, plan.precision});
+    }
+    ++g_batch_stats.batches;
+    g_batch_stats.largest = std::max<uint64_t>(g_batch_stats.largest, batch->requests.size());
+    lk.unlock();
+    run_batch(kind, plan, batch->requests);
+    return result.get();
+}
+
+void fft_set_batching(const FftBatchOptions& opts) {
+    std::lock_guard<schedrt::InstrumentedMutex> lk(g_batch_mu);
+    g_batch_opts = opts;
+}
+
+FftBatchStats fft_batch_stats() {
+    std::lock_guard<schedrt::InstrumentedMutex> lk(g_batch_mu);
+    return g_batch_stats;
+}
 } // namespace dash
@@ -0,0 +1,844 @@
+#include "dash/fft_cpu.hpp"
+#include "dash/fft_fixed.hpp"
+#include "dash/fft_wisdom.hpp"
+#include "dash/host_buffer.hpp"
+#include "dash/scheduler_binding.hpp"
+#include "schedrt/instrumented_mutex.hpp"
+
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <complex>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace dash {
+namespace {
+
+using cd = std::complex<double>;
+
+// The engine works on split re/im arrays so every pass is a plain loop over
+// T that the compiler vectorizes at the precision's full width. T is the
+// data type; W is the type twiddles are stored and applied in (Mixed is
+// T = float, W = double).
+
+template <typename T, typename W>
+inline void apply_twiddle(T& re, T& im, W wr, W wi) {
+    W r = static_cast<W>(re), i = static_cast<W>(im);
+    re = static_cast<T>(r * wr - i * wi);
+    im = static_cast<T>(r * wi + i * wr);
+}
+
+// Multiply by W4 = exp(-i*pi/2) (forward) or exp(+i*pi/2) (inverse).
+template <bool Inverse, typename T>
+inline void rot4(T& re, T& im) {
+    T r = re;
+    if constexpr (Inverse) {
+        re = -im;
+        im = r;
+    } else {
+        re = im;
+        im = -r;
+    }
+}
+
+// Multiply by W8 = exp(-+i*pi/4).
+template <bool Inverse, typename T>
+inline void rot8(T& re, T& im) {
+    const T h = static_cast<T>(M_SQRT1_2);
+    T r = re;
+    if constexpr (Inverse) {
+        re = h * (r - im);
+        im = h * (r + im);
+    } else {
+        re = h * (r + im);
+        im = h * (im - r);
+    }
+}
+
+template <int P, bool Inverse, typename T>
+inline void butterfly(T* re, T* im) {
+    if constexpr (P == 2) {
+        T tr = re[0], ti = im[0];
+        re[0] = tr + re[1];
+        im[0] = ti + im[1];
+        re[1] = tr - re[1];
+        im[1] = ti - im[1];
+    } else if constexpr (P == 4) {
+        T s02r = re[0] + re[2], s02i = im[0] + im[2];
+        T d02r = re[0] - re[2], d02i = im[0] - im[2];
+        T s13r = re[1] + re[3], s13i = im[1] + im[3];
+        T d13r = re[1] - re[3], d13i = im[1] - im[3];
+        rot4<Inverse>(d13r, d13i);
+        re[0] = s02r + s13r;
+        im[0] = s02i + s13i;
+        re[1] = d02r + d13r;
+        im[1] = d02i + d13i;
+        re[2] = s02r - s13r;
+        im[2] = s02i - s13i;
+        re[3] = d02r - d13r;
+        im[3] = d02i - d13i;
+    } else if constexpr (P == 3) {
+        // X1,2 = x0 - (x1 + x2)/2 -+ i*sin(pi/3)*(x1 - x2), sign flipped for the inverse.
+        const T s = static_cast<T>(0.86602540378443864676);
+        T ar = re[1] + re[2], ai = im[1] + im[2];
+        T br = s * (re[1] - re[2]), bi = s * (im[1] - im[2]);
+        T mr = re[0] - ar / 2, mi = im[0] - ai / 2;
+        re[0] += ar;
+        im[0] += ai;
+        rot4<Inverse>(br, bi);
+        re[1] = mr + br;
+        im[1] = mi + bi;
+        re[2] = mr - br;
+        im[2] = mi - bi;
+    } else if constexpr (P == 5) {
+        // Pairs x1/x4 and x2/x3 share cosines; their differences share sines.
+        const T c1 = static_cast<T>(0.30901699437494742410), c2 = static_cast<T>(-0.80901699437494742410);
+        const T s1 = static_cast<T>(0.95105651629515357212), s2 = static_cast<T>(0.58778525229247312917);
+        T a1r = re[1] + re[4], a1i = im[1] + im[4], b1r = re[1] - re[4], b1i = im[1] - im[4];
+        T a2r = re[2] + re[3], a2i = im[2] + im[3], b2r = re[2] - re[3], b2i = im[2] - im[3];
+        T m1r = re[0] + c1 * a1r + c2 * a2r, m1i = im[0] + c1 * a1i + c2 * a2i;
+        T m2r = re[0] + c2 * a1r + c1 * a2r, m2i = im[0] + c2 * a1i + c1 * a2i;
+        T n1r = s1 * b1r + s2 * b2r, n1i = s1 * b1i + s2 * b2i;
+        T n2r = s2 * b1r - s1 * b2r, n2i = s2 * b1i - s1 * b2i;
+        rot4<Inverse>(n1r, n1i);
+        rot4<Inverse>(n2r, n2i);
+        re[0] += a1r + a2r;
+        im[0] += a1i + a2i;
+        re[1] = m1r + n1r;
+        im[1] = m1i + n1i;
+        re[4] = m1r - n1r;
+        im[4] = m1i - n1i;
+        re[2] = m2r + n2r;
+        im[2] = m2i + n2i;
+        re[3] = m2r - n2r;
+        im[3] = m2i - n2i;
+    } else {
+        static_assert(P == 8, "fixed butterflies are radix 2/3/4/5/8");
+        T er[4] = {re[0], re[2], re[4], re[6]}, ei[4] = {im[0], im[2], im[4], im[6]};
+        T orr[4] = {re[1], re[3], re[5], re[7]}, oi[4] = {im[1], im[3], im[5], im[7]};
+        butterfly<4, Inverse>(er, ei);
+        butterfly<4, Inverse>(orr, oi);
+        rot8<Inverse>(orr[1], oi[1]);
+        rot4<Inverse>(orr[2], oi[2]);
+        rot8<Inverse>(orr[3], oi[3]);
+        rot4<Inverse>(orr[3], oi[3]);
+        for (int k = 0; k < 4; ++k) {
+            re[k] = er[k] + orr[k];
+            im[k] = ei[k] + oi[k];
+            re[k + 4] = er[k] - orr[k];
+            im[k + 4] = ei[k] - oi[k];
+        }
+    }
+}
+
+struct CpuFftPlan {
+    size_t n = 0;
+    bool inverse = false;
+    FftPrecision precision = FftPrecision::Fp32;
+    std::vector<int> radices;
+    bool in_place = false;
+    // Per-pass twiddles in the order the passes read them, starting at
+    // tw_offset[pass]. Only the table for the precision's W is filled.
+    host_vector<double> tw64_re, tw64_im;
+    host_vector<float> tw32_re, tw32_im;
+    std::vector<size_t> tw_offset;
+    std::vector<cd> master;       // W_n^j, only for radices without a fixed butterfly
+    std::vector<uint32_t> perm;   // digit-reversal gather, in-place layout only
+    // Bluestein: the forward m-point Stockham plan the convolution runs on.
+    // Pass 0 of the twiddle table holds the chirp (n entries), pass 1 the
+    // kernel spectrum scaled by 1/m (m entries).
+    std::shared_ptr<const CpuFftPlan> inner;
+
+    template <typename W>
+    const W* tw_re(size_t pass) const {
+        if constexpr (std::is_same_v<W, double>) return tw64_re.data() + tw_offset[pass];
+        else return tw32_re.data() + tw_offset[pass];
+    }
+    template <typename W>
+    const W* tw_im(size_t pass) const {
+        if constexpr (std::is_same_v<W, double>) return tw64_im.data() + tw_offset[pass];
+        else return tw32_im.data() + tw_offset[pass];
+    }
+};
+
+// Generic radix-p DFT on a[0..p) using the plan's master table.
+template <typename W>
+void dft_generic(std::complex<W>* a, int p, const CpuFftPlan& plan, std::vector<std::complex<W>>& tmp) {
+    tmp.assign(a, a + p);
+    const size_t step = plan.n / static_cast<size_t>(p);
+    for (int k = 0; k < p; ++k) {
+        W sr = tmp[0].real(), si = tmp[0].imag();
+        for (int r = 1; r < p; ++r) {
+            size_t j = (static_cast<size_t>(r) * k) % static_cast<size_t>(p);
+            const cd& w = plan.master[j * step];
+            W wr = static_cast<W>(w.real()), wi = static_cast<W>(w.imag());
+            sr += tmp[r].real() * wr - tmp[r].imag() * wi;
+            si += tmp[r].real() * wi + tmp[r].imag() * wr;
+        }
+        a[k] = {sr, si};
+    }
+}
+
+// Every pass is n / P independent butterflies, numbered pp * stride + q
+// (Stockham) or block * span + j (in place). The pass functions run
+// butterflies [lo, hi), so a large pass can be split across workers.
+
+// One decimation-in-frequency Stockham pass: reads x, writes y in autosorted
+// order. The loop over q is innermost and contiguous; the first pass
+// (stride 1) runs over pp instead.
+template <int P, bool Inverse, typename T, typename W>
+void stockham_pass(const T* __restrict xr, const T* __restrict xi, T* __restrict yr, T* __restrict yi,
+                   size_t len, size_t stride, const W* twr, const W* twi, size_t lo, size_t hi) {
+    const size_t m = len / P;
+    if (stride == 1) {
+        for (size_t pp = lo; pp < hi; ++pp) {
+            T ar[P], ai[P];
+            for (int r = 0; r < P; ++r) {
+                ar[r] = xr[pp + r * m];
+                ai[r] = xi[pp + r * m];
+            }
+            butterfly<P, Inverse>(ar, ai);
+            yr[P * pp] = ar[0];
+            yi[P * pp] = ai[0];
+            for (int k = 1; k < P; ++k) {
+                apply_twiddle(ar[k], ai[k], twr[pp * (P - 1) + k - 1], twi[pp * (P - 1) + k - 1]);
+                yr[P * pp + k] = ar[k];
+                yi[P * pp + k] = ai[k];
+            }
+        }
+        return;
+    }
+    for (size_t t = lo; t < hi;) {
+        const size_t pp = t / stride, q0 = t % stride, q1 = std::min(stride, q0 + (hi - t));
+        t += q1 - q0;
+        W wr[P], wi[P];
+        for (int k = 1; k < P; ++k) {
+            wr[k] = twr[pp * (P - 1) + k - 1];
+            wi[k] = twi[pp * (P - 1) + k - 1];
+        }
+        const T* sr = xr + stride * pp;
+        const T* si = xi + stride * pp;
+        T* dr = yr + stride * P * pp;
+        T* di = yi + stride * P * pp;
+        for (size_t q = q0; q < q1; ++q) {
+            T ar[P], ai[P];
+            for (int r = 0; r < P; ++r) {
+                ar[r] = sr[q + stride * r * m];
+                ai[r] = si[q + stride * r * m];
+            }
+            butterfly<P, Inverse>(ar, ai);
+            dr[q] = ar[0];
+            di[q] = ai[0];
+            for (int k = 1; k < P; ++k) {
+                apply_twiddle(ar[k], ai[k], wr[k], wi[k]);
+                dr[q + stride * k] = ar[k];
+                di[q + stride * k] = ai[k];
+            }
+        }
+    }
+}
+
+template <bool Inverse, typename T, typename W>
+void stockham_pass_generic(const T* xr, const T* xi, T* yr, T* yi, size_t len, size_t stride, int p,
+                           const CpuFftPlan& plan, const W* twr, const W* twi, size_t lo, size_t hi) {
+    const size_t m = len / p;
+    std::vector<std::complex<W>> a(p), tmp;
+    for (size_t t = lo; t < hi;) {
+        const size_t pp = t / stride, q0 = t % stride, q1 = std::min(stride, q0 + (hi - t));
+        t += q1 - q0;
+        for (size_t q = q0; q < q1; ++q) {
+            for (int r = 0; r < p; ++r) {
+                size_t idx = q + stride * (pp + r * m);
+                a[r] = {static_cast<W>(xr[idx]), static_cast<W>(xi[idx])};
+            }
+            dft_generic(a.data(), p, plan, tmp);
+            for (int k = 0; k < p; ++k) {
+                T re = static_cast<T>(a[k].real()), im = static_cast<T>(a[k].imag());
+                if (k) {
+                    W r = a[k].real(), i = a[k].imag();
+                    W tr = twr[pp * (p - 1) + k - 1], ti = twi[pp * (p - 1) + k - 1];
+                    re = static_cast<T>(r * tr - i * ti);
+                    im = static_cast<T>(r * ti + i * tr);
+                }
+                size_t idx = q + stride * (p * pp + k);
+                yr[idx] = re;
+                yi[idx] = im;
+            }
+        }
+    }
+}
+
+// One in-place decimation-in-time pass combining blocks of span into span * P.
+// Twiddles are laid out [r - 1][j], so the loop over j is contiguous.
+template <int P, bool Inverse, typename T, typename W>
+void dit_pass(T* __restrict re, T* __restrict im, size_t span, const W* twr, const W* twi, size_t lo, size_t hi) {
+    const size_t block = span * P;
+    if (span == 1) {
+        // First pass: every twiddle is 1.
+        for (size_t base = lo * P; base < hi * P; base += P) {
+            T ar[P], ai[P];
+            for (int r = 0; r < P; ++r) {
+                ar[r] = re[base + r];
+                ai[r] = im[base + r];
+            }
+            butterfly<P, Inverse>(ar, ai);
+            for (int k = 0; k < P; ++k) {
+                re[base + k] = ar[k];
+                im[base + k] = ai[k];
+            }
+        }
+        return;
+    }
+    for (size_t t = lo; t < hi;) {
+        const size_t j0 = t % span, j1 = std::min(span, j0 + (hi - t));
+        T* br = re + (t / span) * block;
+        T* bi = im + (t / span) * block;
+        t += j1 - j0;
+        for (size_t j = j0; j < j1; ++j) {
+            T ar[P], ai[P];
+            ar[0] = br[j];
+            ai[0] = bi[j];
+            for (int r = 1; r < P; ++r) {
+                ar[r] = br[r * span + j];
+                ai[r] = bi[r * span + j];
+                apply_twiddle(ar[r], ai[r], twr[(r - 1) * span + j], twi[(r - 1) * span + j]);
+            }
+            butterfly<P, Inverse>(ar, ai);
+            for (int k = 0; k < P; ++k) {
+                br[k * span + j] = ar[k];
+                bi[k * span + j] = ai[k];
+            }
+        }
+    }
+}
+
+template <bool Inverse, typename T, typename W>
+void dit_pass_generic(T* re, T* im, size_t span, int p, const CpuFftPlan& plan, const W* twr, const W* twi,
+                      size_t lo, size_t hi) {
+    const size_t block = span * p;
+    std::vector<std::complex<W>> a(p), tmp;
+    for (size_t t = lo; t < hi;) {
+        const size_t base = (t / span) * block, j0 = t % span, j1 = std::min(span, j0 + (hi - t));
+        t += j1 - j0;
+        for (size_t j = j0; j < j1; ++j) {
+            for (int r = 0; r < p; ++r) {
+                size_t idx = base + r * span + j;
+                W xr = static_cast<W>(re[idx]), xi = static_cast<W>(im[idx]);
+                if (r) {
+                    W tr = twr[(r - 1) * span + j], ti = twi[(r - 1) * span + j];
+                    a[r] = {xr * tr - xi * ti, xr * ti + xi * tr};
+                } else {
+                    a[r] = {xr, xi};
+                }
+            }
+            dft_generic(a.data(), p, plan, tmp);
+            for (int k = 0; k < p; ++k) {
+                re[base + k * span + j] = static_cast<T>(a[k].real());
+                im[base + k * span + j] = static_cast<T>(a[k].imag());
+            }
+        }
+    }
+}
+
+// Passes with fewer butterflies run on the calling thread; splitting them
+// costs more in fork-join handoffs than the pass takes. A larger pass goes
+// through dash::parallel_for (scheduler_binding.hpp) in chunks of at least
+// this many.
+constexpr size_t kParallelButterflies = size_t{1} << 13;
+
+template <typename Pass>
+void run_butterflies(size_t count, const Pass& pass) {
+    if (count < 2 * kParallelButterflies) pass(0, count);
+    else parallel_for(0, count, kParallelButterflies, pass);
+}
+
+// Runs the plan's passes over split data in work[0, 2n), already gathered
+// into digit-reversed order for the in-place layout. Returns the real part
+// of the result; the imaginary part follows at +n. work holds 4n values.
+template <bool Inverse, typename T, typename W>
+T* run_passes(const CpuFftPlan& plan, T* work) {
+    const size_t n = plan.n;
+    T* ar = work;
+    T* ai = ar + n;
+    if (plan.in_place) {
+        size_t span = 1;
+        for (size_t pass = 0; pass < plan.radices.size(); ++pass) {
+            int p = plan.radices[pass];
+            const W* twr = plan.tw_re<W>(pass);
+            const W* twi = plan.tw_im<W>(pass);
+            run_butterflies(n / static_cast<size_t>(p), [&](size_t lo, size_t hi) {
+                switch (p) {
+                case 2: dit_pass<2, Inverse>(ar, ai, span, twr, twi, lo, hi); break;
+                case 3: dit_pass<3, Inverse>(ar, ai, span, twr, twi, lo, hi); break;
+                case 4: dit_pass<4, Inverse>(ar, ai, span, twr, twi, lo, hi); break;
+                case 5: dit_pass<5, Inverse>(ar, ai, span, twr, twi, lo, hi); break;
+                case 8: dit_pass<8, Inverse>(ar, ai, span, twr, twi, lo, hi); break;
+                default: dit_pass_generic<Inverse>(ar, ai, span, p, plan, twr, twi, lo, hi); break;
+                }
+            });
+            span *= static_cast<size_t>(p);
+        }
+        return ar;
+    }
+    T* xr = ar;
+    T* xi = ai;
+    T* yr = ai + n;
+    T* yi = yr + n;
+    size_t len = n, stride = 1;
+    for (size_t pass = 0; pass < plan.radices.size(); ++pass) {
+        int p = plan.radices[pass];
+        const W* twr = plan.tw_re<W>(pass);
+        const W* twi = plan.tw_im<W>(pass);
+        run_butterflies(n / static_cast<size_t>(p), [&](size_t lo, size_t hi) {
+            switch (p) {
+            case 2: stockham_pass<2, Inverse>(xr, xi, yr, yi, len, stride, twr, twi, lo, hi); break;
+            case 3: stockham_pass<3, Inverse>(xr, xi, yr, yi, len, stride, twr, twi, lo, hi); break;
+            case 4: stockham_pass<4, Inverse>(xr, xi, yr, yi, len, stride, twr, twi, lo, hi); break;
+            case 5: stockham_pass<5, Inverse>(xr, xi, yr, yi, len, stride, twr, twi, lo, hi); break;
+            case 8: stockham_pass<8, Inverse>(xr, xi, yr, yi, len, stride, twr, twi, lo, hi); break;
+            default: stockham_pass_generic<Inverse>(xr, xi, yr, yi, len, stride, p, plan, twr, twi, lo, hi); break;
+            }
+        });
+        std::swap(xr, yr);
+        std::swap(xi, yi);
+        len /= static_cast<size_t>(p);
+        stride *= static_cast<size_t>(p);
+    }
+    return xr;
+}
+
+bool valid_algorithm(size_t n, const FftAlgorithm& algo) {
+    if (n == 0) return false;
+    if (algo.fixed) return fft_fixed_kernel(static_cast<int>(n)) != nullptr;
+    // The convolution needs m >= 2n - 1; anything past 4n is never worth it.
+    const size_t limit = algo.bluestein ? 4 * n : n;
+    size_t product = 1;
+    for (int r : algo.radices) {
+        if (r < 2) return false;
+        product *= static_cast<size_t>(r);
+        if (product > limit) return false;
+    }
+    if (algo.bluestein) return n > 1 && product >= 2 * n - 1;
+    return product == n || (n == 1 && algo.radices.empty());
+}
+
+std::shared_ptr<const CpuFftPlan> build_plan(size_t n, bool inverse, FftPrecision precision, const FftAlgorithm& algo);
+
+// Chirp w_k = W_2n^(k^2) and the spectrum of the circular kernel conj(w_|k|),
+// scaled by 1/m so the convolution needs no separate normalisation. k^2 is
+// reduced mod 2n in integers first; the angle would lose bits at large k.
+void bluestein_tables(size_t n, size_t m, double sign, const std::vector<int>& inner_radices,
+                      std::vector<double>& re, std::vector<double>& im) {
+    std::vector<double> wr(n), wi(n);
+    for (size_t k = 0; k < n; ++k) {
+        double angle = sign * M_PI * static_cast<double>((k * k) % (2 * n)) / static_cast<double>(n);
+        wr[k] = std::cos(angle);
+        wi[k] = std::sin(angle);
+    }
+    FftAlgorithm stockham;
+    stockham.radices = inner_radices;
+    auto fwd = build_plan(m, false, FftPrecision::Fp64, stockham);
+    std::vector<double> work(4 * m, 0.0);
+    for (size_t k = 0; k < n; ++k) {
+        work[k] = wr[k];
+        work[m + k] = -wi[k];
+        if (k) {
+            work[m - k] = wr[k];
+            work[2 * m - k] = -wi[k];
+        }
+    }
+    const double* br = run_passes<false, double, double>(*fwd, work.data());
+    const double* bi = br + m;
+    re.assign(wr.begin(), wr.end());
+    im.assign(wi.begin(), wi.end());
+    for (size_t k = 0; k < m; ++k) {
+        re.push_back(br[k] / static_cast<double>(m));
+        im.push_back(bi[k] / static_cast<double>(m));
+    }
+}
+
+std::shared_ptr<const CpuFftPlan> build_plan(size_t n, bool inverse, FftPrecision precision, const FftAlgorithm& algo) {
+    auto plan = std::make_shared<CpuFftPlan>();
+    plan->n = n;
+    plan->inverse = inverse;
+    plan->precision = precision;
+    plan->radices = algo.radices;
+    plan->in_place = algo.in_place && !algo.bluestein;
+    const double sign = inverse ? 1.0 : -1.0;
+    std::vector<double> re, im;
+    if (algo.bluestein) {
+        size_t m = 1;
+        for (int p : algo.radices) m *= static_cast<size_t>(p);
+        FftAlgorithm stockham;
+        stockham.radices = algo.radices;
+        plan->radices.clear();
+        plan->inner = build_plan(m, false, precision, stockham);
+        bluestein_tables(n, m, sign, algo.radices, re, im);
+        plan->tw_offset = {0, n};
+    }
+    bool generic = std::any_of(algo.radices.begin(), algo.radices.end(),
+                               [](int p) { return p != 2 && p != 3 && p != 4 && p != 5 && p != 8; });
+    if (generic && !algo.bluestein) {
+        plan->master.resize(n);
+        for (size_t j = 0; j < n; ++j) {
+            double angle = sign * 2.0 * M_PI * static_cast<double>(j) / static_cast<double>(n);
+            plan->master[j] = cd(std::cos(angle), std::sin(angle));
+        }
+    }
+
+    // Twiddles are always computed in double and rounded once for fp32.
+    auto add = [&](size_t num, size_t den) {
+        double angle = sign * 2.0 * M_PI * static_cast<double>(num % den) / static_cast<double>(den);
+        re.push_back(std::cos(angle));
+        im.push_back(std::sin(angle));
+    };
+    size_t len = n, span = 1;
+    for (int p : plan->radices) {
+        size_t P = static_cast<size_t>(p);
+        plan->tw_offset.push_back(re.size());
+        if (plan->in_place) {
+            // W_block^(r*j), laid out [r - 1][j].
+            for (size_t r = 1; r < P; ++r) {
+                for (size_t j = 0; j < span; ++j) add(r * j, span * P);
+            }
+            span *= P;
+        } else {
+            // W_len^(pp*k), laid out [pp][k - 1].
+            for (size_t pp = 0; pp < len / P; ++pp) {
+                for (size_t k = 1; k < P; ++k) add(pp * k, len);
+            }
+            len /= P;
+        }
+    }
+    if (precision == FftPrecision::Fp32) {
+        plan->tw32_re.assign(re.begin(), re.end());
+        plan->tw32_im.assign(im.begin(), im.end());
+    } else {
+        plan->tw64_re.assign(re.begin(), re.end());
+        plan->tw64_im.assign(im.begin(), im.end());
+    }
+
+    if (plan->in_place) {
+        // Position digits run innermost-radix first; the source index reverses them.
+        plan->perm.resize(n);
+        for (size_t i = 0; i < n; ++i) {
+            size_t rem = i, src = 0, place = n;
+            for (int p : algo.radices) {
+                place /= static_cast<size_t>(p);
+                src += (rem % static_cast<size_t>(p)) * place;
+                rem /= static_cast<size_t>(p);
+            }
+            plan->perm[i] = static_cast<uint32_t>(src);
+        }
+    }
+    return plan;
+}
+
+std::shared_ptr<const CpuFftPlan> acquire_plan(size_t n, bool inverse, FftPrecision precision, const FftAlgorithm& algo) {
+    static schedrt::InstrumentedMutex g_mu{"dash::fft_plan_cache"};
+    static std::map<std::string, std::shared_ptr<const CpuFftPlan>> g_plans;
+    std::string key = std::to_string(n) + (inverse ? "i" : "f") + to_string(precision) + to_string(algo);
+    std::lock_guard<schedrt::InstrumentedMutex> lk(g_mu);
+    auto it = g_plans.find(key);
+    if (it != g_plans.end()) return it->second;
+    auto plan = build_plan(n, inverse, precision, algo);
+    g_plans.emplace(key, plan);
+    return plan;
+}
+
+template <bool Inverse, typename T, typename W>
+void run_plan_typed(const CpuFftPlan& plan, const float* in, float* out) {
+    thread_local host_vector<T> work;
+    const size_t n = plan.n;
+    work.resize(4 * n);
+    T* ar = work.data();
+    T* ai = ar + n;
+    for (size_t i = 0; i < n; ++i) {
+        size_t src = plan.in_place ? plan.perm[i] : i;
+        ar[i] = static_cast<T>(in[2 * src]);
+        ai[i] = static_cast<T>(in[2 * src + 1]);
+    }
+    T* rr = run_passes<Inverse, T, W>(plan, work.data());
+    T* ri = rr + n;
+
+    const W scale = Inverse ? W(1) / static_cast<W>(n) : W(1);
+    for (size_t i = 0; i < n; ++i) {
+        out[2 * i] = static_cast<float>(static_cast<W>(rr[i]) * scale);
+        out[2 * i + 1] = static_cast<float>(static_cast<W>(ri[i]) * scale);
+    }
+}
+
+// Chirp-z: X_k = w_k * sum_j (x_j * w_j) * conj(w_(k-j)) with w_k = W_2n^(k^2),
+// a circular convolution done with two forward m-point transforms. The
+// second one inverts because the spectrum product is conjugated first.
+template <bool Inverse, typename T, typename W>
+void run_bluestein(const CpuFftPlan& plan, const float* in, float* out) {
+    thread_local host_vector<T> work;
+    const CpuFftPlan& inner = *plan.inner;
+    const size_t n = plan.n, m = inner.n;
+    work.resize(4 * m);
+    T* ar = work.data();
+    T* ai = ar + m;
+    const W* cr = plan.tw_re<W>(0);
+    const W* ci = plan.tw_im<W>(0);
+    for (size_t k = 0; k < n; ++k) {
+        W xr = static_cast<W>(in[2 * k]), xi = static_cast<W>(in[2 * k + 1]);
+        ar[k] = static_cast<T>(xr * cr[k] - xi * ci[k]);
+        ai[k] = static_cast<T>(xr * ci[k] + xi * cr[k]);
+    }
+    std::fill(ar + n, ar + m, T(0));
+    std::fill(ai + n, ai + m, T(0));
+
+    T* yr = run_passes<false, T, W>(inner, work.data());
+    T* yi = yr + m;
+    const W* br = plan.tw_re<W>(1);
+    const W* bi = plan.tw_im<W>(1);
+    for (size_t k = 0; k < m; ++k) {
+        W r = static_cast<W>(yr[k]), i = static_cast<W>(yi[k]);
+        ar[k] = static_cast<T>(r * br[k] - i * bi[k]);
+        ai[k] = static_cast<T>(-(r * bi[k] + i * br[k]));
+    }
+
+    T* zr = run_passes<false, T, W>(inner, work.data());
+    T* zi = zr + m;
+    const W scale = Inverse ? W(1) / static_cast<W>(n) : W(1);
+    for (size_t k = 0; k < n; ++k) {
+        W r = static_cast<W>(zr[k]), i = -static_cast<W>(zi[k]);
+        out[2 * k] = static_cast<float>((r * cr[k] - i * ci[k]) * scale);
+        out[2 * k + 1] = static_cast<float>((r * ci[k] + i * cr[k]) * scale);
+    }
+}
+
+template <typename T, typename W>
+void run_plan_as(const CpuFftPlan& plan, const float* in, float* out) {
+    if (plan.inner) {
+        if (plan.inverse) run_bluestein<true, T, W>(plan, in, out);
+        else run_bluestein<false, T, W>(plan, in, out);
+    } else if (plan.inverse) {
+        run_plan_typed<true, T, W>(plan, in, out);
+    } else {
+        run_plan_typed<false, T, W>(plan, in, out);
+    }
+}
+
+void run_plan(const CpuFftPlan& plan, const float* in, float* out) {
+    switch (plan.precision) {
+    case FftPrecision::Fp32: run_plan_as<float, float>(plan, in, out); break;
+    case FftPrecision::Mixed: run_plan_as<float, double>(plan, in, out); break;
+    case FftPrecision::Fp64: run_plan_as<double, double>(plan, in, out); break;
+    }
+}
+
+std::vector<int> prime_factors(int n) {
+    std::vector<int> out;
+    for (int p = 2; p * p <= n; ++p) {
+        while (n % p == 0) {
+            out.push_back(p);
+            n /= p;
+        }
+    }
+    if (n > 1) out.push_back(n);
+    return out;
+}
+
+// Power-of-two part of the decomposition, built from the largest radix allowed.
+std::vector<int> pow2_radices(int log2n, int max_radix, bool split_tail) {
+    std::vector<int> out;
+    int bits_per = max_radix == 8 ? 3 : (max_radix == 4 ? 2 : 1);
+    int full = log2n / bits_per;
+    int rem = log2n % bits_per;
+    if (split_tail && bits_per == 3 && rem == 1 && full > 0) {
+        // 8..8x2 -> 8..4x4 keeps every pass at radix >= 4
+        --full;
+        out.assign(full, 8);
+        out.push_back(4);
+        out.push_back(4);
+        return out;
+    }
+    out.assign(full, max_radix);
+    if (rem) out.push_back(1 << rem);
+    return out;
+}
+
+// Default decomposition for sorted prime factors: radix-4 passes (which suit
+// the split layout, see fft_fixed.cpp) and then the odd factors.
+std::vector<int> mixed_radices(const std::vector<int>& factors) {
+    int log2n = static_cast<int>(std::count(factors.begin(), factors.end(), 2));
+    std::vector<int> out = pow2_radices(log2n, 4, false);
+    out.insert(out.end(), factors.begin() + log2n, factors.end());
+    return out;
+}
+
+// Largest prime factor the mixed-radix engine takes directly. Its generic
+// pass costs O(p) per point; a chirp-z transform over about 2n points
+// already wins at p = 17 on x86-64, for bare primes and for 64 * p alike.
+constexpr int kMaxDirectPrime = 13;
+
+} // namespace
+
+std::string to_string(const FftAlgorithm& algo) {
+    std::string out = algo.fixed ? "fixed:" : algo.bluestein ? "bluestein:" : (algo.in_place ? "inplace:" : "stockham:");
+    for (size_t i = 0; i < algo.radices.size(); ++i) {
+        if (i) out += 'x';
+        out += std::to_string(algo.radices[i]);
+    }
+    return out;
+}
+
+const char* to_string(FftPrecision precision) {
+    switch (precision) {
+    case FftPrecision::Fp32: return "fp32";
+    case FftPrecision::Mixed: return "mixed";
+    case FftPrecision::Fp64: return "fp64";
+    }
+    return "fp32";
+}
+
+bool parse_fft_precision(const std::string& text, FftPrecision& out) {
+    if (text == "fp32") out = FftPrecision::Fp32;
+    else if (text == "mixed") out = FftPrecision::Mixed;
+    else if (text == "fp64") out = FftPrecision::Fp64;
+    else return false;
+    return true;
+}
+
+bool parse_fft_algorithm(const std::string& text, FftAlgorithm& out) {
+    auto colon = text.find(':');
+    if (colon == std::string::npos) return false;
+    std::string layout = text.substr(0, colon);
+    FftAlgorithm algo;
+    if (layout == "inplace") algo.in_place = true;
+    else if (layout == "fixed") algo.fixed = true;
+    else if (layout == "bluestein") algo.bluestein = true;
+    else if (layout != "stockham") return false;
+    std::istringstream iss(text.substr(colon + 1));
+    std::string part;
+    while (std::getline(iss, part, 'x')) {
+        try {
+            int r = std::stoi(part);
+            if (r < 2) return false;
+            algo.radices.push_back(r);
+        } catch (...) {
+            return false;
+        }
+    }
+    out = std::move(algo);
+    return true;
+}
+
+std::vector<FftAlgorithm> fft_candidate_algorithms(int n) {
+    std::vector<FftAlgorithm> out;
+    if (n < 1) return out;
+    if (const auto* fixed = fft_fixed_kernel(n)) out.push_back({fixed->radices, false, true});
+    auto factors = prime_factors(n);
+    int log2n = static_cast<int>(std::count(factors.begin(), factors.end(), 2));
+    std::vector<int> odd(factors.begin() + log2n, factors.end());
+    if (!odd.empty() && odd.back() > kMaxDirectPrime) {
+        // Large primes: a direct pass would be O(n^2), so only chirp-z over
+        // the next 5-smooth and power-of-two lengths.
+        int m = fft_fast_size(2 * n - 1);
+        int m2 = 1;
+        while (m2 < 2 * n - 1) m2 *= 2;
+        out.push_back({mixed_radices(prime_factors(m)), false, false, true});
+        if (m2 != m) out.push_back({mixed_radices(prime_factors(m2)), false, false, true});
+        return out;
+    }
+
+    std::vector<std::vector<int>> orders;
+    auto add_order = [&](std::vector<int> radices) {
+        radices.insert(radices.end(), odd.begin(), odd.end());
+        if (std::find(orders.begin(), orders.end(), radices) == orders.end()) orders.push_back(radices);
+        std::reverse(radices.begin(), radices.end());
+        if (std::find(orders.begin(), orders.end(), radices) == orders.end()) orders.push_back(radices);
+    };
+    add_order(pow2_radices(log2n, 2, false));
+    add_order(pow2_radices(log2n, 4, false));
+    add_order(pow2_radices(log2n, 8, false));
+    add_order(pow2_radices(log2n, 8, true));
+
+    for (const auto& radices : orders) {
+        out.push_back({radices, false});
+        out.push_back({radices, true});
+    }
+    return out;
+}
+
+FftAlgorithm fft_default_algorithm(int n) {
+    FftAlgorithm algo;
+    if (n < 1) return algo;
+    if (const auto* fixed = fft_fixed_kernel(n)) return {fixed->radices, false, true};
+    auto factors = prime_factors(n);
+    if (!factors.empty() && factors.back() > kMaxDirectPrime) {
+        // Radix-4 passes beat 3/5 ones, so the 5-smooth m has to be clearly shorter.
+        int m = 1;
+        while (m < 2 * n - 1) m *= 2;
+        int smooth = fft_fast_size(2 * n - 1);
+        if (4 * static_cast<long long>(smooth) < 3 * static_cast<long long>(m)) m = smooth;
+        algo.radices = mixed_radices(prime_factors(m));
+        algo.bluestein = true;
+        return algo;
+    }
+    algo.radices = mixed_radices(factors);
+    return algo;
+}
+
+int fft_fast_size(int n) {
+    if (n <= 1) return 1;
+    int best = INT_MAX;
+    for (long long p5 = 1; p5 < best; p5 *= 5) {
+        for (long long p35 = p5; p35 < best; p35 *= 3) {
+            long long v = p35;
+            while (v < n) v *= 2;
+            if (v < best) best = static_cast<int>(v);
+        }
+    }
+    return best;
+}
+
+bool fft_cpu_execute(const FftPlan& plan, const FftAlgorithm& algo, const float* in, float* out) {
+    if (plan.n <= 0 || !in || !out) return false;
+    size_t n = static_cast<size_t>(plan.n);
+    if (!valid_algorithm(n, algo)) return false;
+    if (algo.fixed) {
+        fft_fixed_kernel(plan.n)->kernel(plan.precision, plan.inverse)(in, out);
+        return true;
+    }
+    auto cpu_plan = acquire_plan(n, plan.inverse, plan.precision, algo);
+    run_plan(*cpu_plan, in, out);
+    return true;
+}
+
+bool fft_cpu_execute(const FftPlan& plan, const float* in, float* out) {
+    if (plan.n <= 0) return false;
+    if (fft_cpu_execute(plan, fft_select_algorithm(plan), in, out)) return true;
+    // Wisdom written by a build with different fixed kernels can name one we lack.
+    return fft_cpu_execute(plan, fft_default_algorithm(plan.n), in, out);
+}
+
+bool fft_cpu_execute_batch(const FftPlan& plan, size_t count, const float* const* in, float* const* out) {
+    if (plan.n <= 0) return false;
+    for (size_t i = 0; i < count; ++i) {
+        if (!in[i] || !out[i]) return false;
+    }
+    size_t n = static_cast<size_t>(plan.n);
+    FftAlgorithm algo = fft_select_algorithm(plan);
+    if (!valid_algorithm(n, algo)) algo = fft_default_algorithm(plan.n);
+    if (!valid_algorithm(n, algo)) return false;
+    if (algo.fixed) {
+        auto fn = fft_fixed_kernel(plan.n)->kernel(plan.precision, plan.inverse);
+        for (size_t i = 0; i < count; ++i) fn(in[i], out[i]);
+        return true;
+    }
+    auto cpu_plan = acquire_plan(n, plan.inverse, plan.precision, algo);
+    for (size_t i = 0; i < count; ++i) run_plan(*cpu_plan, in[i], out[i]);
+    return true;
+}
+
+} // namespace dash
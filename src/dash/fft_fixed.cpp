@@ -0,0 +1,314 @@
+#include "dash/fft_fixed.hpp"
+#include "dash/host_buffer.hpp"
+
+#include <array>
+#include <cstddef>
+#include <type_traits>
+
+namespace dash {
+namespace {
+
+struct Twiddle {
+    double re;
+    double im;
+};
+
+// ---- constexpr trigonometry ----
+// std::sin/cos are not constexpr, so tables are built from Taylor series on
+// [0, pi/4]; 12 terms is below double rounding there.
+constexpr double kPi = 3.14159265358979323846;
+
+constexpr double sin_poly(double x) {
+    double x2 = x * x, term = x, sum = x;
+    for (int k = 1; k < 12; ++k) {
+        term *= -x2 / static_cast<double>((2 * k) * (2 * k + 1));
+        sum += term;
+    }
+    return sum;
+}
+
+constexpr double cos_poly(double x) {
+    double x2 = x * x, term = 1.0, sum = 1.0;
+    for (int k = 1; k < 12; ++k) {
+        term *= -x2 / static_cast<double>((2 * k - 1) * (2 * k));
+        sum += term;
+    }
+    return sum;
+}
+
+// Forward W_N^j for power-of-two N >= 8. The angle is reduced to the first
+// octant in integers, so the series never sees more than pi/4.
+template <size_t N>
+constexpr Twiddle twiddle(size_t j) {
+    constexpr size_t quarter = N / 4;
+    j %= N;
+    size_t quad = j / quarter, r = j % quarter;
+    double c = 0, s = 0;
+    if (2 * r <= quarter) {
+        double a = 2.0 * kPi * static_cast<double>(r) / static_cast<double>(N);
+        c = cos_poly(a);
+        s = sin_poly(a);
+    } else {
+        double b = 2.0 * kPi * static_cast<double>(quarter - r) / static_cast<double>(N);
+        c = sin_poly(b);
+        s = cos_poly(b);
+    }
+    double re = c, im = s;
+    if (quad == 1) { re = -s; im = c; }
+    else if (quad == 2) { re = -c; im = -s; }
+    else if (quad == 3) { re = s; im = -c; }
+    return {re, -im};
+}
+
+// ---- pass schedule ----
+constexpr int log2_of(size_t n) {
+    int bits = 0;
+    while (n > 1) {
+        n >>= 1;
+        ++bits;
+    }
+    return bits;
+}
+
+// Radix for the pass that shrinks `len`: radix-4 throughout, with one radix-8
+// first pass when the bit count is odd (2^16 -> 4^8, 2^9 -> 8x4x4x4). On split
+// re/im buffers a radix-8 pass walks 32 power-of-two-strided streams and
+// thrashes L1 sets; radix-4 measured 2-3x faster at 65536.
+constexpr int radix_for(size_t len) {
+    int bits = log2_of(len);
+    if (bits == 1) return 2;
+    if (bits == 2) return 4;
+    if (bits % 2 == 1) return 8;
+    return 4;
+}
+
+template <size_t N>
+constexpr size_t table_size() {
+    size_t total = 0;
+    for (size_t len = N; len > 1; len /= static_cast<size_t>(radix_for(len))) {
+        size_t p = static_cast<size_t>(radix_for(len));
+        total += (p - 1) * (len / p);
+    }
+    return total;
+}
+
+// Per-pass twiddles laid out in the order the Stockham passes consume them:
+// for each pass, W_len^(pp*k) for pp in [0, len/P), k in [1, P). Inverse
+// transforms use the conjugates, so one table serves both directions. The
+// float table is the double one rounded once.
+template <size_t N, typename W>
+struct Tables {
+    std::array<W, table_size<N>()> re{};
+    std::array<W, table_size<N>()> im{};
+
+    constexpr Tables() {
+        size_t off = 0;
+        for (size_t len = N; len > 1; len /= static_cast<size_t>(radix_for(len))) {
+            size_t p = static_cast<size_t>(radix_for(len));
+            size_t m = len / p, step = N / len;
+            for (size_t pp = 0; pp < m; ++pp) {
+                for (size_t k = 1; k < p; ++k) {
+                    Twiddle t = twiddle<N>(pp * k * step);
+                    re[off] = t.re;
+                    im[off] = t.im;
+                    ++off;
+                }
+            }
+        }
+    }
+};
+
+template <size_t N>
+struct Tables32 {
+    std::array<float, table_size<N>()> re{};
+    std::array<float, table_size<N>()> im{};
+
+    constexpr explicit Tables32(const Tables<N, double>& wide) {
+        for (size_t i = 0; i < re.size(); ++i) {
+            re[i] = static_cast<float>(wide.re[i]);
+            im[i] = static_cast<float>(wide.im[i]);
+        }
+    }
+};
+
+template <size_t N>
+inline constexpr Tables<N, double> kTables64{};
+template <size_t N>
+inline constexpr Tables32<N> kTables32{kTables64<N>};
+
+template <size_t N, typename W>
+constexpr const auto& tables() {
+    if constexpr (std::is_same_v<W, double>) return kTables64<N>;
+    else return kTables32<N>;
+}
+
+// ---- unrolled butterflies on split re/im ----
+template <typename T, typename W>
+inline void apply_twiddle(T& re, T& im, W wr, W wi) {
+    W r = static_cast<W>(re), i = static_cast<W>(im);
+    re = static_cast<T>(r * wr - i * wi);
+    im = static_cast<T>(r * wi + i * wr);
+}
+
+template <bool Inverse, typename T>
+inline void rot4(T& re, T& im) {
+    T r = re;
+    if constexpr (Inverse) {
+        re = -im;
+        im = r;
+    } else {
+        re = im;
+        im = -r;
+    }
+}
+
+template <bool Inverse, typename T>
+inline void rot8(T& re, T& im) {
+    constexpr T h = static_cast<T>(0.70710678118654752440);
+    T r = re;
+    if constexpr (Inverse) {
+        re = h * (r - im);
+        im = h * (r + im);
+    } else {
+        re = h * (r + im);
+        im = h * (im - r);
+    }
+}
+
+template <int P, bool Inverse, typename T>
+inline void butterfly(T* re, T* im) {
+    if constexpr (P == 2) {
+        T tr = re[0], ti = im[0];
+        re[0] = tr + re[1];
+        im[0] = ti + im[1];
+        re[1] = tr - re[1];
+        im[1] = ti - im[1];
+    } else if constexpr (P == 4) {
+        T s02r = re[0] + re[2], s02i = im[0] + im[2];
+        T d02r = re[0] - re[2], d02i = im[0] - im[2];
+        T s13r = re[1] + re[3], s13i = im[1] + im[3];
+        T d13r = re[1] - re[3], d13i = im[1] - im[3];
+        rot4<Inverse>(d13r, d13i);
+        re[0] = s02r + s13r; im[0] = s02i + s13i;
+        re[1] = d02r + d13r; im[1] = d02i + d13i;
+        re[2] = s02r - s13r; im[2] = s02i - s13i;
+        re[3] = d02r - d13r; im[3] = d02i - d13i;
+    } else {
+        static_assert(P == 8, "fixed kernels use radix 2/4/8");
+        T er[4] = {re[0], re[2], re[4], re[6]}, ei[4] = {im[0], im[2], im[4], im[6]};
+        T orr[4] = {re[1], re[3], re[5], re[7]}, oi[4] = {im[1], im[3], im[5], im[7]};
+        butterfly<4, Inverse>(er, ei);
+        butterfly<4, Inverse>(orr, oi);
+        rot8<Inverse>(orr[1], oi[1]);
+        rot4<Inverse>(orr[2], oi[2]);
+        rot8<Inverse>(orr[3], oi[3]);
+        rot4<Inverse>(orr[3], oi[3]);
+        for (int k = 0; k < 4; ++k) {
+            re[k] = er[k] + orr[k]; im[k] = ei[k] + oi[k];
+            re[k + 4] = er[k] - orr[k]; im[k + 4] = ei[k] - oi[k];
+        }
+    }
+}
+
+// Decimation-in-frequency Stockham passes with every bound a compile-time
+// constant; same indexing as stockham_pass in fft_cpu.cpp. Each buffer holds
+// N real parts followed by N imaginary parts. Returns the one holding the
+// result.
+template <size_t N, bool Inverse, typename T, typename W, size_t Len, size_t Stride, size_t Off>
+T* passes(T* x, T* y) {
+    if constexpr (Len == 1) {
+        (void)y;
+        return x;
+    } else {
+        constexpr int P = radix_for(Len);
+        constexpr size_t m = Len / P;
+        const auto& tab = tables<N, W>();
+        const T* __restrict xr = x;
+        const T* __restrict xi = x + N;
+        T* __restrict yr = y;
+        T* __restrict yi = y + N;
+        for (size_t pp = 0; pp < m; ++pp) {
+            W wr[P], wi[P];
+            for (int k = 1; k < P; ++k) {
+                wr[k] = tab.re[Off + pp * (P - 1) + k - 1];
+                wi[k] = Inverse ? -tab.im[Off + pp * (P - 1) + k - 1] : tab.im[Off + pp * (P - 1) + k - 1];
+            }
+            for (size_t q = 0; q < Stride; ++q) {
+                T ar[P], ai[P];
+                for (int r = 0; r < P; ++r) {
+                    ar[r] = xr[q + Stride * (pp + r * m)];
+                    ai[r] = xi[q + Stride * (pp + r * m)];
+                }
+                butterfly<P, Inverse>(ar, ai);
+                yr[q + Stride * (P * pp)] = ar[0];
+                yi[q + Stride * (P * pp)] = ai[0];
+                for (int k = 1; k < P; ++k) {
+                    apply_twiddle(ar[k], ai[k], wr[k], wi[k]);
+                    yr[q + Stride * (P * pp + k)] = ar[k];
+                    yi[q + Stride * (P * pp + k)] = ai[k];
+                }
+            }
+        }
+        return passes<N, Inverse, T, W, m, Stride * P, Off + (P - 1) * m>(y, x);
+    }
+}
+
+template <size_t N, bool Inverse, typename T, typename W>
+void run_fixed(const float* in, float* out) {
+    thread_local host_vector<T> work_a(2 * N);
+    thread_local host_vector<T> work_b(2 * N);
+    T* a = work_a.data();
+    for (size_t i = 0; i < N; ++i) {
+        a[i] = static_cast<T>(in[2 * i]);
+        a[N + i] = static_cast<T>(in[2 * i + 1]);
+    }
+    const T* result = passes<N, Inverse, T, W, N, 1, 0>(a, work_b.data());
+    constexpr W scale = Inverse ? W(1) / static_cast<W>(N) : W(1);
+    for (size_t i = 0; i < N; ++i) {
+        out[2 * i] = static_cast<float>(static_cast<W>(result[i]) * scale);
+        out[2 * i + 1] = static_cast<float>(static_cast<W>(result[N + i]) * scale);
+    }
+}
+
+template <size_t N, typename T, typename W>
+std::array<FixedFftKernel, 2> kernel_pair() {
+    return {&run_fixed<N, false, T, W>, &run_fixed<N, true, T, W>};
+}
+
+template <size_t N>
+FixedFftEntry make_entry() {
+    static_assert(N >= 8 && (N & (N - 1)) == 0, "fixed kernels need a power-of-two size >= 8");
+    std::vector<int> radices;
+    for (size_t len = N; len > 1; len /= static_cast<size_t>(radix_for(len))) radices.push_back(radix_for(len));
+    FixedFftEntry entry{static_cast<int>(N), std::move(radices), {}};
+    entry.kernels[static_cast<size_t>(FftPrecision::Fp32)] = kernel_pair<N, float, float>();
+    entry.kernels[static_cast<size_t>(FftPrecision::Mixed)] = kernel_pair<N, float, double>();
+    entry.kernels[static_cast<size_t>(FftPrecision::Fp64)] = kernel_pair<N, double, double>();
+    return entry;
+}
+
+// Add a size here to give it a specialised kernel.
+const std::vector<FixedFftEntry>& registry() {
+    static const std::vector<FixedFftEntry> entries = {
+        make_entry<512>(),    // SAR range rows
+        make_entry<65536>(),  // radar correlator
+    };
+    return entries;
+}
+
+} // namespace
+
+const FixedFftEntry* fft_fixed_kernel(int n) {
+    for (const auto& e : registry()) {
+        if (e.n == n) return &e;
+    }
+    return nullptr;
+}
+
+std::vector<int> fft_fixed_sizes() {
+    std::vector<int> out;
+    for (const auto& e : registry()) out.push_back(e.n);
+    return out;
+}
+
+} // namespace dash
@@ -0,0 +1,174 @@
+#include "dash/fft_wisdom.hpp"
+#include "schedrt/instrumented_mutex.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <mutex>
+#include <set>
+#include <sstream>
+#include <tuple>
+#include <vector>
+
+namespace dash {
+namespace {
+
+// Each precision runs different kernels, so each is tuned separately.
+using WisdomKey = std::tuple<int, bool, std::string>;
+
+WisdomKey key_for(const FftPlan& plan) {
+    return {plan.n, plan.inverse, to_string(plan.precision)};
+}
+
+schedrt::InstrumentedMutex g_mu{"dash::fft_wisdom"};
+std::map<WisdomKey, FftAlgorithm> g_wisdom;
+std::set<WisdomKey> g_tuning;
+std::string g_path;
+std::atomic<bool> g_autotune{false};
+
+bool save_locked(const std::string& path) {
+    std::ofstream ofs(path, std::ios::trunc);
+    if (!ofs) return false;
+    ofs << "# schedrt fft wisdom v1\n";
+    ofs << "# n direction precision algorithm\n";
+    for (const auto& [key, algo] : g_wisdom) {
+        ofs << std::get<0>(key) << " " << (std::get<1>(key) ? "inverse" : "forward") << " "
+            << std::get<2>(key) << " " << to_string(algo) << "\n";
+    }
+    return ofs.good();
+}
+
+// Best-of-N wall time for one candidate, in nanoseconds.
+double benchmark(const FftPlan& plan, const FftAlgorithm& algo,
+                 const std::vector<float>& in, std::vector<float>& out) {
+    using clock = std::chrono::steady_clock;
+    if (!fft_cpu_execute(plan, algo, in.data(), out.data())) return -1.0;  // warm plan + caches
+    constexpr auto kBudget = std::chrono::milliseconds(20);
+    constexpr int kMinReps = 3;
+    double best = 0.0;
+    auto start = clock::now();
+    for (int rep = 0; rep < kMinReps || clock::now() - start < kBudget; ++rep) {
+        auto t0 = clock::now();
+        fft_cpu_execute(plan, algo, in.data(), out.data());
+        double ns = std::chrono::duration<double, std::nano>(clock::now() - t0).count();
+        if (rep == 0 || ns < best) best = ns;
+        if (rep >= 1000) break;
+    }
+    return best;
+}
+
+} // namespace
+
+bool fft_wisdom_load(const std::string& path) {
+    std::ifstream ifs(path);
+    if (!ifs) return false;
+    std::map<WisdomKey, FftAlgorithm> loaded;
+    std::string line;
+    while (std::getline(ifs, line)) {
+        auto hash = line.find('#');
+        if (hash != std::string::npos) line.erase(hash);
+        std::istringstream iss(line);
+        int n = 0;
+        std::string dir, precision, algo_text;
+        if (!(iss >> n >> dir >> precision >> algo_text)) continue;
+        if (n <= 0 || (dir != "forward" && dir != "inverse")) continue;
+        FftAlgorithm algo;
+        if (!parse_fft_algorithm(algo_text, algo)) continue;
+        loaded[{n, dir == "inverse", precision}] = algo;
+    }
+    std::lock_guard<schedrt::InstrumentedMutex> lk(g_mu);
+    for (auto& [key, algo] : loaded) g_wisdom[key] = algo;
+    return true;
+}
+
+bool fft_wisdom_save(const std::string& path) {
+    std::lock_guard<schedrt::InstrumentedMutex> lk(g_mu);
+    return save_locked(path);
+}
+
+void fft_wisdom_set_path(const std::string& path) {
+    std::lock_guard<schedrt::InstrumentedMutex> lk(g_mu);
+    g_path = path;
+}
+
+std::string fft_wisdom_path() {
+    std::lock_guard<schedrt::InstrumentedMutex> lk(g_mu);
+    return g_path;
+}
+
+void fft_wisdom_set_autotune(bool enabled) {
+    g_autotune.store(enabled, std::memory_order_relaxed);
+}
+
+bool fft_wisdom_autotune_enabled() {
+    return g_autotune.load(std::memory_order_relaxed);
+}
+
+std::optional<FftAlgorithm> fft_wisdom_lookup(const FftPlan& plan) {
+    std::lock_guard<schedrt::InstrumentedMutex> lk(g_mu);
+    auto it = g_wisdom.find(key_for(plan));
+    if (it == g_wisdom.end()) return std::nullopt;
+    return it->second;
+}
+
+void fft_wisdom_record(const FftPlan& plan, const FftAlgorithm& algo) {
+    std::lock_guard<schedrt::InstrumentedMutex> lk(g_mu);
+    g_wisdom[key_for(plan)] = algo;
+    if (!g_path.empty()) save_locked(g_path);
+}
+
+FftAlgorithm fft_autotune(const FftPlan& plan, std::ostream* log) {
+    auto candidates = fft_candidate_algorithms(plan.n);
+    if (candidates.empty()) return fft_default_algorithm(plan.n);
+
+    std::vector<float> in(static_cast<size_t>(plan.n) * 2);
+    std::vector<float> out(in.size());
+    for (size_t i = 0; i < in.size(); ++i) in[i] = static_cast<float>(std::sin(0.37 * static_cast<double>(i)));
+
+    const FftAlgorithm* best = nullptr;
+    double best_ns = 0.0;
+    for (const auto& algo : candidates) {
+        double ns = benchmark(plan, algo, in, out);
+        if (ns < 0) continue;
+        if (log) {
+            *log << "[fft-tune] n=" << plan.n << (plan.inverse ? " inverse " : " forward ")
+                 << to_string(plan.precision) << " " << std::left << std::setw(28) << to_string(algo) << std::right
+                 << std::fixed << std::setprecision(1) << ns / 1000.0 << " us\n"
+                 << std::defaultfloat;
+        }
+        if (!best || ns < best_ns) {
+            best = &algo;
+            best_ns = ns;
+        }
+    }
+    FftAlgorithm winner = best ? *best : fft_default_algorithm(plan.n);
+    if (log) {
+        *log << "[fft-tune] n=" << plan.n << (plan.inverse ? " inverse " : " forward ")
+             << to_string(plan.precision) << " winner " << to_string(winner) << "\n";
+    }
+    fft_wisdom_record(plan, winner);
+    return winner;
+}
+
+FftAlgorithm fft_select_algorithm(const FftPlan& plan) {
+    auto key = key_for(plan);
+    {
+        std::lock_guard<schedrt::InstrumentedMutex> lk(g_mu);
+        auto it = g_wisdom.find(key);
+        if (it != g_wisdom.end()) return it->second;
+        // Another caller is already tuning this size; don't stall behind it.
+        if (!fft_wisdom_autotune_enabled() || !g_tuning.insert(key).second) {
+            return fft_default_algorithm(plan.n);
+        }
+    }
+    auto winner = fft_autotune(plan);
+    std::lock_guard<schedrt::InstrumentedMutex> lk(g_mu);
+    g_tuning.erase(key);
+    return winner;
+}
+
+} // namespace dash
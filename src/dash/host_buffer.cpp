@@ -0,0 +1,242 @@
+#include "dash/host_buffer.hpp"
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include <sys/mman.h>
+
+namespace dash {
+namespace {
+
+constexpr size_t kSmallLimit = 64 * 1024;
+constexpr size_t kHeapAlign = 64;
+
+enum class Backing { Explicit, Thp };
+
+struct Mapping {
+    void* base;
+    size_t bytes;
+    Backing backing;
+};
+
+size_t detect_huge_page_size() {
+    std::ifstream ifs("/proc/meminfo");
+    std::string key;
+    size_t value = 0;
+    std::string unit;
+    while (ifs >> key >> value) {
+        std::getline(ifs, unit);
+        if (key == "Hugepagesize:") return value * 1024;
+    }
+    return 2 * 1024 * 1024;
+}
+
+size_t huge_page_size() {
+    static const size_t size = detect_huge_page_size();
+    return size;
+}
+
+bool allow_explicit() {
+    static const bool allowed = [] {
+        const char* env = std::getenv("SCHEDRT_HUGEPAGES");
+        return !env || (std::strcmp(env, "thp") != 0 && std::strcmp(env, "off") != 0);
+    }();
+    return allowed;
+}
+
+bool allow_thp() {
+    static const bool allowed = [] {
+        const char* env = std::getenv("SCHEDRT_HUGEPAGES");
+        return !env || (std::strcmp(env, "explicit") != 0 && std::strcmp(env, "off") != 0);
+    }();
+    return allowed;
+}
+
+bool huge_pages_disabled() {
+    static const bool off = [] {
+        const char* env = std::getenv("SCHEDRT_HUGEPAGES");
+        return env && std::strcmp(env, "off") == 0;
+    }();
+    return off;
+}
+
+// bytes is a multiple of the huge page size.
+bool map_huge(size_t bytes, Mapping& out) {
+    if (allow_explicit()) {
+        void* p = mmap(nullptr, bytes, PROT_READ | PROT_WRITE,
+                       MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        if (p != MAP_FAILED) {
+            out = {p, bytes, Backing::Explicit};
+            return true;
+        }
+    }
+    if (!allow_thp()) return false;
+    // Over-map so the region can be trimmed to a huge-page boundary.
+    const size_t align = huge_page_size();
+    size_t span = bytes + align;
+    void* raw = mmap(nullptr, span, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (raw == MAP_FAILED) return false;
+    auto start = reinterpret_cast<uintptr_t>(raw);
+    auto aligned = (start + align - 1) & ~(static_cast<uintptr_t>(align) - 1);
+    size_t head = aligned - start;
+    size_t tail = span - head - bytes;
+    if (head) munmap(raw, head);
+    if (tail) munmap(reinterpret_cast<void*>(aligned + bytes), tail);
+    void* p = reinterpret_cast<void*>(aligned);
+    madvise(p, bytes, MADV_HUGEPAGE);
+    out = {p, bytes, Backing::Thp};
+    return true;
+}
+
+size_t round_up(size_t value, size_t align) {
+    return (value + align - 1) / align * align;
+}
+
+size_t next_pow2(size_t value) {
+    size_t out = 1;
+    while (out < value) out <<= 1;
+    return out;
+}
+
+// Sub-huge-page requests are rounded to a power-of-two class and carved out
+// of huge-page arenas; larger ones get a dedicated mapping of whole pages.
+size_t class_bytes(size_t bytes) {
+    if (bytes <= huge_page_size()) return next_pow2(bytes);
+    return round_up(bytes, huge_page_size());
+}
+
+class HostPool {
+public:
+    void* allocate(size_t bytes) {
+        size_t cls = class_bytes(bytes);
+        std::lock_guard<std::mutex> lk(mu_);
+        auto& free_list = free_[cls];
+        if (!free_list.empty()) {
+            void* p = free_list.back();
+            free_list.pop_back();
+            ++stats_.pool_hits;
+            return p;
+        }
+        ++stats_.pool_misses;
+        if (cls < huge_page_size()) return carve_locked(cls);
+        Mapping m{};
+        if (!map_huge(cls, m)) return nullptr;
+        account_locked(m);
+        large_[m.base] = m;
+        return m.base;
+    }
+
+    void release(void* p, size_t bytes) {
+        std::lock_guard<std::mutex> lk(mu_);
+        free_[class_bytes(bytes)].push_back(p);
+    }
+
+    void trim() {
+        std::lock_guard<std::mutex> lk(mu_);
+        for (auto& [cls, list] : free_) {
+            if (cls < huge_page_size()) continue;
+            for (void* p : list) {
+                auto it = large_.find(p);
+                if (it == large_.end()) continue;
+                unaccount_locked(it->second);
+                munmap(it->second.base, it->second.bytes);
+                large_.erase(it);
+            }
+            list.clear();
+        }
+    }
+
+    HostBufferStats stats() {
+        std::lock_guard<std::mutex> lk(mu_);
+        return stats_;
+    }
+
+    // Heap fallbacks for pool-sized requests are remembered so release() is never handed one.
+    void add_heap(void* p, size_t bytes, bool pool_sized) {
+        std::lock_guard<std::mutex> lk(mu_);
+        stats_.heap_bytes += bytes;
+        if (pool_sized) heap_fallbacks_.insert(p);
+    }
+
+    // True when p came from the heap rather than the pool.
+    bool remove_heap(void* p, size_t bytes, bool pool_sized) {
+        std::lock_guard<std::mutex> lk(mu_);
+        if (pool_sized && heap_fallbacks_.erase(p) == 0) return false;
+        stats_.heap_bytes -= bytes;
+        return true;
+    }
+
+private:
+    void* carve_locked(size_t cls) {
+        Mapping arena{};
+        if (!map_huge(huge_page_size(), arena)) return nullptr;
+        account_locked(arena);
+        arenas_.push_back(arena);
+        auto* base = static_cast<uint8_t*>(arena.base);
+        auto& free_list = free_[cls];
+        for (size_t off = cls; off + cls <= arena.bytes; off += cls) free_list.push_back(base + off);
+        return base;
+    }
+
+    void account_locked(const Mapping& m) {
+        (m.backing == Backing::Explicit ? stats_.explicit_bytes : stats_.thp_bytes) += m.bytes;
+    }
+
+    void unaccount_locked(const Mapping& m) {
+        (m.backing == Backing::Explicit ? stats_.explicit_bytes : stats_.thp_bytes) -= m.bytes;
+    }
+
+    std::mutex mu_;
+    std::map<size_t, std::vector<void*>> free_;
+    std::unordered_map<void*, Mapping> large_;
+    std::vector<Mapping> arenas_;
+    std::unordered_set<void*> heap_fallbacks_;
+    HostBufferStats stats_;
+};
+
+HostPool& pool() {
+    // Leaked on purpose: buffers may be released from static destructors.
+    static HostPool* instance = new HostPool();
+    return *instance;
+}
+
+} // namespace
+
+BufferView alloc_host_buffer(size_t bytes) {
+    if (bytes == 0) return {nullptr, 0};
+    bool pool_sized = bytes >= kSmallLimit && !huge_pages_disabled();
+    if (pool_sized) {
+        if (void* p = pool().allocate(bytes)) return {p, bytes};
+    }
+    void* p = std::aligned_alloc(kHeapAlign, round_up(bytes, kHeapAlign));
+    if (!p) return {nullptr, 0};
+    pool().add_heap(p, bytes, pool_sized);
+    return {p, bytes};
+}
+
+void free_host_buffer(BufferView buf) {
+    if (!buf.data) return;
+    bool pool_sized = buf.bytes >= kSmallLimit && !huge_pages_disabled();
+    if (pool().remove_heap(buf.data, buf.bytes, pool_sized)) {
+        std::free(buf.data);
+        return;
+    }
+    pool().release(buf.data, buf.bytes);
+}
+
+void host_buffer_trim() {
+    pool().trim();
+}
+
+HostBufferStats host_buffer_stats() {
+    return pool().stats();
+}
+
+} // namespace dash
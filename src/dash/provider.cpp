@@ -1,13 +1,14 @@
 #include "dash/provider.hpp"
+#include "schedrt/instrumented_mutex.hpp"
 #include <algorithm>
 #include <mutex>
 
 namespace dash {
-static std::mutex g_mu;
+static schedrt::InstrumentedMutex g_mu{"dash::provider"};
 static std::vector<Provider> g_providers;
 
 void register_provider(const Provider& p) {
-    std::lock_guard<std::mutex> lk(g_mu);
+    std::lock_guard<schedrt::InstrumentedMutex> lk(g_mu);
     g_providers.push_back(p);
     std::sort(g_providers.begin(), g_providers.end(),
               [](auto& a, auto& b){
@@ -19,7 +20,7 @@ void register_provider(const Provider& p) {
 }
 
 std::vector<Provider> providers_for(const std::string& op) {
-    std::lock_guard<std::mutex> lk(g_mu);
+    std::lock_guard<schedrt::InstrumentedMutex> lk(g_mu);
     std::vector<Provider> out;
     for (auto& p : g_providers) if (p.op == op) out.push_back(p);
     return out;
@@ -12,4 +12,9 @@ void set_scheduler(schedrt::Scheduler* sched) {
     g_sched_ptr = sched;
 }
 
+void parallel_for(size_t begin, size_t end, size_t grain, const std::function<void(size_t, size_t)>& fn) {
+    if (g_sched_ptr) g_sched_ptr->parallel_for(begin, end, grain, fn);
+    else if (begin < end) fn(begin, end);
+}
+
 } // namespace dash
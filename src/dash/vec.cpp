@@ -0,0 +1,286 @@
+#include "dash/vec.hpp"
+#include "dash/scheduler_binding.hpp"
+#include "schedrt/scheduler.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#if defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#define DASH_VEC_NEON 1
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#define DASH_VEC_SSE2 1
+#endif
+
+namespace dash {
+namespace vec {
+namespace {
+
+// ---- 4-lane helpers: four complex samples per step, split into re/im ----
+#if defined(DASH_VEC_NEON)
+constexpr size_t kLanes = 4;
+using f4 = float32x4_t;
+using u4 = uint32x4_t;
+
+inline void load(const float* p, f4& re, f4& im) {
+    float32x4x2_t v = vld2q_f32(p);
+    re = v.val[0];
+    im = v.val[1];
+}
+inline void store(float* p, f4 re, f4 im) { vst2q_f32(p, float32x4x2_t{{re, im}}); }
+inline f4 add(f4 a, f4 b) { return vaddq_f32(a, b); }
+inline f4 sub(f4 a, f4 b) { return vsubq_f32(a, b); }
+inline f4 mulv(f4 a, f4 b) { return vmulq_f32(a, b); }
+inline f4 sqrtv(f4 a) { return vsqrtq_f32(a); }
+inline void store_real(float* p, f4 v) { vst1q_f32(p, v); }
+inline f4 splat(float v) { return vdupq_n_f32(v); }
+inline u4 splat_u(uint32_t v) { return vdupq_n_u32(v); }
+inline u4 iota() {
+    const uint32_t v[4] = {0, 1, 2, 3};
+    return vld1q_u32(v);
+}
+inline u4 add_u(u4 a, u4 b) { return vaddq_u32(a, b); }
+inline u4 gt(f4 a, f4 b) { return vcgtq_f32(a, b); }
+inline f4 select(u4 m, f4 a, f4 b) { return vbslq_f32(m, a, b); }
+inline u4 select_u(u4 m, u4 a, u4 b) { return vbslq_u32(m, a, b); }
+inline void spill(f4 v, float* out) { vst1q_f32(out, v); }
+inline void spill_u(u4 v, uint32_t* out) { vst1q_u32(out, v); }
+#elif defined(DASH_VEC_SSE2)
+constexpr size_t kLanes = 4;
+using f4 = __m128;
+using u4 = __m128i;
+
+inline void load(const float* p, f4& re, f4& im) {
+    f4 lo = _mm_loadu_ps(p), hi = _mm_loadu_ps(p + 4);
+    re = _mm_shuffle_ps(lo, hi, _MM_SHUFFLE(2, 0, 2, 0));
+    im = _mm_shuffle_ps(lo, hi, _MM_SHUFFLE(3, 1, 3, 1));
+}
+inline void store(float* p, f4 re, f4 im) {
+    _mm_storeu_ps(p, _mm_unpacklo_ps(re, im));
+    _mm_storeu_ps(p + 4, _mm_unpackhi_ps(re, im));
+}
+inline f4 add(f4 a, f4 b) { return _mm_add_ps(a, b); }
+inline f4 sub(f4 a, f4 b) { return _mm_sub_ps(a, b); }
+inline f4 mulv(f4 a, f4 b) { return _mm_mul_ps(a, b); }
+inline f4 sqrtv(f4 a) { return _mm_sqrt_ps(a); }
+inline void store_real(float* p, f4 v) { _mm_storeu_ps(p, v); }
+inline f4 splat(float v) { return _mm_set1_ps(v); }
+inline u4 splat_u(uint32_t v) { return _mm_set1_epi32(static_cast<int>(v)); }
+inline u4 iota() { return _mm_setr_epi32(0, 1, 2, 3); }
+inline u4 add_u(u4 a, u4 b) { return _mm_add_epi32(a, b); }
+inline u4 gt(f4 a, f4 b) { return _mm_castps_si128(_mm_cmpgt_ps(a, b)); }
+inline f4 select(u4 m, f4 a, f4 b) {
+    f4 mf = _mm_castsi128_ps(m);
+    return _mm_or_ps(_mm_and_ps(mf, a), _mm_andnot_ps(mf, b));
+}
+inline u4 select_u(u4 m, u4 a, u4 b) { return _mm_or_si128(_mm_and_si128(m, a), _mm_andnot_si128(m, b)); }
+inline void spill(f4 v, float* out) { _mm_storeu_ps(out, v); }
+inline void spill_u(u4 v, uint32_t* out) { _mm_storeu_si128(reinterpret_cast<__m128i*>(out), v); }
+#else
+constexpr size_t kLanes = 0;  // scalar loops only
+#endif
+
+template <bool Conj>
+void mul_impl(const float* a, const float* b, float* out, size_t n) {
+    size_t i = 0;
+#if defined(DASH_VEC_NEON) || defined(DASH_VEC_SSE2)
+    for (; i + kLanes <= n; i += kLanes) {
+        f4 ar, ai, br, bi;
+        load(a + 2 * i, ar, ai);
+        load(b + 2 * i, br, bi);
+        if constexpr (Conj) {
+            store(out + 2 * i, add(mulv(ar, br), mulv(ai, bi)), sub(mulv(ai, br), mulv(ar, bi)));
+        } else {
+            store(out + 2 * i, sub(mulv(ar, br), mulv(ai, bi)), add(mulv(ai, br), mulv(ar, bi)));
+        }
+    }
+#endif
+    for (; i < n; ++i) {
+        float ar = a[2 * i], ai = a[2 * i + 1], br = b[2 * i], bi = b[2 * i + 1];
+        if constexpr (Conj) {
+            out[2 * i] = ar * br + ai * bi;
+            out[2 * i + 1] = ai * br - ar * bi;
+        } else {
+            out[2 * i] = ar * br - ai * bi;
+            out[2 * i + 1] = ai * br + ar * bi;
+        }
+    }
+}
+
+// Lane indices are 32-bit, so long scans are split into blocks.
+constexpr size_t kArgMaxBlock = size_t{1} << 30;
+
+ArgMax argmax_block(const float* in, size_t n) {
+    ArgMax best;
+    size_t i = 0;
+#if defined(DASH_VEC_NEON) || defined(DASH_VEC_SSE2)
+    if (n >= kLanes) {
+        f4 vbest = splat(best.value);
+        u4 vidx = splat_u(0), cur = iota(), step = splat_u(static_cast<uint32_t>(kLanes));
+        for (; i + kLanes <= n; i += kLanes) {
+            f4 re, im;
+            load(in + 2 * i, re, im);
+            u4 m = gt(re, vbest);
+            vbest = select(m, re, vbest);
+            vidx = select_u(m, cur, vidx);
+            cur = add_u(cur, step);
+        }
+        float vals[kLanes];
+        uint32_t idxs[kLanes];
+        spill(vbest, vals);
+        spill_u(vidx, idxs);
+        // Each lane kept its first maximum; across lanes the lowest index wins ties.
+        bool found = false;
+        for (size_t l = 0; l < kLanes; ++l) {
+            if (!(vals[l] > -std::numeric_limits<float>::infinity())) continue;
+            if (!found || vals[l] > best.value || (vals[l] == best.value && idxs[l] < best.index)) {
+                best.value = vals[l];
+                best.index = idxs[l];
+                found = true;
+            }
+        }
+    }
+#endif
+    for (; i < n; ++i) {
+        if (in[2 * i] > best.value) {
+            best.value = in[2 * i];
+            best.index = i;
+        }
+    }
+    return best;
+}
+
+// fftshift of samples [lo, hi) of one row of length len.
+void fftshift_part(const float* in, float* out, size_t len, size_t lo, size_t hi) {
+    size_t shift = (len + 1) / 2;
+    size_t split = len - shift;  // out[i] = in[i + shift] below, in[i - split] above
+    if (lo < split) {
+        size_t e = std::min(hi, split);
+        std::memcpy(out + 2 * lo, in + 2 * (lo + shift), (e - lo) * 2 * sizeof(float));
+        lo = e;
+    }
+    if (lo < hi) std::memcpy(out + 2 * lo, in + 2 * (lo - split), (hi - lo) * 2 * sizeof(float));
+}
+
+// Below this many samples per chunk the fork-join round trip outweighs the work.
+constexpr size_t kMinChunkSamples = 16384;
+
+} // namespace
+
+void mul(const float* a, const float* b, float* out, size_t n) { mul_impl<false>(a, b, out, n); }
+
+void mul_conj(const float* a, const float* b, float* out, size_t n) { mul_impl<true>(a, b, out, n); }
+
+void magnitude(const float* in, float* out, size_t n) {
+    size_t i = 0;
+#if defined(DASH_VEC_NEON) || defined(DASH_VEC_SSE2)
+    for (; i + kLanes <= n; i += kLanes) {
+        f4 re, im;
+        load(in + 2 * i, re, im);
+        store_real(out + i, sqrtv(add(mulv(re, re), mulv(im, im))));
+    }
+#endif
+    for (; i < n; ++i) out[i] = std::sqrt(in[2 * i] * in[2 * i] + in[2 * i + 1] * in[2 * i + 1]);
+}
+
+ArgMax argmax_real(const float* in, size_t n) {
+    ArgMax best;
+    for (size_t base = 0; base < n; base += kArgMaxBlock) {
+        ArgMax part = argmax_block(in + 2 * base, std::min(kArgMaxBlock, n - base));
+        if (part.value > best.value) {
+            best.value = part.value;
+            best.index = base + part.index;
+        }
+    }
+    return best;
+}
+
+void fftshift(const float* in, float* out, size_t n) { fftshift_part(in, out, n, 0, n); }
+
+bool valid(const Job& job) {
+    if (!job.a || job.n == 0) return false;
+    if (job.row && job.n % job.row != 0) return false;
+    switch (job.op) {
+    case Op::Mul:
+    case Op::MulConj: return job.b && job.out;
+    case Op::Magnitude: return job.out != nullptr;
+    case Op::ArgMaxReal: return true;
+    case Op::FftShift: return job.out && job.out != job.a;
+    }
+    return false;
+}
+
+bool run_range(const Job& job, size_t begin, size_t end, ArgMax* best) {
+    if (!valid(job) || begin > end || end > job.n) return false;
+    if (job.row && (begin % job.row || end % job.row)) return false;
+    size_t count = end - begin;
+    const float* a = job.a + 2 * begin;
+    switch (job.op) {
+    case Op::Mul:
+    case Op::MulConj: {
+        auto kernel = job.op == Op::Mul ? &mul : &mul_conj;
+        if (!job.row) {
+            kernel(a, job.b + 2 * begin, job.out + 2 * begin, count);
+            break;
+        }
+        for (size_t r = begin; r < end; r += job.row) kernel(job.a + 2 * r, job.b, job.out + 2 * r, job.row);
+        break;
+    }
+    case Op::Magnitude:
+        magnitude(a, job.out + begin, count);
+        break;
+    case Op::ArgMaxReal: {
+        ArgMax part = argmax_real(a, count);
+        part.index += begin;
+        if (best) *best = part;
+        break;
+    }
+    case Op::FftShift:
+        if (!job.row) {
+            fftshift_part(job.a, job.out, job.n, begin, end);
+            break;
+        }
+        for (size_t r = begin; r < end; r += job.row) fftshift(job.a + 2 * r, job.out + 2 * r, job.row);
+        break;
+    }
+    return true;
+}
+
+bool execute(const Job& job, ArgMax* best) {
+    auto* sched = dash::scheduler();
+    if (!sched || !valid(job)) return false;
+
+    size_t unit = job.row ? job.row : 1;
+    size_t units = job.n / unit;
+    size_t workers = std::max<size_t>(1, sched->parallelism());
+    size_t min_units = std::max<size_t>(1, kMinChunkSamples / unit);
+    size_t chunks = std::clamp<size_t>((units + min_units - 1) / min_units, 1, workers);
+    size_t per = (units + chunks - 1) / chunks;
+    chunks = (units + per - 1) / per;
+
+    // One index per chunk, so ArgMaxReal can keep a partial per chunk.
+    std::vector<ArgMax> parts(chunks);
+    std::atomic<bool> ok{true};
+    sched->parallel_for(0, chunks, 1, [&](size_t lo, size_t hi) {
+        for (size_t c = lo; c < hi; ++c) {
+            size_t begin = c * per * unit;
+            size_t end = std::min(units, (c + 1) * per) * unit;
+            if (!run_range(job, begin, end, &parts[c])) ok.store(false, std::memory_order_relaxed);
+        }
+    });
+    if (ok && best) {
+        *best = ArgMax{};
+        for (const auto& part : parts) {
+            if (part.value > best->value) *best = part;
+        }
+    }
+    return ok;
+}
+
+} // namespace vec
+} // namespace dash
@@ -0,0 +1,731 @@
+#include "schedrt/federation.hpp"
+#include "schedrt/scheduler.hpp"
+#include "dash/contexts.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <deque>
+#include <functional>
+#include <future>
+#include <iostream>
+#include <arpa/inet.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace schedrt {
+namespace federation {
+namespace {
+
+enum class FrameType : uint8_t { Hello = 1, Summary = 2, Task = 3, Result = 4 };
+enum class PayloadKind : uint8_t { None = 0, Fft = 1, Zip = 2 };
+
+constexpr uint32_t kMaxFrameBytes = 256u << 20;
+constexpr auto kReconnectDelay = std::chrono::milliseconds(500);
+// Result labels a link interns before it falls back to the bare peer label.
+constexpr size_t kMaxResultLabels = 64;
+
+// Little-endian encoder; payload floats travel as raw IEEE-754 bytes, which
+// matches every board we target (Zynq A9/A53 and x86 hosts).
+class Encoder {
+public:
+    void u8(uint8_t v) { buf_.push_back(v); }
+    void u32(uint32_t v) { for (int i = 0; i < 4; ++i) buf_.push_back(static_cast<uint8_t>(v >> (8 * i))); }
+    void u64(uint64_t v) { for (int i = 0; i < 8; ++i) buf_.push_back(static_cast<uint8_t>(v >> (8 * i))); }
+    void bytes(const void* data, size_t len) {
+        u64(len);
+        auto* p = static_cast<const uint8_t*>(data);
+        buf_.insert(buf_.end(), p, p + len);
+    }
+    void str(const std::string& s) { bytes(s.data(), s.size()); }
+    const std::vector<uint8_t>& data() const { return buf_; }
+
+private:
+    std::vector<uint8_t> buf_;
+};
+
+class Decoder {
+public:
+    explicit Decoder(const std::vector<uint8_t>& buf) : p_(buf.data()), end_(buf.data() + buf.size()) {}
+    bool ok() const { return ok_; }
+    uint8_t u8() { return need(1) ? *p_++ : 0; }
+    uint32_t u32() {
+        if (!need(4)) return 0;
+        uint32_t v = 0;
+        for (int i = 0; i < 4; ++i) v |= static_cast<uint32_t>(*p_++) << (8 * i);
+        return v;
+    }
+    uint64_t u64() {
+        if (!need(8)) return 0;
+        uint64_t v = 0;
+        for (int i = 0; i < 8; ++i) v |= static_cast<uint64_t>(*p_++) << (8 * i);
+        return v;
+    }
+    std::vector<uint8_t> bytes() {
+        uint64_t len = u64();
+        if (!need(len)) return {};
+        std::vector<uint8_t> out(p_, p_ + len);
+        p_ += len;
+        return out;
+    }
+    std::string str() {
+        auto b = bytes();
+        return std::string(b.begin(), b.end());
+    }
+
+private:
+    bool need(uint64_t n) {
+        if (!ok_ || static_cast<uint64_t>(end_ - p_) < n) ok_ = false;
+        return ok_;
+    }
+    const uint8_t* p_;
+    const uint8_t* end_;
+    bool ok_{true};
+};
+
+// Results travel as a status code, flags and the two details, so the text is
+// only formatted by whichever node prints the result.
+void encode_status(Encoder& e, const Status& st) {
+    e.u8(static_cast<uint8_t>(st.code));
+    e.u8(static_cast<uint8_t>((st.cpu_fallback ? 1 : 0) | (st.hedge ? 2 : 0)));
+    e.u64(static_cast<uint64_t>(st.detail[0]));
+    e.u64(static_cast<uint64_t>(st.detail[1]));
+}
+
+Status decode_status(Decoder& d) {
+    Status st;
+    st.code = static_cast<StatusCode>(d.u8());
+    uint8_t flags = d.u8();
+    st.cpu_fallback = (flags & 1) != 0;
+    st.hedge = (flags & 2) != 0;
+    st.detail[0] = static_cast<int64_t>(d.u64());
+    st.detail[1] = static_cast<int64_t>(d.u64());
+    return st;
+}
+
+bool write_all(int fd, const void* data, size_t len) {
+    auto* p = static_cast<const uint8_t*>(data);
+    while (len > 0) {
+        ssize_t n = ::send(fd, p, len, MSG_NOSIGNAL);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) return false;
+        p += n;
+        len -= static_cast<size_t>(n);
+    }
+    return true;
+}
+
+bool read_all(int fd, void* data, size_t len) {
+    auto* p = static_cast<uint8_t*>(data);
+    while (len > 0) {
+        ssize_t n = ::recv(fd, p, len, 0);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) return false;
+        p += n;
+        len -= static_cast<size_t>(n);
+    }
+    return true;
+}
+
+// Caller serialises writers on the socket.
+bool send_frame(int fd, FrameType type, const Encoder& body) {
+    Encoder head;
+    head.u32(static_cast<uint32_t>(body.data().size() + 1));
+    head.u8(static_cast<uint8_t>(type));
+    return write_all(fd, head.data().data(), head.data().size()) &&
+           write_all(fd, body.data().data(), body.data().size());
+}
+
+bool recv_frame(int fd, FrameType& type, std::vector<uint8_t>& body) {
+    uint8_t head[5];
+    if (!read_all(fd, head, sizeof(head))) return false;
+    uint32_t len = static_cast<uint32_t>(head[0]) | (static_cast<uint32_t>(head[1]) << 8) |
+                   (static_cast<uint32_t>(head[2]) << 16) | (static_cast<uint32_t>(head[3]) << 24);
+    if (len == 0 || len > kMaxFrameBytes) return false;
+    type = static_cast<FrameType>(head[4]);
+    body.resize(len - 1);
+    return body.empty() || read_all(fd, body.data(), body.size());
+}
+
+void set_nodelay(int fd) {
+    int one = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+}
+
+int connect_to(const std::string& host, uint16_t port) {
+    addrinfo hints{};
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    addrinfo* res = nullptr;
+    if (getaddrinfo(host.c_str(), std::to_string(port).c_str(), &hints, &res) != 0) return -1;
+    int fd = -1;
+    for (auto* ai = res; ai; ai = ai->ai_next) {
+        fd = ::socket(ai->ai_family, ai->ai_socktype, ai->ai_protocol);
+        if (fd < 0) continue;
+        if (::connect(fd, ai->ai_addr, ai->ai_addrlen) == 0) break;
+        ::close(fd);
+        fd = -1;
+    }
+    freeaddrinfo(res);
+    if (fd >= 0) set_nodelay(fd);
+    return fd;
+}
+
+template <typename T>
+T* context_from_task(const Task& task, const char* key) {
+    auto it = task.params.find(key);
+    if (it == task.params.end() || it->second.empty()) return nullptr;
+    return reinterpret_cast<T*>(static_cast<std::uintptr_t>(std::stoull(it->second)));
+}
+
+struct RemoteResult {
+    bool ok = false;
+    Status status{};
+    std::string accelerator;
+    std::chrono::nanoseconds runtime{0};
+    std::vector<uint8_t> output;
+    uint64_t out_actual = 0;
+};
+
+// Buffers owned by the serving node for one forwarded task.
+struct InboundJob {
+    PayloadKind kind = PayloadKind::None;
+    std::vector<uint8_t> in;
+    std::vector<uint8_t> out;
+    size_t out_actual = 0;
+    dash::FftContext fft;
+    dash::ZipContext zip;
+};
+
+std::atomic<uint64_t> g_next_inbound_id{uint64_t{1} << 48};
+
+} // namespace
+
+// ---------------- outbound link ----------------
+class PeerLink {
+public:
+    PeerLink(std::string host, uint16_t port, std::string local_name)
+        : host_(std::move(host)), port_(port), local_name_(std::move(local_name)) {
+        peer_label_ = intern_label(peer_id());
+    }
+
+    ~PeerLink() { stop(); }
+
+    void start() { thread_ = std::thread([this]{ run_loop(); }); }
+
+    void stop() {
+        if (!running_.exchange(false)) return;
+        {
+            std::lock_guard<InstrumentedMutex> lk(write_mu_);
+            int fd = fd_.load();
+            if (fd >= 0) ::shutdown(fd, SHUT_RDWR);
+        }
+        if (thread_.joinable()) thread_.join();
+    }
+
+    bool connected() const { return connected_.load(std::memory_order_acquire); }
+    uint64_t inflight() const { return inflight_.load(std::memory_order_relaxed); }
+
+    LoadSummary summary() const {
+        std::lock_guard<InstrumentedMutex> lk(mu_);
+        return summary_;
+    }
+
+    std::string label() const {
+        std::lock_guard<InstrumentedMutex> lk(mu_);
+        return "peer:" + peer_id();
+    }
+
+    // label() + "/" + the accelerator the peer reported, as an
+    // ExecutionResult::accelerator: interned per remote name, so it lives as
+    // long as the link. Past kMaxResultLabels, results carry the bare peer label.
+    const char* result_label(const std::string& remote) {
+        std::lock_guard<InstrumentedMutex> lk(mu_);
+        if (remote.empty()) return peer_label_;
+        auto it = result_labels_.find(remote);
+        if (it != result_labels_.end()) return it->second;
+        const char* s = intern_label(peer_id() + "/" + remote);
+        if (s == nullptr) return peer_label_;
+        result_labels_.emplace(remote, s);
+        return s;
+    }
+
+    using Done = std::function<void(RemoteResult&&)>;
+
+    // Sends a TASK body (request id encoded first). `done` runs exactly once:
+    // on the link thread when the RESULT arrives, or with ok=false if the
+    // frame cannot be sent or the link drops first.
+    void send_task(uint64_t req_id, const Encoder& body, Done done) {
+        bool registered = false;
+        {
+            std::lock_guard<InstrumentedMutex> lk(mu_);
+            if (connected()) {
+                pending_.emplace(req_id, std::move(done));
+                inflight_.fetch_add(1, std::memory_order_relaxed);
+                registered = true;
+            }
+        }
+        if (!registered) {
+            done(failure(StatusCode::PeerNotConnected));
+            return;
+        }
+        bool sent;
+        {
+            std::lock_guard<InstrumentedMutex> lk(write_mu_);
+            sent = send_frame(fd_.load(), FrameType::Task, body);
+        }
+        if (!sent) complete(req_id, failure(StatusCode::PeerSendFailed));
+    }
+
+    uint64_t next_request_id() { return next_req_.fetch_add(1, std::memory_order_relaxed); }
+
+private:
+    void run_loop() {
+        while (running_) {
+            int fd = connect_to(host_, port_);
+            if (fd < 0) {
+                auto until = std::chrono::steady_clock::now() + kReconnectDelay;
+                while (running_ && std::chrono::steady_clock::now() < until)
+                    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+                continue;
+            }
+            fd_.store(fd);
+            Encoder hello;
+            hello.str(local_name_);
+            {
+                std::lock_guard<InstrumentedMutex> lk(write_mu_);
+                if (!send_frame(fd, FrameType::Hello, hello)) {
+                    drop(fd);
+                    continue;
+                }
+            }
+            connected_.store(true, std::memory_order_release);
+            std::cout << "[federation] connected to " << host_ << ":" << port_ << "\n";
+            read_frames(fd);
+            drop(fd);
+            if (running_) std::cout << "[federation] lost " << host_ << ":" << port_ << ", reconnecting\n";
+        }
+    }
+
+    void read_frames(int fd) {
+        FrameType type;
+        std::vector<uint8_t> body;
+        while (running_ && recv_frame(fd, type, body)) {
+            Decoder d(body);
+            if (type == FrameType::Hello) {
+                std::string name = d.str();
+                std::lock_guard<InstrumentedMutex> lk(mu_);
+                if (d.ok() && name != peer_name_) {
+                    peer_name_ = name;
+                    result_labels_.clear();  // the strings stay in label_store_
+                    if (const char* s = intern_label(peer_id())) peer_label_ = s;
+                }
+            } else if (type == FrameType::Summary) {
+                LoadSummary s;
+                s.ready_depth = d.u64();
+                s.workers = d.u32();
+                uint32_t count = d.u32();
+                for (uint32_t i = 0; i < count && d.ok(); ++i) s.overlays.push_back(d.str());
+                if (!d.ok()) return;
+                std::lock_guard<InstrumentedMutex> lk(mu_);
+                summary_ = std::move(s);
+            } else if (type == FrameType::Result) {
+                uint64_t req = d.u64();
+                RemoteResult r;
+                r.ok = d.u8() != 0;
+                r.status = decode_status(d);
+                r.runtime = std::chrono::nanoseconds(d.u64());
+                r.accelerator = d.str();
+                r.output = d.bytes();
+                r.out_actual = d.u64();
+                if (!d.ok()) return;
+                complete(req, std::move(r));
+            }
+        }
+    }
+
+    static RemoteResult failure(StatusCode code) {
+        RemoteResult r;
+        r.status.code = code;
+        return r;
+    }
+
+    void complete(uint64_t req_id, RemoteResult&& r) {
+        Done done;
+        {
+            std::lock_guard<InstrumentedMutex> lk(mu_);
+            auto it = pending_.find(req_id);
+            if (it == pending_.end()) return;
+            done = std::move(it->second);
+            pending_.erase(it);
+            inflight_.fetch_sub(1, std::memory_order_relaxed);
+        }
+        done(std::move(r));
+    }
+
+    void drop(int fd) {
+        connected_.store(false, std::memory_order_release);
+        {
+            std::lock_guard<InstrumentedMutex> lk(write_mu_);
+            fd_.store(-1);
+            ::close(fd);
+        }
+        std::unordered_map<uint64_t, Done> orphaned;
+        {
+            std::lock_guard<InstrumentedMutex> lk(mu_);
+            orphaned.swap(pending_);
+            inflight_.store(0, std::memory_order_relaxed);
+            summary_ = {};
+        }
+        for (auto& [id, done] : orphaned) done(failure(StatusCode::PeerLinkLost));
+    }
+
+    std::string host_;
+    uint16_t port_;
+    std::string local_name_;
+    std::thread thread_;
+    std::atomic<bool> running_{true};
+    std::atomic<bool> connected_{false};
+    std::atomic<int> fd_{-1};
+    std::atomic<uint64_t> inflight_{0};
+    std::atomic<uint64_t> next_req_{1};
+
+    mutable InstrumentedMutex mu_{"federation::PeerLink::mu_"};
+    InstrumentedMutex write_mu_{"federation::PeerLink::write_mu_"};
+    std::unordered_map<uint64_t, Done> pending_;
+    LoadSummary summary_;
+    std::string peer_name_;
+
+    // The name the peer gave in its HELLO, or host:port before one arrives.
+    // Caller holds mu_ (or owns the link).
+    std::string peer_id() const {
+        return peer_name_.empty() ? host_ + ":" + std::to_string(port_) : peer_name_;
+    }
+
+    // "peer:" + `name`, stored for the life of the link; null once the store
+    // holds kMaxResultLabels entries. Caller holds mu_ (or owns the link).
+    const char* intern_label(const std::string& name) {
+        if (label_store_.size() >= kMaxResultLabels) return nullptr;
+        return label_store_.emplace_back("peer:" + name).c_str();
+    }
+
+    std::deque<std::string> label_store_;  // never erased; results point into it
+    const char* peer_label_ = nullptr;     // label() as of the last HELLO
+    std::unordered_map<std::string, const char*> result_labels_;  // remote accelerator -> label
+};
+
+// ---------------- RemoteNodeAccelerator ----------------
+RemoteNodeAccelerator::RemoteNodeAccelerator(std::shared_ptr<PeerLink> link) : link_(std::move(link)) {}
+
+RemoteNodeAccelerator::~RemoteNodeAccelerator() = default;
+
+std::string RemoteNodeAccelerator::name() const { return link_->label(); }
+
+bool RemoteNodeAccelerator::is_available() { return link_->connected(); }
+
+bool RemoteNodeAccelerator::should_forward(const Task& task, const LocalLoad& local) const {
+    if (!link_->connected()) return false;
+    // Vector chunks are a slice of a local array; shipping them costs more than running them.
+    if (task.params.count(dash::kVecContextKey)) return false;
+    // Batches point at many callers' buffers; the wire format carries one FFT.
+    if (task.params.count(dash::kFftBatchContextKey)) return false;
+    auto peer = link_->summary();
+    if (peer.workers == 0) return false;  // no summary yet
+    uint64_t inflight = link_->inflight();
+    // Two in flight per peer worker hides the round trip without hoarding work.
+    if (inflight >= 2ull * peer.workers) return false;
+    bool peer_resident = std::find(peer.overlays.begin(), peer.overlays.end(), task.app) != peer.overlays.end();
+    if (peer_resident && !local.overlay_resident) return true;
+    // Shorter queue: the peer's per-worker backlog, counting this task, must
+    // not exceed ours. Cross-multiplied to stay in integers.
+    return local.ready_depth > 0 &&
+           (peer.ready_depth + inflight + 1) * local.workers <= local.ready_depth * peer.workers;
+}
+
+ExecutionResult RemoteNodeAccelerator::run(const Task& task, const AppDescriptor& app) {
+    std::promise<ExecutionResult> result;
+    auto fut = result.get_future();
+    forward(task, app, [&result](const ExecutionResult& r) { result.set_value(r); });
+    return fut.get();
+}
+
+void RemoteNodeAccelerator::forward(const Task& task, const AppDescriptor& app, Completion done) {
+    auto t0 = std::chrono::steady_clock::now();
+    auto* fft = context_from_task<dash::FftContext>(task, dash::kFftContextKey);
+    auto* zip = fft ? nullptr : context_from_task<dash::ZipContext>(task, dash::kZipContextKey);
+
+    uint64_t req = link_->next_request_id();
+    Encoder body;
+    body.u64(req);
+    body.str(app.app);
+    body.u8(static_cast<uint8_t>(task.required));
+    body.u32(static_cast<uint32_t>(task.effective_priority));  // inherited priority travels too
+    body.u64(static_cast<uint64_t>(task.est_runtime_ns.count()));
+    if (fft) {
+        // Ship only the n complex samples the transform reads and writes, so the
+        // rest of the caller's buffers is left exactly as a local run leaves it.
+        constexpr size_t kSample = 2 * sizeof(float);
+        size_t n = fft->plan.n ? static_cast<size_t>(fft->plan.n)
+                               : std::min(fft->in.bytes, fft->out.bytes) / kSample;
+        body.u8(static_cast<uint8_t>(PayloadKind::Fft));
+        body.u32(static_cast<uint32_t>(fft->plan.n));
+        body.u8(fft->plan.inverse ? 1 : 0);
+        body.u8(static_cast<uint8_t>(fft->plan.precision));
+        body.bytes(fft->in.data, std::min(fft->in.bytes, n * kSample));
+        body.u64(std::min(fft->out.bytes, n * kSample));
+    } else if (zip) {
+        body.u8(static_cast<uint8_t>(PayloadKind::Zip));
+        body.u32(static_cast<uint32_t>(zip->params.level));
+        body.u8(zip->params.mode == dash::ZipMode::Compress ? 0 : 1);
+        body.bytes(zip->in.data, zip->in.bytes);
+        body.u64(zip->out.bytes);
+    } else {
+        body.u8(static_cast<uint8_t>(PayloadKind::None));
+    }
+
+    // The DASH contexts stay valid until `done` fires: their owners wait on
+    // the completion bus, which the scheduler only fulfils from `done`.
+    link_->send_task(req, body, [link = link_, fft, zip, id = task.id, t0, done = std::move(done)](RemoteResult&& rr) {
+        if (fft) {
+            std::memcpy(fft->out.data, rr.output.data(), std::min(rr.output.size(), fft->out.bytes));
+            fft->ok = rr.ok;
+            fft->status = rr.status;
+        } else if (zip) {
+            std::memcpy(zip->out.data, rr.output.data(), std::min(rr.output.size(), zip->out.bytes));
+            if (zip->out_actual) *zip->out_actual = static_cast<size_t>(rr.out_actual);
+            zip->ok = rr.ok;
+            zip->status = rr.status;
+        }
+        const char* accel = link->result_label(rr.accelerator);
+        auto t1 = std::chrono::steady_clock::now();
+        done({id, rr.ok, rr.status, std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0), accel});
+    });
+}
+
+// ---------------- serving side ----------------
+struct Node::Inbound {
+    int fd;
+    InstrumentedMutex write_mu{"federation::Inbound::write_mu"};
+    bool open{true};  // guarded by write_mu; completions may outlive the socket
+    std::string peer;
+    std::thread thread;               // runs serve(); joined by accept_loop or stop()
+    std::atomic<bool> finished{false};  // serve() has returned
+
+    explicit Inbound(int f) : fd(f) {}
+
+    bool send(FrameType type, const Encoder& body) {
+        std::lock_guard<InstrumentedMutex> lk(write_mu);
+        return open && send_frame(fd, type, body);
+    }
+
+    void close() {
+        std::lock_guard<InstrumentedMutex> lk(write_mu);
+        if (!open) return;
+        open = false;
+        ::close(fd);
+    }
+
+    void shutdown() {
+        std::lock_guard<InstrumentedMutex> lk(write_mu);
+        if (open) ::shutdown(fd, SHUT_RDWR);
+    }
+};
+
+Node::Node(Scheduler& sched, std::string name, std::chrono::milliseconds summary_period)
+    : sched_(sched), name_(std::move(name)), summary_period_(summary_period) {}
+
+Node::~Node() { stop(); }
+
+bool Node::listen(uint16_t port) {
+    int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+    if (fd < 0) return false;
+    int one = 1;
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_ANY);
+    addr.sin_port = htons(port);
+    if (::bind(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0 || ::listen(fd, 16) != 0) {
+        std::cerr << "[federation] cannot listen on port " << port << ": " << std::strerror(errno) << "\n";
+        ::close(fd);
+        return false;
+    }
+    listen_fd_ = fd;
+    accept_thread_ = std::thread([this]{ accept_loop(); });
+    summary_thread_ = std::thread([this]{ summary_loop(); });
+    std::cout << "[federation] node " << name_ << " listening on port " << port << "\n";
+    return true;
+}
+
+std::unique_ptr<RemoteNodeAccelerator> Node::connect(const std::string& host, uint16_t port) {
+    auto link = std::make_shared<PeerLink>(host, port, name_);
+    link->start();
+    {
+        std::lock_guard<InstrumentedMutex> lk(mu_);
+        links_.push_back(link);
+    }
+    return std::make_unique<RemoteNodeAccelerator>(std::move(link));
+}
+
+void Node::stop() {
+    if (!running_.exchange(false)) return;
+    if (listen_fd_ >= 0) ::shutdown(listen_fd_, SHUT_RDWR);
+    if (accept_thread_.joinable()) accept_thread_.join();
+    if (listen_fd_ >= 0) ::close(listen_fd_);
+    if (summary_thread_.joinable()) summary_thread_.join();
+
+    std::vector<std::shared_ptr<Inbound>> conns;
+    std::vector<std::shared_ptr<PeerLink>> links;
+    {
+        std::lock_guard<InstrumentedMutex> lk(mu_);
+        conns.swap(inbound_);
+        links.swap(links_);
+    }
+    for (auto& c : conns) c->shutdown();
+    for (auto& c : conns) if (c->thread.joinable()) c->thread.join();
+    for (auto& l : links) l->stop();
+}
+
+void Node::accept_loop() {
+    while (running_) {
+        int fd = ::accept(listen_fd_, nullptr, nullptr);
+        if (fd < 0) {
+            if (errno == EINTR) continue;
+            return;
+        }
+        set_nodelay(fd);
+        auto conn = std::make_shared<Inbound>(fd);
+        // Connections whose peer went away are dropped here, so a peer that
+        // keeps reconnecting does not pile up threads until stop().
+        std::vector<std::shared_ptr<Inbound>> closed;
+        {
+            std::lock_guard<InstrumentedMutex> lk(mu_);
+            auto live = std::partition(inbound_.begin(), inbound_.end(),
+                                       [](const std::shared_ptr<Inbound>& c) { return !c->finished; });
+            closed.assign(live, inbound_.end());
+            inbound_.erase(live, inbound_.end());
+            inbound_.push_back(conn);
+            conn->thread = std::thread([this, conn]{ serve(conn); });
+        }
+        for (auto& c : closed) c->thread.join();
+    }
+}
+
+void Node::serve(std::shared_ptr<Inbound> conn) {
+    Encoder hello;
+    hello.str(name_);
+    conn->send(FrameType::Hello, hello);
+
+    FrameType type;
+    std::vector<uint8_t> body;
+    while (running_ && recv_frame(conn->fd, type, body)) {
+        Decoder d(body);
+        if (type == FrameType::Hello) {
+            conn->peer = d.str();
+            std::cout << "[federation] peer " << conn->peer << " connected\n";
+            continue;
+        }
+        if (type != FrameType::Task) continue;
+
+        // A frame that fails these checks is malformed or hostile: drop the
+        // link, as for a truncated one. The peer requeues what it had in flight.
+        uint64_t req = d.u64();
+        auto task = std::make_shared<Task>();
+        task->app = d.str();
+        uint8_t required = d.u8();
+        if (required > static_cast<uint8_t>(ResourceKind::FIR)) break;
+        task->required = static_cast<ResourceKind>(required);
+        task->priority = static_cast<int>(d.u32());
+        task->est_runtime_ns = std::chrono::nanoseconds(d.u64());
+        auto job = std::make_shared<InboundJob>();
+        uint8_t kind = d.u8();
+        if (kind > static_cast<uint8_t>(PayloadKind::Zip)) break;
+        job->kind = static_cast<PayloadKind>(kind);
+        Status rejected{};  // Executed: the payload is sound
+        if (job->kind == PayloadKind::Fft) {
+            job->fft.plan.n = static_cast<int>(d.u32());
+            job->fft.plan.inverse = d.u8() != 0;
+            job->fft.plan.precision = static_cast<dash::FftPrecision>(
+                std::min<uint8_t>(d.u8(), static_cast<uint8_t>(dash::kFftPrecisionCount - 1)));
+            job->in = d.bytes();
+            uint64_t out_bytes = d.u64();
+            if (out_bytes > kMaxFrameBytes) break;
+            // The sender ships exactly the n samples the plan reads and writes;
+            // less means the caller's buffers were too small, as a local run reports.
+            constexpr uint64_t kSample = 2 * sizeof(float);
+            uint64_t n = job->fft.plan.n > 0 ? static_cast<uint64_t>(job->fft.plan.n) : job->in.size() / kSample;
+            if (job->fft.plan.n < 0 || out_bytes != n * kSample || job->in.size() != n * kSample) {
+                rejected.code = StatusCode::FftBufferTooSmall;
+                out_bytes = 0;
+            }
+            job->out.resize(out_bytes);
+            job->fft.in = {job->in.data(), job->in.size()};
+            job->fft.out = {job->out.data(), job->out.size()};
+            task->params.emplace(dash::kFftContextKey, std::to_string(reinterpret_cast<std::uintptr_t>(&job->fft)));
+        } else if (job->kind == PayloadKind::Zip) {
+            job->zip.params.level = static_cast<int>(d.u32());
+            job->zip.params.mode = d.u8() ? dash::ZipMode::Decompress : dash::ZipMode::Compress;
+            job->in = d.bytes();
+            uint64_t out_bytes = d.u64();
+            if (out_bytes > kMaxFrameBytes) break;
+            job->out.resize(out_bytes);
+            job->zip.in = {job->in.data(), job->in.size()};
+            job->zip.out = {job->out.data(), job->out.size()};
+            job->zip.out_actual = &job->out_actual;
+            task->params.emplace(dash::kZipContextKey, std::to_string(reinterpret_cast<std::uintptr_t>(&job->zip)));
+        }
+        if (!d.ok()) break;
+
+        task->id = g_next_inbound_id.fetch_add(1, std::memory_order_relaxed);
+        task->params.emplace(kOriginKey, conn->peer);
+        task->on_complete = [conn, job, req](const ExecutionResult& r) {
+            Encoder out;
+            out.u64(req);
+            out.u8(r.ok ? 1 : 0);
+            encode_status(out, r.status);
+            out.u64(static_cast<uint64_t>(r.runtime_ns.count()));
+            out.str(r.accelerator);
+            size_t out_bytes = job->kind == PayloadKind::Zip ? std::min(job->out_actual, job->out.size())
+                                                             : job->out.size();
+            out.bytes(job->out.data(), out_bytes);
+            out.u64(job->out_actual);
+            conn->send(FrameType::Result, out);
+        };
+        if (rejected.code != StatusCode::Executed) {
+            task->on_complete({task->id, false, rejected, std::chrono::nanoseconds(0), "none"});
+            continue;
+        }
+        sched_.submit(task);
+    }
+    conn->close();
+    conn->finished = true;  // accept_loop joins the thread on the next connection
+}
+
+void Node::summary_loop() {
+    while (running_) {
+        auto until = std::chrono::steady_clock::now() + summary_period_;
+        while (running_ && std::chrono::steady_clock::now() < until)
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        if (!running_) break;
+
+        auto s = sched_.load_summary();
+        Encoder body;
+        body.u64(s.ready_depth);
+        body.u32(s.workers);
+        body.u32(static_cast<uint32_t>(s.overlays.size()));
+        for (const auto& o : s.overlays) body.str(o);
+
+        std::vector<std::shared_ptr<Inbound>> conns;
+        {
+            std::lock_guard<InstrumentedMutex> lk(mu_);
+            conns = inbound_;
+        }
+        for (auto& c : conns) c->send(FrameType::Summary, body);
+    }
+}
+
+} // namespace federation
+} // namespace schedrt
@@ -0,0 +1,87 @@
+#include "schedrt/instrumented_mutex.hpp"
+
+#include <algorithm>
+#include <iomanip>
+#include <map>
+#include <memory>
+
+namespace schedrt {
+
+#if defined(SCHEDRT_LOCK_PROFILING) && SCHEDRT_LOCK_PROFILING
+namespace {
+
+struct Registry {
+    std::mutex mu;
+    std::map<std::string, std::unique_ptr<detail::LockCounters>> counters;
+};
+
+Registry& registry() {
+    // Leaked so function-local statics (e.g. DASH globals) can still unlock during exit.
+    static Registry* instance = new Registry();
+    return *instance;
+}
+
+} // namespace
+
+namespace detail {
+LockCounters* lock_counters_for(const char* name) {
+    auto& reg = registry();
+    std::lock_guard<std::mutex> lk(reg.mu);
+    auto& slot = reg.counters[name ? name : "unnamed"];
+    if (!slot) slot = std::make_unique<LockCounters>();
+    return slot.get();
+}
+} // namespace detail
+
+std::vector<LockStats> lock_profile_snapshot() {
+    std::vector<LockStats> out;
+    auto& reg = registry();
+    std::lock_guard<std::mutex> lk(reg.mu);
+    for (const auto& [name, c] : reg.counters) {
+        LockStats s;
+        s.name = name;
+        s.acquisitions = c->acquisitions.load(std::memory_order_relaxed);
+        s.contended = c->contended.load(std::memory_order_relaxed);
+        s.wait_ns = c->wait_ns.load(std::memory_order_relaxed);
+        s.max_wait_ns = c->max_wait_ns.load(std::memory_order_relaxed);
+        s.hold_ns = c->hold_ns.load(std::memory_order_relaxed);
+        s.max_hold_ns = c->max_hold_ns.load(std::memory_order_relaxed);
+        out.push_back(std::move(s));
+    }
+    std::sort(out.begin(), out.end(), [](const LockStats& a, const LockStats& b) {
+        if (a.wait_ns != b.wait_ns) return a.wait_ns > b.wait_ns;
+        return a.name < b.name;
+    });
+    return out;
+}
+#else
+std::vector<LockStats> lock_profile_snapshot() {
+    return {};
+}
+#endif
+
+void write_lock_profile(std::ostream& os) {
+    auto stats = lock_profile_snapshot();
+    if (stats.empty()) {
+        if (!kLockProfiling) os << "[LOCKS] lock profiling disabled (configure with -DSCHEDRT_LOCK_PROFILING=ON)\n";
+        return;
+    }
+    auto flags = os.flags();
+    os << "[LOCKS] " << std::left << std::setw(34) << "name" << std::right
+       << std::setw(12) << "acquire" << std::setw(12) << "contended" << std::setw(8) << "cont%"
+       << std::setw(12) << "wait_ms" << std::setw(12) << "max_wait_us"
+       << std::setw(12) << "hold_ms" << std::setw(12) << "avg_hold_ns" << "\n";
+    for (const auto& s : stats) {
+        double pct = s.acquisitions ? 100.0 * static_cast<double>(s.contended) / static_cast<double>(s.acquisitions) : 0.0;
+        os << "[LOCKS] " << std::left << std::setw(34) << s.name << std::right
+           << std::setw(12) << s.acquisitions << std::setw(12) << s.contended
+           << std::setw(8) << std::fixed << std::setprecision(1) << pct
+           << std::setw(12) << std::setprecision(3) << static_cast<double>(s.wait_ns) / 1e6
+           << std::setw(12) << std::setprecision(1) << static_cast<double>(s.max_wait_ns) / 1e3
+           << std::setw(12) << std::setprecision(3) << static_cast<double>(s.hold_ns) / 1e6
+           << std::setw(12) << (s.acquisitions ? s.hold_ns / s.acquisitions : 0) << "\n";
+    }
+    os.flags(flags);
+}
+
+} // namespace schedrt
@@ -0,0 +1,119 @@
+#include "schedrt/live_stats.hpp"
+
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace schedrt {
+namespace live {
+
+std::string normalize_name(const std::string& name) {
+    if (!name.empty() && name.front() == '/') return name;
+    return "/" + name;
+}
+
+uint64_t latency_percentile(const uint64_t (&hist)[kLatencyBuckets], double fraction) {
+    uint64_t total = 0;
+    for (auto c : hist) total += c;
+    if (total == 0) return 0;
+    uint64_t target = static_cast<uint64_t>(fraction * static_cast<double>(total));
+    if (target == 0) target = 1;
+    uint64_t seen = 0;
+    for (unsigned i = 0; i < kLatencyBuckets; ++i) {
+        seen += hist[i];
+        if (seen >= target) return (i + 1 < 64) ? (uint64_t{1} << (i + 1)) : UINT64_MAX;
+    }
+    return UINT64_MAX;
+}
+
+std::unique_ptr<Publisher> Publisher::create(const std::string& raw_name) {
+    std::string name = normalize_name(raw_name);
+    // Exclusive: a second runner on the same name would overwrite the first's
+    // counters and, exiting first, unlink its segment.
+    int fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+    if (fd < 0) {
+        std::cerr << "[live-stats] shm_open(" << name << ") failed: " << std::strerror(errno);
+        if (errno == EEXIST) std::cerr << " (another runner uses it, or a crashed one left /dev/shm" << name << ")";
+        std::cerr << "\n";
+        return nullptr;
+    }
+    if (ftruncate(fd, sizeof(Segment)) != 0) {
+        std::cerr << "[live-stats] ftruncate(" << name << ") failed: " << std::strerror(errno) << "\n";
+        close(fd);
+        shm_unlink(name.c_str());
+        return nullptr;
+    }
+    void* addr = mmap(nullptr, sizeof(Segment), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (addr == MAP_FAILED) {
+        std::cerr << "[live-stats] mmap(" << name << ") failed: " << std::strerror(errno) << "\n";
+        shm_unlink(name.c_str());
+        return nullptr;
+    }
+    auto* seg = static_cast<Segment*>(addr);
+    std::memset(static_cast<void*>(seg), 0, sizeof(Segment));
+    seg->version = kVersion;
+    // Magic last so a reader never accepts a half-initialised segment.
+    std::atomic_thread_fence(std::memory_order_release);
+    seg->magic = kMagic;
+    return std::unique_ptr<Publisher>(new Publisher(name, seg));
+}
+
+Publisher::~Publisher() {
+    munmap(seg_, sizeof(Segment));
+    shm_unlink(name_.c_str());
+}
+
+void Publisher::publish(const Snapshot& snap) {
+    uint64_t s = seg_->seq.load(std::memory_order_relaxed);
+    seg_->seq.store(s + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    std::memcpy(static_cast<void*>(&seg_->data), &snap, sizeof(Snapshot));
+    seg_->seq.store(s + 2, std::memory_order_release);
+}
+
+std::unique_ptr<Reader> Reader::open(const std::string& raw_name) {
+    std::string name = normalize_name(raw_name);
+    int fd = shm_open(name.c_str(), O_RDONLY, 0);
+    if (fd < 0) return nullptr;
+    // Mapping past the end of a shorter object faults on first read. It is
+    // shorter while the publisher sits between shm_open and ftruncate, or if
+    // the name belongs to something else.
+    struct stat st{};
+    if (fstat(fd, &st) != 0 || st.st_size < static_cast<off_t>(sizeof(Segment))) {
+        close(fd);
+        return nullptr;
+    }
+    void* addr = mmap(nullptr, sizeof(Segment), PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (addr == MAP_FAILED) return nullptr;
+    auto* seg = static_cast<const Segment*>(addr);
+    if (seg->magic != kMagic || seg->version != kVersion) {
+        munmap(addr, sizeof(Segment));
+        return nullptr;
+    }
+    return std::unique_ptr<Reader>(new Reader(seg));
+}
+
+Reader::~Reader() {
+    munmap(const_cast<Segment*>(seg_), sizeof(Segment));
+}
+
+bool Reader::read(Snapshot& out) const {
+    for (int attempt = 0; attempt < 1000; ++attempt) {
+        uint64_t before = seg_->seq.load(std::memory_order_acquire);
+        if (before == 0) return false;  // nothing published yet
+        if (before & 1) continue;
+        std::memcpy(&out, &seg_->data, sizeof(Snapshot));
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (seg_->seq.load(std::memory_order_relaxed) == before) return true;
+    }
+    return false;
+}
+
+} // namespace live
+} // namespace schedrt
@@ -0,0 +1,128 @@
+#include "schedrt/perf_counters.hpp"
+
+#include <atomic>
+#include <cstring>
+#include <vector>
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace schedrt {
+
+PerfSample& PerfSample::operator+=(const PerfSample& other) {
+    cycles += other.cycles;
+    instructions += other.instructions;
+    cache_misses += other.cache_misses;
+    context_switches += other.context_switches;
+    cpu_migrations += other.cpu_migrations;
+    available |= other.available;
+    return *this;
+}
+
+namespace perf {
+namespace {
+
+std::atomic<bool> g_enabled{false};
+
+struct EventSpec {
+    uint32_t type;
+    uint64_t config;
+    PerfSample::Counter counter;
+};
+
+constexpr EventSpec kEvents[] = {
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES, PerfSample::Cycles},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS, PerfSample::Instructions},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES, PerfSample::CacheMisses},
+    {PERF_TYPE_SOFTWARE, PERF_COUNT_SW_CONTEXT_SWITCHES, PerfSample::ContextSwitches},
+    {PERF_TYPE_SOFTWARE, PERF_COUNT_SW_CPU_MIGRATIONS, PerfSample::CpuMigrations},
+};
+
+int open_event(const EventSpec& spec, int group_fd) {
+    perf_event_attr attr;
+    std::memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = spec.type;
+    attr.config = spec.config;
+    attr.read_format = PERF_FORMAT_GROUP;
+    // Context switches and migrations happen in the kernel, so try to include
+    // it; fall back to user-only when perf_event_paranoid forbids that.
+    for (int exclude_kernel = 0; exclude_kernel <= 1; ++exclude_kernel) {
+        attr.exclude_kernel = exclude_kernel;
+        attr.exclude_hv = 1;
+        int fd = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, group_fd, 0));
+        if (fd >= 0) return fd;
+    }
+    return -1;
+}
+
+class ThreadGroup {
+public:
+    ThreadGroup() {
+        for (const auto& spec : kEvents) {
+            int fd = open_event(spec, leader_);
+            if (fd < 0) continue;
+            if (leader_ < 0) leader_ = fd;
+            fds_.push_back(fd);
+            order_.push_back(spec.counter);
+        }
+    }
+
+    ~ThreadGroup() {
+        for (int fd : fds_) close(fd);
+    }
+
+    PerfSample read() const {
+        PerfSample s;
+        if (leader_ < 0) return s;
+        uint64_t buf[1 + sizeof(kEvents) / sizeof(kEvents[0])] = {};
+        ssize_t want = static_cast<ssize_t>((1 + order_.size()) * sizeof(uint64_t));
+        if (::read(leader_, buf, sizeof(buf)) < want) return s;
+        for (size_t i = 0; i < order_.size() && i < buf[0]; ++i) {
+            uint64_t v = buf[1 + i];
+            switch (order_[i]) {
+            case PerfSample::Cycles: s.cycles = v; break;
+            case PerfSample::Instructions: s.instructions = v; break;
+            case PerfSample::CacheMisses: s.cache_misses = v; break;
+            case PerfSample::ContextSwitches: s.context_switches = v; break;
+            case PerfSample::CpuMigrations: s.cpu_migrations = v; break;
+            }
+            s.available |= order_[i];
+        }
+        return s;
+    }
+
+private:
+    int leader_{-1};
+    std::vector<int> fds_;
+    std::vector<PerfSample::Counter> order_;
+};
+
+} // namespace
+
+void set_enabled(bool value) {
+    g_enabled.store(value, std::memory_order_relaxed);
+}
+
+bool enabled() {
+    return g_enabled.load(std::memory_order_relaxed);
+}
+
+PerfSample read_thread_counters() {
+    thread_local ThreadGroup group;
+    return group.read();
+}
+
+PerfSample delta(const PerfSample& start, const PerfSample& end) {
+    PerfSample d;
+    d.available = start.available & end.available;
+    d.cycles = end.cycles - start.cycles;
+    d.instructions = end.instructions - start.instructions;
+    d.cache_misses = end.cache_misses - start.cache_misses;
+    d.context_switches = end.context_switches - start.context_switches;
+    d.cpu_migrations = end.cpu_migrations - start.cpu_migrations;
+    return d;
+}
+
+} // namespace perf
+} // namespace schedrt
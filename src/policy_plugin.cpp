@@ -0,0 +1,109 @@
+#include "schedrt/policy_plugin.hpp"
+
+#include <string>
+#include <vector>
+
+namespace schedrt {
+
+namespace {
+
+PolicyHooks g_hooks;
+
+// Owns the strings a PolicyState points into for the duration of a call.
+class StateSnapshot {
+public:
+    StateSnapshot(uint64_t ready_depth, unsigned workers, bool use_overlays) {
+        state_.ready_depth = ready_depth;
+        state_.workers = workers;
+        state_.use_overlays = use_overlays;
+    }
+
+    void add(Accelerator* acc) {
+        auto* slot = dynamic_cast<FpgaSlotAccelerator*>(acc);
+        names_.push_back(acc->name());
+        overlays_.push_back(slot ? slot->current_app() : std::string());
+        reconfigurable_.push_back(acc->is_reconfigurable());
+    }
+
+    const PolicyState& state() {
+        infos_.clear();
+        for (size_t i = 0; i < names_.size(); ++i)
+            infos_.push_back({names_[i].c_str(), overlays_[i].c_str(), reconfigurable_[i]});
+        state_.accelerators = infos_.data();
+        state_.num_accelerators = static_cast<uint32_t>(infos_.size());
+        return state_;
+    }
+
+private:
+    PolicyState state_{};
+    std::vector<std::string> names_;
+    std::vector<std::string> overlays_;
+    std::vector<bool> reconfigurable_;
+    std::vector<PolicyAcceleratorInfo> infos_;
+};
+
+} // namespace
+
+void set_policy_hooks(const PolicyHooks& hooks) { g_hooks = hooks; }
+
+const PolicyHooks& policy_hooks() { return g_hooks; }
+
+bool PluginOrder::before(const QueueKey& a, const QueueKey& b) {
+    return g_hooks.before ? g_hooks.before(g_hooks.user, a, b) : PriorityOrder::before(a, b);
+}
+
+Accelerator* PluginMapping::pick(const Task& task, const AppDescriptor& app, const MappingView& v) {
+    if (!g_hooks.map) return OverlayFirstMapping::pick(task, app, v);
+    std::vector<Accelerator*> candidates(v.cpu);
+    candidates.insert(candidates.end(), v.reconfigurable.begin(), v.reconfigurable.end());
+    StateSnapshot snap(v.ready_depth, v.workers, v.use_overlays);
+    for (auto* acc : candidates) snap.add(acc);
+
+    PolicyTaskInfo info;
+    info.id = task.id;
+    info.app = task.app.c_str();
+    auto key = queue_key(task);
+    info.priority = key.priority;
+    info.deadline = key.deadline;
+    info.release = key.release;
+    info.est_runtime_ns = task.est_runtime_ns.count();
+    info.required = task.required;
+    int idx = g_hooks.map(g_hooks.user, info, snap.state());
+    if (idx == kPolicyNone) return nullptr;
+    if (idx < 0 || static_cast<size_t>(idx) >= candidates.size()) return OverlayFirstMapping::pick(task, app, v);
+
+    Accelerator* acc = candidates[static_cast<size_t>(idx)];
+    if (auto* slot = dynamic_cast<FpgaSlotAccelerator*>(acc)) {
+        // A slot on the CPU backend never has an overlay to run.
+        if (!v.use_overlays) return OverlayFirstMapping::pick(task, app, v);
+        if (task.required != ResourceKind::CPU && slot->current_app() != task.app &&
+            !slot->ensure_app_loaded(app)) {
+            return OverlayFirstMapping::pick(task, app, v);
+        }
+    }
+    return acc;
+}
+
+// The hooks only see demand past the threshold, the plugin's if it set one;
+// below it an enqueue costs what it does under ThresholdPreload.
+bool PluginPreload::wants(int queued, unsigned threshold) {
+    return ThresholdPreload::wants(queued, g_hooks.preload_threshold ? g_hooks.preload_threshold : threshold);
+}
+
+void PluginPreload::load(const AppDescriptor& app, int queued, const PreloadView& v) {
+    if (!g_hooks.preload && !g_hooks.evict) return ThresholdPreload::load(app, queued, v);
+    StateSnapshot snap(v.ready_depth, v.workers, true);
+    for (auto* slot : v.slots) snap.add(slot);
+    const PolicyState& state = snap.state();
+    if (g_hooks.preload && !g_hooks.preload(g_hooks.user, app.app.c_str(), queued, state)) return;
+    int idx = g_hooks.evict ? g_hooks.evict(g_hooks.user, app.app.c_str(), state) : kPolicyDefault;
+    if (idx == kPolicyNone) return;
+    if (idx >= 0 && static_cast<size_t>(idx) < v.slots.size()) {
+        if (v.slots[static_cast<size_t>(idx)]->ensure_app_loaded(app)) return;
+    }
+    ThresholdPreload::load(app, queued, v);
+}
+
+template class BasicReadyQueue<PluginOrder>;
+
+} // namespace schedrt
@@ -0,0 +1,11 @@
+#include "schedrt/ready_queue.hpp"
+
+namespace schedrt {
+
+// The queue is defined in the header so custom builds can instantiate it on
+// their own orders; the stock ones are compiled here once.
+template class BasicReadyQueue<PriorityOrder>;
+template class BasicReadyQueue<EdfOrder>;
+template class BasicReadyQueue<FifoOrder>;
+
+} // namespace schedrt
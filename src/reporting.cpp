@@ -1,9 +1,16 @@
 #include "schedrt/reporting.hpp"
 
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <vector>
+
 namespace schedrt {
 namespace reporting {
 
 static std::atomic<bool> g_csv{false};
+static std::atomic<bool> g_quiet{false};
 
 void set_csv(bool value) {
     g_csv.store(value, std::memory_order_relaxed);
@@ -13,5 +20,122 @@ bool csv_enabled() {
     return g_csv.load(std::memory_order_relaxed);
 }
 
+void set_quiet(bool value) {
+    g_quiet.store(value, std::memory_order_relaxed);
+}
+
+bool quiet() {
+    return g_quiet.load(std::memory_order_relaxed);
+}
+
+void write_status(std::ostream& os, const Status& st, const std::string& app, std::string_view accelerator) {
+    const auto a = st.detail[0];
+    const auto b = st.detail[1];
+    switch (st.code) {
+    case StatusCode::Executed: os << "Executed " << app << " on " << accelerator; break;
+    case StatusCode::Cancelled: os << "cancelled"; break;
+    case StatusCode::UnknownApp: os << "Unknown app: " << app; break;
+    case StatusCode::NoAccelerator: os << "No accelerator available"; break;
+    case StatusCode::LoadFailed: os << "Failed to ensure " << app << " on " << accelerator; break;
+    case StatusCode::MissingContext: os << "fft: missing execution context"; break;
+    case StatusCode::ZipCompressed: os << "zip: compressed (" << a << " -> " << b << ")"; break;
+    case StatusCode::ZipDecompressed: os << "zip: decompressed (" << a << " -> " << b << ")"; break;
+    case StatusCode::ZipMissingBuffers: os << "zip: buffers missing"; break;
+    case StatusCode::ZipError: os << "zip: zlib error " << a; break;
+    case StatusCode::FftComputed: os << "fft: computed n=" << a; break;
+    case StatusCode::FftHw: os << "fft: hw n=" << a; break;
+    case StatusCode::FftBatch: os << "fft: batch of " << a << " n=" << b; break;
+    case StatusCode::FftHwBatch: os << "fft: hw batch of " << a << " n=" << b; break;
+    case StatusCode::FftMissingBuffers: os << "fft: missing buffers"; break;
+    case StatusCode::FftBufferTooSmall: os << "fft: buffer sizes insufficient"; break;
+    case StatusCode::FftUnsupported: os << "fft: unsupported length n=" << a; break;
+    case StatusCode::FftDmaFailure: os << "fft: hw DMA failure"; break;
+    case StatusCode::VecComputed: os << "vec: computed [" << a << ", " << b << ")"; break;
+    case StatusCode::VecInvalid: os << "vec: invalid job"; break;
+    case StatusCode::PeerNotConnected: os << "federation: " << accelerator << " not connected"; break;
+    case StatusCode::PeerSendFailed: os << "federation: " << accelerator << " send failed"; break;
+    case StatusCode::PeerLinkLost: os << "federation: " << accelerator << " link lost"; break;
+    case StatusCode::Stopped: os << "scheduler stopped"; break;
+    }
+    if (st.cpu_fallback) os << " (cpu fallback)";
+    if (st.hedge) os << " (hedge)";
+}
+
+std::string describe(const Status& status, const std::string& app, std::string_view accelerator) {
+    std::ostringstream os;
+    write_status(os, status, app, accelerator);
+    return os.str();
+}
+
+void write_perf_fields(std::ostream& os, const PerfSample& p) {
+    if (p.has(PerfSample::Cycles)) os << " cycles=" << p.cycles;
+    if (p.has(PerfSample::Instructions)) os << " instructions=" << p.instructions;
+    if (p.has(PerfSample::CacheMisses)) os << " cache_misses=" << p.cache_misses;
+    if (p.has(PerfSample::ContextSwitches)) os << " cs=" << p.context_switches;
+    if (p.has(PerfSample::CpuMigrations)) os << " migrations=" << p.cpu_migrations;
+}
+
+void write_app_metrics(std::ostream& os, const AppMetricsMap& metrics) {
+    std::vector<std::string> apps;
+    for (const auto& entry : metrics) apps.push_back(entry.first);
+    std::sort(apps.begin(), apps.end());
+    for (const auto& app : apps) {
+        const auto& m = metrics.at(app);
+        os << "[METRICS] app=" << app << " tasks=" << m.tasks << " failures=" << m.failures
+           << " avg_time_ns=" << (m.tasks ? m.total_runtime.count() / static_cast<long long>(m.tasks) : 0);
+        if (m.inline_tasks) os << " inline=" << m.inline_tasks;
+        if (m.perf_tasks) {
+            const auto& p = m.perf;
+            auto avg = [&](uint64_t v) { return v / m.perf_tasks; };
+            if (p.has(PerfSample::Cycles)) os << " avg_cycles=" << avg(p.cycles);
+            if (p.has(PerfSample::Instructions)) os << " avg_instructions=" << avg(p.instructions);
+            if (p.has(PerfSample::Cycles) && p.has(PerfSample::Instructions) && p.cycles) {
+                os << " ipc=" << std::fixed << std::setprecision(2)
+                   << static_cast<double>(p.instructions) / static_cast<double>(p.cycles)
+                   << std::defaultfloat;
+            }
+            if (p.has(PerfSample::CacheMisses)) os << " avg_cache_misses=" << avg(p.cache_misses);
+            if (p.has(PerfSample::ContextSwitches)) os << " context_switches=" << p.context_switches;
+            if (p.has(PerfSample::CpuMigrations)) os << " cpu_migrations=" << p.cpu_migrations;
+        }
+        os << "\n";
+    }
+}
+
+void write_memory_stats(std::ostream& os, const MemoryStats& s) {
+    os << "[MEMORY] host_peak=" << s.peak.host_bytes << " device_peak=" << s.peak.device_bytes
+       << " host_in_use=" << s.in_use.host_bytes << " device_in_use=" << s.in_use.device_bytes
+       << " deferred=" << s.deferred_total << "\n";
+}
+
+void write_hedge_stats(std::ostream& os, const HedgeStats& s) {
+    os << "[HEDGE] tasks=" << s.tasks << " launched=" << s.launched << " hedge_wins=" << s.hedge_wins
+       << " cancelled=" << s.cancelled << "\n";
+}
+
+namespace {
+
+void write_worker_line(std::ostream& os, const std::string& id, const WorkerTimes& t) {
+    uint64_t total = t.total_ns();
+    os << "[WORKER] id=" << id << " tasks=" << t.tasks << " wall_ms=" << std::fixed << std::setprecision(1)
+       << static_cast<double>(total) / 1e6;
+    for (unsigned i = 0; i < kWorkerPhases; ++i) {
+        double pct = total ? 100.0 * static_cast<double>(t.ns[i]) / static_cast<double>(total) : 0.0;
+        os << " " << to_string(static_cast<WorkerPhase>(i)) << "=" << pct << "%";
+    }
+    os << std::defaultfloat << "\n";
+}
+
+} // namespace
+
+void write_worker_times(std::ostream& os, const std::vector<WorkerTimes>& workers) {
+    WorkerTimes all;
+    for (size_t i = 0; i < workers.size(); ++i) {
+        write_worker_line(os, std::to_string(i), workers[i]);
+        all += workers[i];
+    }
+    if (workers.size() > 1) write_worker_line(os, "all", all);
+}
+
 } // namespace reporting
 } // namespace schedrt
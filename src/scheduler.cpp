@@ -1,86 +1,307 @@
 
+#include "schedrt/live_stats.hpp"
+#include "schedrt/policy_plugin.hpp"
+#include "schedrt/ready_queue.hpp"
 #include "schedrt/reporting.hpp"
 #include "schedrt/scheduler.hpp"
+#include "schedrt/worker_time.hpp"
 #include "dash/completion_bus.hpp"
+#include "dash/contexts.hpp"
 #include <algorithm>
+#include <cstring>
+#include <exception>
+#include <limits>
+#include <optional>
 #include <iostream>
 #include <set>
 #include <unordered_map>
 #include <vector>
+#include <unistd.h>
 
 namespace schedrt {
 
 class DependencyManager {
 public:
     void mark_complete(Task::TaskId id) {
-        std::lock_guard<std::mutex> lk(mu_);
+        std::lock_guard<InstrumentedMutex> lk(mu_);
         completed_.insert(id);
     }
+    bool is_complete(Task::TaskId id) const {
+        std::lock_guard<InstrumentedMutex> lk(mu_);
+        return completed_.count(id) != 0;
+    }
     bool deps_satisfied(const Task& t) const {
-        std::lock_guard<std::mutex> lk(mu_);
+        std::lock_guard<InstrumentedMutex> lk(mu_);
         for (auto d : t.depends_on) if (!completed_.count(d)) return false;
         return true;
     }
 private:
-    mutable std::mutex mu_;
+    mutable InstrumentedMutex mu_{"DependencyManager::mu_"};
     std::set<Task::TaskId> completed_;
 };
 
-class ReadyQueue {
+// Worker-side state mirrored into the live-stats segment. The worker is the
+// only writer; seq is odd while task_id/app are being swapped so the
+// publisher never pairs one task's id with another task's app name.
+struct WorkerLive {
+    static constexpr unsigned kAppWords = live::kNameLen / sizeof(uint64_t);
+    std::atomic<uint64_t> seq{0};
+    std::atomic<uint32_t> state{static_cast<uint32_t>(live::WorkerState::Idle)};
+    std::atomic<uint64_t> task_id{0};
+    std::atomic<uint64_t> app[kAppWords]{};
+    std::atomic<uint64_t> tasks{0};
+    std::atomic<uint64_t> busy_ns{0};
+
+    void begin(const Task& task) {
+        uint64_t words[kAppWords] = {};
+        std::memcpy(words, task.app.data(), std::min(task.app.size(), sizeof(words) - 1));
+        uint64_t s = seq.load(std::memory_order_relaxed);
+        seq.store(s + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        task_id.store(task.id, std::memory_order_relaxed);
+        for (unsigned i = 0; i < kAppWords; ++i) app[i].store(words[i], std::memory_order_relaxed);
+        state.store(static_cast<uint32_t>(live::WorkerState::Running), std::memory_order_relaxed);
+        seq.store(s + 2, std::memory_order_release);
+    }
+
+    void end(std::chrono::nanoseconds busy) {
+        state.store(static_cast<uint32_t>(live::WorkerState::Idle), std::memory_order_relaxed);
+        tasks.fetch_add(1, std::memory_order_relaxed);
+        busy_ns.fetch_add(static_cast<uint64_t>(busy.count()), std::memory_order_relaxed);
+    }
+
+    void snapshot(live::WorkerStats& out) const {
+        uint64_t words[kAppWords];
+        for (;;) {
+            uint64_t before = seq.load(std::memory_order_acquire);
+            if (before & 1) continue;
+            out.task_id = task_id.load(std::memory_order_relaxed);
+            out.state = static_cast<live::WorkerState>(state.load(std::memory_order_relaxed));
+            for (unsigned i = 0; i < kAppWords; ++i) words[i] = app[i].load(std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (seq.load(std::memory_order_relaxed) == before) break;
+        }
+        std::memcpy(out.app, words, sizeof(out.app));
+        out.app[sizeof(out.app) - 1] = '\0';
+        out.tasks = tasks.load(std::memory_order_relaxed);
+        out.busy_ns = busy_ns.load(std::memory_order_relaxed);
+    }
+};
+
+struct AcceleratorLive {
+    std::atomic<uint64_t> runs{0};
+    std::atomic<uint64_t> busy_ns{0};
+};
+
+// A task under the hedging policy. Attempt 0 runs where the task was
+// dispatched; attempt 1 is queued by the hedge watcher and runs elsewhere.
+// Both carry the task's id and write to private outputs; the first one to
+// succeed is committed and reported, and the other is cancelled.
+struct HedgeRace {
+    std::shared_ptr<Task> task;
+    AppDescriptor app;
+    Accelerator* primary{nullptr};
+    std::chrono::steady_clock::time_point trigger{std::chrono::steady_clock::time_point::max()};
+    std::shared_ptr<Task> attempts[2];
+    std::unique_ptr<dash::PrivateOutput> out[2];
+    std::atomic<bool> cancel[2]{};
+    InstrumentedMutex mu{"HedgeRace::mu"};
+    unsigned launched{1};
+    unsigned finished{0};
+    bool done{false};
+};
+
+// Recent successful runtimes of one app on the accelerators it was dispatched to.
+class RuntimeHistory {
 public:
-    void push(const std::shared_ptr<Task>& t) {
-        {
-            std::lock_guard<std::mutex> lk(mu_);
-            pq_.push(t);
+    static constexpr size_t kSize = 256;
+    static constexpr size_t kMinSamples = 8;
+
+    void add(std::chrono::nanoseconds t) {
+        if (ns_.size() < kSize) {
+            ns_.push_back(t.count());
+        } else {
+            ns_[next_] = t.count();
+            next_ = (next_ + 1) % kSize;
         }
-        cv_.notify_one();
     }
-    std::shared_ptr<Task> pop_blocking() {
-        std::unique_lock<std::mutex> lk(mu_);
-        cv_.wait(lk, [&]{ return stop_ || !pq_.empty(); });
-        if (stop_) return nullptr;
-        auto t = pq_.top(); pq_.pop(); return t;
+    std::optional<std::chrono::nanoseconds> percentile(double p) const {
+        if (ns_.size() < kMinSamples) return std::nullopt;
+        std::vector<int64_t> v = ns_;
+        size_t k = std::min(v.size() - 1, static_cast<size_t>(p * static_cast<double>(v.size())));
+        std::nth_element(v.begin(), v.begin() + static_cast<std::ptrdiff_t>(k), v.end());
+        return std::chrono::nanoseconds(v[k]);
     }
-    void stop() { { std::lock_guard<std::mutex> lk(mu_); stop_ = true; } cv_.notify_all(); }
 private:
-    std::priority_queue<std::shared_ptr<Task>, std::vector<std::shared_ptr<Task>>, TaskCompare> pq_;
-    std::mutex mu_;
-    std::condition_variable cv_;
-    bool stop_{false};
+    std::vector<int64_t> ns_;
+    size_t next_ = 0;
 };
 
+// Copy of `task` for one hedged attempt: same id and inputs, its own output
+// and cancellation flag, no dependencies or footprint of its own.
+std::shared_ptr<Task> make_attempt(const Task& task, const dash::PrivateOutput& out,
+                                   const std::atomic<bool>* cancel) {
+    auto a = std::make_shared<Task>();
+    a->id = task.id;
+    a->app = task.app;
+    a->priority = task.priority;
+    a->release_time = task.release_time;
+    a->deadline = task.deadline;
+    a->params = task.params;
+    a->est_runtime_ns = task.est_runtime_ns;
+    a->required = task.required;
+    a->effective_priority = task.effective_priority;
+    a->effective_deadline = task.effective_deadline;
+    a->cancel = cancel;
+    out.bind(*a);
+    return a;
+}
+
+// Set while this thread runs a task inline, so completions that submit more
+// work queue it instead of nesting further inline runs.
+thread_local bool t_running_inline = false;
+
+// Set for the lifetime of worker_loop; see Scheduler::on_worker_thread.
+thread_local bool t_on_worker = false;
+
+// What the Scheduler facade forwards to. The only virtual calls are these,
+// one per API call; SchedulerCore implements them for one PolicySet.
 class Scheduler::Impl {
 public:
-    Impl(ApplicationRegistry& reg, BackendMode mode, unsigned cpu_workers, unsigned overlay_preload_threshold)
-        : reg_(reg),
+    explicit Impl(SchedulerPolicy policy) : policy_(policy) {}
+    virtual ~Impl() = default;
+
+    SchedulerPolicy policy() const { return policy_; }
+
+    virtual void add_accelerator(std::unique_ptr<Accelerator> acc) = 0;
+    virtual bool enable_live_stats(const std::string& name, std::chrono::milliseconds period) = 0;
+    virtual void set_memory_budget(const MemoryBudget& budget) = 0;
+    virtual void set_priority_inheritance(bool enabled) = 0;
+    virtual void set_hedging(const HedgePolicy& policy) = 0;
+    virtual void set_inline_policy(const InlinePolicy& policy) = 0;
+    virtual void set_worker_accounting(bool enabled) = 0;
+    virtual std::vector<WorkerTimes> worker_times() = 0;
+    virtual HedgeStats hedge_stats() = 0;
+    virtual MemoryStats memory_stats() = 0;
+    virtual void submit(const std::shared_ptr<Task>& t) = 0;
+    virtual void post(std::function<void()> fn, int priority) = 0;
+    virtual void start() = 0;
+    virtual void stop() = 0;
+    virtual bool uses_overlays() const = 0;
+    virtual federation::LoadSummary load_summary() = 0;
+    virtual unsigned parallelism() const = 0;
+    virtual AppMetricsMap app_metrics() = 0;
+
+private:
+    SchedulerPolicy policy_;
+};
+
+namespace {
+
+// The scheduler proper, compiled per PolicySet P (policies.hpp) so that queue
+// comparisons, accelerator mapping and the preload check inline into the
+// worker loop. Stock instantiations are listed at the end of this file.
+template <class P>
+class SchedulerCore final : public Scheduler::Impl {
+public:
+    using Order = typename P::Order;
+    using Mapping = typename P::Mapping;
+    using Preload = typename P::Preload;
+
+    SchedulerCore(SchedulerPolicy policy, ApplicationRegistry& reg, BackendMode mode, unsigned cpu_workers,
+                  unsigned overlay_preload_threshold)
+        : Impl(policy),
+          reg_(reg),
           mode_(mode),
           cpu_workers_(cpu_workers ? cpu_workers : std::thread::hardware_concurrency()),
           overlay_preload_threshold_(overlay_preload_threshold) {}
 
-    ~Impl() { stop(); }
+    ~SchedulerCore() override { stop(); }
 
-    void add_accelerator(std::unique_ptr<Accelerator> acc) {
-        std::lock_guard<std::mutex> lk(mu_acc_);
+    void add_accelerator(std::unique_ptr<Accelerator> acc) override {
+        std::lock_guard<InstrumentedMutex> lk(mu_acc_);
         accelerators_.push_back(std::move(acc));
     }
 
-    void submit(const std::shared_ptr<Task>& t) {
+    bool enable_live_stats(const std::string& name, std::chrono::milliseconds period) override {
+        if (running_) return false;
+        live_ = live::Publisher::create(name);
+        live_period_ = period.count() > 0 ? period : std::chrono::milliseconds(250);
+        return live_ != nullptr;
+    }
+
+    void set_memory_budget(const MemoryBudget& budget) override {
+        std::lock_guard<InstrumentedMutex> lk(mu_mem_);
+        mem_budget_ = budget;
+        mem_limited_ = budget.host_bytes || budget.device_bytes;
+    }
+
+    void set_priority_inheritance(bool enabled) override {
+        if (!running_) inherit_ = enabled;
+    }
+
+    void set_hedging(const HedgePolicy& policy) override {
+        if (running_) return;
+        hedge_ = policy;
+        hedge_.percentile = std::clamp(hedge_.percentile, 0.0, 1.0);
+    }
+
+    void set_inline_policy(const InlinePolicy& policy) override {
+        if (!running_) inline_ = policy;
+    }
+
+    void set_worker_accounting(bool enabled) override {
+        if (!running_) account_ = enabled;
+    }
+
+    std::vector<WorkerTimes> worker_times() override {
+        std::vector<WorkerTimes> out;
+        if (!worker_clock_) return out;
+        for (unsigned i = 0; i < cpu_workers_; ++i) out.push_back(worker_clock_[i].read());
+        return out;
+    }
+
+    HedgeStats hedge_stats() override {
+        std::lock_guard<InstrumentedMutex> lk(mu_hedge_);
+        return hedge_stats_;
+    }
+
+    MemoryStats memory_stats() override {
+        std::lock_guard<InstrumentedMutex> lk(mu_mem_);
+        return mem_;
+    }
+
+    void submit(const std::shared_ptr<Task>& t) override {
+        if (live_) submitted_.fetch_add(1, std::memory_order_relaxed);
+        if (t->footprint.empty()) t->footprint = dash::task_footprint(*t);
+        track_submit(t);
         if (deps_.deps_satisfied(*t)) {
+            if (try_inline(t)) return;
             t->ready.store(true);
+            record_ready(t, +1);  // count before a worker can pop (and decrement) it
             ready_.push(t);
-            record_ready(t, +1);
         } else {
-            std::lock_guard<std::mutex> lk(mu_wait_);
+            std::lock_guard<InstrumentedMutex> lk(mu_wait_);
             waiting_.push_back(t);
         }
     }
 
-    void start() {
+    void post(std::function<void()> fn, int priority) override {
+        auto t = std::make_shared<Task>();
+        t->app = "resume";
+        t->priority = priority;
+        t->effective_priority = priority;
+        t->resume = std::move(fn);
+        t->ready.store(true);
+        ready_.push(t);
+    }
+
+    void start() override {
         if (running_.exchange(true)) return;
 
         bool fpga_ok = false;
         {
-            std::lock_guard<std::mutex> lk(mu_acc_);
+            std::lock_guard<InstrumentedMutex> lk(mu_acc_);
             for (auto& a : accelerators_) {
                 if (a->name().find("fpga") != std::string::npos && a->is_available()) {
                     fpga_ok = true; break;
@@ -93,39 +314,116 @@ public:
             }
         }
         use_cpu_ = (mode_ == BackendMode::CPU) || (mode_ == BackendMode::AUTO && !fpga_ok);
+        collect_perf_ = perf::enabled();
+        if (inline_.max_runtime.count() > 0 || inline_.max_bytes > 0) {
+            std::lock_guard<InstrumentedMutex> lk(mu_acc_);
+            for (auto& a : accelerators_) {
+                if (a->is_reconfigurable() || dynamic_cast<federation::RemoteNodeAccelerator*>(a.get())) continue;
+                inline_cpu_ = a.get();
+                break;
+            }
+        }
+
+        if (account_) worker_clock_ = std::make_unique<WorkerClock[]>(cpu_workers_);
+        if (live_) {
+            start_time_ = std::chrono::steady_clock::now();
+            worker_live_ = std::make_unique<WorkerLive[]>(cpu_workers_);
+            std::lock_guard<InstrumentedMutex> lk(mu_acc_);
+            acc_live_ = std::make_unique<AcceleratorLive[]>(accelerators_.size());
+            for (size_t i = 0; i < accelerators_.size(); ++i) acc_index_[accelerators_[i].get()] = i;
+        }
 
         // workers
         for (unsigned i = 0; i < cpu_workers_; ++i)
-            workers_.emplace_back([this]{ worker_loop(); });
+            workers_.emplace_back([this, i]{ worker_loop(i); });
 
         // dependency watcher
         dep_thread_ = std::thread([this]{ dep_loop(); });
+
+        if (live_) live_thread_ = std::thread([this]{ live_loop(); });
+        if (hedge_.enabled) hedge_thread_ = std::thread([this]{ hedge_loop(); });
     }
 
-    void stop() {
+    void stop() override {
         if (!running_.exchange(false)) return;
         ready_.stop();
         if (dep_thread_.joinable()) dep_thread_.join();
         for (auto& w : workers_) if (w.joinable()) w.join();
         workers_.clear();
+        if (hedge_thread_.joinable()) hedge_thread_.join();
+        settle_unrun();
+        {
+            std::lock_guard<InstrumentedMutex> lk(mu_hedge_);
+            races_.clear();
+            hedge_queued_.clear();  // duplicates still in the stopped queue
+        }
+        if (live_thread_.joinable()) {
+            live_thread_.join();
+            publish_live(std::chrono::steady_clock::now(), 0.0, true);  // final totals
+        }
+    }
+
+    bool uses_overlays() const override { return !use_cpu_; }
+
+    unsigned parallelism() const override { return running_ ? cpu_workers_ : 0; }
+
+    federation::LoadSummary load_summary() override {
+        federation::LoadSummary s;
+        s.ready_depth = ready_depth_.load(std::memory_order_relaxed);
+        s.workers = cpu_workers_;
+        if (use_cpu_) return s;
+        std::lock_guard<InstrumentedMutex> lk(mu_acc_);
+        for (auto& acc : accelerators_) {
+            auto* slot = dynamic_cast<FpgaSlotAccelerator*>(acc.get());
+            if (!slot || !acc->is_available()) continue;
+            auto app = slot->current_app();
+            if (!app.empty()) s.overlays.push_back(app);
+        }
+        return s;
+    }
+
+    AppMetricsMap app_metrics() override {
+        std::lock_guard<InstrumentedMutex> lk(io_);
+        return metrics_;
     }
 
 private:
     void record_ready(const std::shared_ptr<Task>& task, int delta);
+    void track_submit(const std::shared_ptr<Task>& task);
+    void track_complete(const Task& task);
+    void inherit(Task::TaskId id, int priority, std::optional<std::chrono::steady_clock::time_point> deadline);
+    bool raise(Task& t, int priority, const std::optional<std::chrono::steady_clock::time_point>& deadline);
+    bool admit_memory(const std::shared_ptr<Task>& task);
+    void release_memory(const Task& task);
+    void settle_unrun();
+    MemoryFootprint charged(const Task& task) const;
+    bool fits(const MemoryFootprint& used, const MemoryFootprint& need) const;
     Accelerator* select_accelerator(const std::shared_ptr<Task>& task, const AppDescriptor& app);
-    void maybe_preload(const std::string& app);
+    ExecutionResult run_on(Accelerator* acc, const Task& task, const AppDescriptor& app, WorkerLive* wl);
+    bool hedge_eligible(const Task& task) const;
+    bool try_inline(const std::shared_ptr<Task>& task);
+    std::shared_ptr<HedgeRace> begin_race(const std::shared_ptr<Task>& task, const AppDescriptor& app,
+                                          Accelerator* chosen);
+    std::shared_ptr<HedgeRace> take_duplicate(const Task& task);
+    void run_duplicate(const std::shared_ptr<HedgeRace>& race, WorkerLive* wl);
+    void finish_attempt(const std::shared_ptr<HedgeRace>& race, unsigned idx, ExecutionResult r);
+    Accelerator* select_hedge_target(const HedgeRace& race);
+    void hedge_loop();
+    void maybe_preload(const std::string& app, int queued);
+    void live_loop();
+    void publish_live(std::chrono::steady_clock::time_point now, double throughput, bool stopped);
 
     void dep_loop() {
         using namespace std::chrono_literals;
         while (running_) {
             {
-                std::lock_guard<std::mutex> lk(mu_wait_);
+                std::lock_guard<InstrumentedMutex> lk(mu_wait_);
                 auto it = waiting_.begin();
                 while (it != waiting_.end()) {
                         if (deps_.deps_satisfied(**it)) {
                             (*it)->ready.store(true);
-                            ready_.push(*it);
                             record_ready(*it, +1);
+                            ready_.push(*it);
                             it = waiting_.erase(it);
                     } else {
                         ++it;
@@ -136,74 +434,225 @@ private:
         }
     }
 
-    void worker_loop() {
+    void worker_loop(unsigned index) {
+        WorkerLive* wl = live_ ? &worker_live_[index] : nullptr;
+        WorkerClock* clock = worker_clock_ ? &worker_clock_[index] : nullptr;
+        t_on_worker = true;
+        if (clock) {
+            clock->start();
+            set_current_worker_clock(clock);
+        }
         while (running_) {
+            if (clock) clock->enter(WorkerPhase::Idle);
             auto task = ready_.pop_blocking();
+            if (clock) clock->enter(WorkerPhase::Other);
             if (!task) break;
+            if (clock) clock->count_task();
+            if (task->resume) {
+                WorkerPhaseScope exec(WorkerPhase::Execute);
+                task->resume();
+                continue;
+            }
             record_ready(task, -1);
+            if (hedge_.enabled) {
+                if (auto race = take_duplicate(*task)) {
+                    run_duplicate(race, wl);
+                    continue;
+                }
+            }
+            if (!admit_memory(task)) continue;  // parked until running tasks release memory
 
             auto appOpt = reg_.lookup(task->app);
-            if (!appOpt) { report({task->id, false, "Unknown app: " + task->app, std::chrono::milliseconds(0), "none"}); continue; }
+            if (!appOpt) {
+                release_memory(*task);
+                report(*task, {task->id, false, {StatusCode::UnknownApp}, std::chrono::milliseconds(0), "none"});
+                continue;
+            }
             auto app = *appOpt;
 
-            Accelerator* chosen = select_accelerator(task, app);
+            Accelerator* chosen;
+            {
+                WorkerPhaseScope select(WorkerPhase::Select);
+                chosen = select_accelerator(task, app);
+            }
             if (!chosen) {
-                report({task->id, false, "No accelerator available", std::chrono::milliseconds(0), "none"});
+                release_memory(*task);
+                report(*task, {task->id, false, {StatusCode::NoAccelerator}, std::chrono::milliseconds(0), "none"});
                 continue;
             }
 
-            auto r = chosen->run(*task, app);
-            report(r);
+            if (auto* remote = dynamic_cast<federation::RemoteNodeAccelerator*>(chosen)) {
+                // Completion arrives on the peer link's thread; this worker moves on.
+                remote->forward(*task, app, [this, task, remote](const ExecutionResult& r) {
+                    release_memory(*task);
+                    if (!r.ok && !remote->is_available() && running_) {
+                        // Link dropped mid-flight: run it here instead of failing it.
+                        task->params[federation::kOriginKey] = "requeued";
+                        submit(task);
+                        return;
+                    }
+                    report(*task, r);
+                    if (r.ok) deps_.mark_complete(task->id);
+                });
+                continue;
+            }
+
+            if (hedge_.enabled && hedge_eligible(*task)) {
+                if (auto race = begin_race(task, app, chosen)) {
+                    finish_attempt(race, 0, run_on(chosen, *race->attempts[0], app, wl));
+                    continue;
+                }
+            }
+
+            auto r = run_on(chosen, *task, app, wl);
+            release_memory(*task);
+            report(*task, r);
             if (r.ok) deps_.mark_complete(task->id);
         }
+        if (clock) {
+            clock->stop();
+            set_current_worker_clock(nullptr);
+        }
+        t_on_worker = false;
     }
 
-    void report(const ExecutionResult& r) {
-        std::lock_guard<std::mutex> lk(io_);
-            bool used_fpga = r.accelerator.find("fpga") != std::string::npos;
-            if (schedrt::reporting::csv_enabled()) {
+    void report(const Task& task, const ExecutionResult& r) {
+        WorkerPhaseScope phase(WorkerPhase::Report);
+        track_complete(task);
+        if (live_) record_live_completion(task, r);
+        lock_accounted(io_);
+        std::lock_guard<InstrumentedMutex> lk(io_, std::adopt_lock);
+            bool used_fpga = std::strstr(r.accelerator, "fpga") != nullptr;
+            if (schedrt::reporting::quiet()) {
+                // counted below, not printed
+            } else if (schedrt::reporting::csv_enabled()) {
                 std::cout << r.id << "," << (r.ok ? "true" : "false") << ","
-                          << r.accelerator << ",\"" << r.message << "\","
+                          << r.accelerator << ",\"";
+                schedrt::reporting::write_status(std::cout, r.status, task.app, r.accelerator);
+                std::cout << "\","
                           << r.runtime_ns.count() << "," << (used_fpga ? "fpga" : "cpu") << "\n";
             } else {
                 std::cout << "[RESULT] Task " << r.id << " ok=" << (r.ok ? "true" : "false")
-                          << " accel=\"" << r.accelerator << "\" msg=\"" << r.message
-                          << "\" time_ns=" << r.runtime_ns.count()
-                          << " (" << (used_fpga ? "fpga" : "cpu") << ")\n";
+                          << " accel=\"" << r.accelerator << "\" msg=\"";
+                schedrt::reporting::write_status(std::cout, r.status, task.app, r.accelerator);
+                std::cout << "\" time_ns=" << r.runtime_ns.count()
+                          << " (" << (used_fpga ? "fpga" : "cpu") << ")";
+                if (r.perf.valid()) schedrt::reporting::write_perf_fields(std::cout, r.perf);
+                std::cout << "\n";
+            }
+            auto& m = metrics_[task.app];
+            ++m.tasks;
+            if (!r.ok) ++m.failures;
+            if (t_running_inline) ++m.inline_tasks;
+            m.total_runtime += r.runtime_ns;
+            if (r.perf.valid()) {
+                ++m.perf_tasks;
+                m.perf += r.perf;
             }
         dash::fulfill(r.id, r.ok);
+        if (task.on_complete) task.on_complete(r);
+    }
+
+    void record_live_completion(const Task& task, const ExecutionResult& r) {
+        auto latency = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - task.release_time).count();
+        uint64_t ns = latency > 0 ? static_cast<uint64_t>(latency) : 1;
+        unsigned bucket = 63u - static_cast<unsigned>(__builtin_clzll(ns));
+        if (bucket >= live::kLatencyBuckets) bucket = live::kLatencyBuckets - 1;
+        latency_hist_[bucket].fetch_add(1, std::memory_order_relaxed);
+        uint64_t cur = latency_max_.load(std::memory_order_relaxed);
+        while (ns > cur && !latency_max_.compare_exchange_weak(cur, ns, std::memory_order_relaxed)) {}
+        completed_.fetch_add(1, std::memory_order_relaxed);
+        if (!r.ok) failed_.fetch_add(1, std::memory_order_relaxed);
     }
 
 private:
     ApplicationRegistry& reg_;
     BackendMode mode_;
     bool use_cpu_{true};
+    bool collect_perf_{false};
     unsigned cpu_workers_;
     unsigned overlay_preload_threshold_;
     std::unordered_map<std::string, int> ready_app_counts_;
-    std::mutex ready_counts_mu_;
+    InstrumentedMutex ready_counts_mu_{"Scheduler::ready_counts_mu_"};
 
     std::atomic<bool> running_{false};
-    ReadyQueue ready_;
+    BasicReadyQueue<Order> ready_;
     DependencyManager deps_;
 
-    std::mutex mu_acc_;
+    InstrumentedMutex mu_acc_{"Scheduler::mu_acc_"};
     std::vector<std::unique_ptr<Accelerator>> accelerators_;
 
-    std::mutex mu_wait_;
+    InstrumentedMutex mu_wait_{"Scheduler::mu_wait_"};
     std::vector<std::shared_ptr<Task>> waiting_;
 
     std::vector<std::thread> workers_;
     std::thread dep_thread_;
 
-    std::mutex io_;
+    InstrumentedMutex io_{"Scheduler::io_"};
+    AppMetricsMap metrics_;
+    std::atomic<uint64_t> ready_depth_{0};  // also advertised to federation peers
+
+    // Priority inheritance. inherit_ is fixed before start(); the maps are
+    // guarded by mu_graph_, which is also held for every raise().
+    struct Inherited {
+        int priority;
+        std::optional<std::chrono::steady_clock::time_point> deadline;
+    };
+    bool inherit_{true};
+    InstrumentedMutex mu_graph_{"Scheduler::mu_graph_"};
+    std::unordered_map<Task::TaskId, std::shared_ptr<Task>> pending_;  // submitted, not yet reported
+    std::unordered_map<Task::TaskId, Inherited> early_;  // lent to prerequisites not submitted yet
+
+    // Inline fast path; both fixed at start().
+    InlinePolicy inline_;
+    Accelerator* inline_cpu_{nullptr};  // first local CPU provider, null when the path is off
+
+    // Worker time accounting; clocks exist only when account_ was set before start().
+    bool account_{false};
+    std::unique_ptr<WorkerClock[]> worker_clock_;
+
+    // Hedged execution. hedge_ is fixed before start(); the rest is guarded
+    // by mu_hedge_, which is taken before a race's own mutex, never after.
+    HedgePolicy hedge_;
+    std::thread hedge_thread_;
+    InstrumentedMutex mu_hedge_{"Scheduler::mu_hedge_"};
+    std::vector<std::shared_ptr<HedgeRace>> races_;  // primaries the watcher may still hedge
+    std::unordered_map<const Task*, std::shared_ptr<HedgeRace>> hedge_queued_;  // duplicates in ready_
+    std::unordered_map<std::string, RuntimeHistory> runtime_history_;
+    HedgeStats hedge_stats_;
+
+    // Memory admission. mem_limited_ is fixed before start(); the rest is guarded by mu_mem_.
+    bool mem_limited_{false};
+    InstrumentedMutex mu_mem_{"Scheduler::mu_mem_"};
+    MemoryBudget mem_budget_;
+    MemoryStats mem_;
+    std::vector<std::shared_ptr<Task>> mem_deferred_;  // heap in dispatch order; raise() nests mu_mem_ in mu_graph_
+
+    // Live statistics; everything below stays untouched unless enable_live_stats() succeeded.
+    std::unique_ptr<live::Publisher> live_;
+    std::chrono::milliseconds live_period_{250};
+    std::thread live_thread_;
+    std::chrono::steady_clock::time_point start_time_{};
+    std::unique_ptr<WorkerLive[]> worker_live_;
+    std::unique_ptr<AcceleratorLive[]> acc_live_;
+    std::unordered_map<const Accelerator*, size_t> acc_index_;  // frozen at start()
+    std::atomic<uint64_t> submitted_{0};
+    std::atomic<uint64_t> completed_{0};
+    std::atomic<uint64_t> failed_{0};
+    std::atomic<uint64_t> latency_max_{0};
+    std::atomic<uint64_t> latency_hist_[live::kLatencyBuckets]{};
 };
 
-void Scheduler::Impl::record_ready(const std::shared_ptr<Task>& task, int delta) {
+template <class P>
+void SchedulerCore<P>::record_ready(const std::shared_ptr<Task>& task, int delta) {
     if (delta == 0) return;
+    ready_depth_.fetch_add(static_cast<uint64_t>(static_cast<int64_t>(delta)), std::memory_order_relaxed);
+    if constexpr (!Preload::kTracksDemand) return;
     std::string high_demand_app;
+    int queued = 0;
     {
-        std::lock_guard<std::mutex> lk(ready_counts_mu_);
+        std::lock_guard<InstrumentedMutex> lk(ready_counts_mu_);
         auto it = ready_app_counts_.find(task->app);
         int count = it != ready_app_counts_.end() ? it->second : 0;
         count = std::max(0, count + delta);
@@ -211,22 +660,204 @@ void Scheduler::Impl::record_ready(const std::shared_ptr<Task>& task, int delta)
             ready_app_counts_.erase(task->app);
         } else {
             ready_app_counts_[task->app] = count;
-            if (delta > 0 && overlay_preload_threshold_ > 0 && count >= static_cast<int>(overlay_preload_threshold_)) {
+            if (delta > 0 && Preload::wants(count, overlay_preload_threshold_)) {
                 high_demand_app = task->app;
+                queued = count;
+            }
+        }
+    }
+    if (!high_demand_app.empty()) maybe_preload(high_demand_app, queued);
+}
+
+template <class P>
+void SchedulerCore<P>::track_submit(const std::shared_ptr<Task>& task) {
+    if (!inherit_) {
+        task->effective_priority = task->priority;
+        task->effective_deadline = task->deadline;
+        return;
+    }
+    std::lock_guard<InstrumentedMutex> lk(mu_graph_);
+    // A task requeued after a dropped federation link keeps what it inherited.
+    if (!pending_.emplace(task->id, task).second) return;
+    task->effective_priority = task->priority;
+    task->effective_deadline = task->deadline;
+    auto early = early_.find(task->id);
+    if (early != early_.end()) {
+        ready_.raise(*task, early->second.priority, early->second.deadline);
+        early_.erase(early);
+    }
+    for (auto dep : task->depends_on) inherit(dep, task->effective_priority, task->effective_deadline);
+}
+
+template <class P>
+void SchedulerCore<P>::track_complete(const Task& task) {
+    if (!inherit_) return;
+    std::lock_guard<InstrumentedMutex> lk(mu_graph_);
+    pending_.erase(task.id);
+}
+
+// Lends (priority, deadline) to task `id` and, through every task whose
+// effective values rise as a result, to its own prerequisites. Caller holds
+// mu_graph_. Iterative so long dependency chains cannot exhaust the stack.
+template <class P>
+void SchedulerCore<P>::inherit(Task::TaskId id, int priority,
+                               std::optional<std::chrono::steady_clock::time_point> deadline) {
+    std::vector<std::pair<Task::TaskId, Inherited>> work{{id, {priority, deadline}}};
+    while (!work.empty()) {
+        auto [dep, lent] = work.back();
+        work.pop_back();
+        auto it = pending_.find(dep);
+        if (it == pending_.end()) {
+            if (deps_.is_complete(dep)) continue;
+            auto [e, fresh] = early_.try_emplace(dep, lent);
+            if (!fresh) {
+                e->second.priority = std::max(e->second.priority, lent.priority);
+                if (lent.deadline && (!e->second.deadline || *lent.deadline < *e->second.deadline))
+                    e->second.deadline = lent.deadline;
             }
+            continue;
         }
+        Task& t = *it->second;
+        if (!raise(t, lent.priority, lent.deadline)) continue;
+        for (auto up : t.depends_on) work.push_back({up, {t.effective_priority, t.effective_deadline}});
     }
-    if (!high_demand_app.empty()) maybe_preload(high_demand_app);
 }
 
-Accelerator* Scheduler::Impl::select_accelerator(const std::shared_ptr<Task>& task, const AppDescriptor& app) {
+// ReadyQueue::raise, plus restoring the parked heap in case t waits there
+// (ready_.park). The heap compares effective fields under mu_mem_, so they
+// only change under it. Re-heapifying is linear in the parked tasks, which
+// are few next to the queue.
+template <class P>
+bool SchedulerCore<P>::raise(Task& t, int priority,
+                             const std::optional<std::chrono::steady_clock::time_point>& deadline) {
+    if (!mem_limited_) return ready_.raise(t, priority, deadline);
+    std::lock_guard<InstrumentedMutex> lk(mu_mem_);
+    if (!ready_.raise(t, priority, deadline)) return false;
+    std::make_heap(mem_deferred_.begin(), mem_deferred_.end(), TaskOrder<Order>{});
+    return true;
+}
+
+template <class P>
+MemoryFootprint SchedulerCore<P>::charged(const Task& task) const {
+    MemoryFootprint fp = task.footprint;
+    if (use_cpu_) fp.device_bytes = 0;  // nothing is staged for an overlay
+    return fp;
+}
+
+template <class P>
+bool SchedulerCore<P>::fits(const MemoryFootprint& used, const MemoryFootprint& need) const {
+    // An idle pool takes any task, so one larger than the budget still runs (alone).
+    auto pool_fits = [](uint64_t in_use, uint64_t bytes, uint64_t cap) {
+        return cap == 0 || bytes == 0 || in_use == 0 || in_use + bytes <= cap;
+    };
+    return pool_fits(used.host_bytes, need.host_bytes, mem_budget_.host_bytes) &&
+           pool_fits(used.device_bytes, need.device_bytes, mem_budget_.device_bytes);
+}
+
+template <class P>
+bool SchedulerCore<P>::admit_memory(const std::shared_ptr<Task>& task) {
+    if (!mem_limited_) return true;
+    MemoryFootprint need = charged(*task);
+    if (need.empty()) return true;
+    std::lock_guard<InstrumentedMutex> lk(mu_mem_);
+    // Queue behind parked tasks of equal or higher priority so large tasks
+    // are not starved by a stream of small ones. With nothing running there
+    // is nothing to wait for.
+    bool behind = !mem_deferred_.empty() && !TaskOrder<Order>{}(mem_deferred_.front(), task);
+    if (mem_.in_use.empty() || (!behind && fits(mem_.in_use, need))) {
+        mem_.in_use.host_bytes += need.host_bytes;
+        mem_.in_use.device_bytes += need.device_bytes;
+        mem_.peak.host_bytes = std::max(mem_.peak.host_bytes, mem_.in_use.host_bytes);
+        mem_.peak.device_bytes = std::max(mem_.peak.device_bytes, mem_.in_use.device_bytes);
+        return true;
+    }
+    ready_.park(*task);
+    mem_deferred_.push_back(task);
+    std::push_heap(mem_deferred_.begin(), mem_deferred_.end(), TaskOrder<Order>{});
+    mem_.deferred_now = mem_deferred_.size();
+    ++mem_.deferred_total;
+    return false;
+}
+
+template <class P>
+void SchedulerCore<P>::release_memory(const Task& task) {
+    if (!mem_limited_) return;
+    MemoryFootprint freed = charged(task);
+    if (freed.empty()) return;
+    std::vector<std::shared_ptr<Task>> wake;
+    {
+        std::lock_guard<InstrumentedMutex> lk(mu_mem_);
+        mem_.in_use.host_bytes -= freed.host_bytes;
+        mem_.in_use.device_bytes -= freed.device_bytes;
+        // Requeue the parked tasks that now fit, highest priority first. They
+        // are charged again when a worker pops them.
+        MemoryFootprint pending = mem_.in_use;
+        while (!mem_deferred_.empty()) {
+            MemoryFootprint need = charged(*mem_deferred_.front());
+            if (!fits(pending, need)) break;
+            pending.host_bytes += need.host_bytes;
+            pending.device_bytes += need.device_bytes;
+            std::pop_heap(mem_deferred_.begin(), mem_deferred_.end(), TaskOrder<Order>{});
+            wake.push_back(std::move(mem_deferred_.back()));
+            mem_deferred_.pop_back();
+        }
+        mem_.deferred_now = mem_deferred_.size();
+    }
+    for (auto& t : wake) {
+        record_ready(t, +1);
+        ready_.push(t);
+    }
+}
+
+// Called by stop() once the workers and the dependency thread are gone.
+// Nothing will run what is still queued, parked or waiting on prerequisites,
+// so continuations resume on this thread and tasks fail with Stopped;
+// otherwise a sync_wait or completion future waiting on them would never
+// return. Whatever that queues in turn (a resumed coroutine's next op, say)
+// is settled by the same loop.
+template <class P>
+void SchedulerCore<P>::settle_unrun() {
+    std::vector<std::shared_ptr<Task>> unrun;
+    {
+        std::lock_guard<InstrumentedMutex> lk(mu_mem_);
+        unrun.swap(mem_deferred_);
+        mem_.deferred_now = 0;
+    }
+    {
+        std::lock_guard<InstrumentedMutex> lk(mu_wait_);
+        unrun.insert(unrun.end(), waiting_.begin(), waiting_.end());
+        waiting_.clear();
+    }
+    for (auto& t : unrun) report(*t, {t->id, false, {StatusCode::Stopped}, std::chrono::nanoseconds(0), "none"});
+    while (auto t = ready_.try_pop()) {
+        if (t->resume) {
+            t->resume();
+            continue;
+        }
+        record_ready(t, -1);
+        ExecutionResult r{t->id, false, {StatusCode::Stopped}, std::chrono::nanoseconds(0), "none"};
+        if (hedge_.enabled) {
+            if (auto race = take_duplicate(*t)) {
+                finish_attempt(race, 1, std::move(r));
+                continue;
+            }
+        }
+        report(*t, r);
+    }
+}
+
+template <class P>
+Accelerator* SchedulerCore<P>::select_accelerator(const std::shared_ptr<Task>& task, const AppDescriptor& app) {
     std::vector<Accelerator*> cpu_candidates;
     std::vector<Accelerator*> reconfigurable;
+    std::vector<federation::RemoteNodeAccelerator*> remotes;
     {
-        std::lock_guard<std::mutex> lk(mu_acc_);
+        std::lock_guard<InstrumentedMutex> lk(mu_acc_);
         for (auto& acc : accelerators_) {
             if (!acc->is_available()) continue;
-            if (acc->is_reconfigurable()) {
+            if (auto* remote = dynamic_cast<federation::RemoteNodeAccelerator*>(acc.get())) {
+                remotes.push_back(remote);
+            } else if (acc->is_reconfigurable()) {
                 reconfigurable.push_back(acc.get());
             } else {
                 cpu_candidates.push_back(acc.get());
@@ -234,29 +865,253 @@ Accelerator* Scheduler::Impl::select_accelerator(const std::shared_ptr<Task>& ta
         }
     }
 
-    if (!use_cpu_ && task->required != ResourceKind::CPU) {
-        for (auto* acc : reconfigurable) {
-            auto* slot = dynamic_cast<FpgaSlotAccelerator*>(acc);
-            if (!slot) continue;
-            if (slot->current_app() == task->app || slot->ensure_app_loaded(app)) {
-                return acc;
+    // Federation: tasks that came from a peer always run here.
+    if (!remotes.empty() && !task->params.count(federation::kOriginKey)) {
+        federation::LocalLoad local;
+        local.ready_depth = ready_depth_.load(std::memory_order_relaxed);
+        local.workers = cpu_workers_;
+        if (!use_cpu_) {
+            for (auto* acc : reconfigurable) {
+                auto* slot = dynamic_cast<FpgaSlotAccelerator*>(acc);
+                if (slot && slot->current_app() == task->app) { local.overlay_resident = true; break; }
             }
         }
+        for (auto* remote : remotes) {
+            if (remote->should_forward(*task, local)) return remote;
+        }
+    }
+
+    return Mapping::pick(*task, app, {cpu_candidates, reconfigurable, !use_cpu_,
+                                      ready_depth_.load(std::memory_order_relaxed), cpu_workers_});
+}
+
+template <class P>
+ExecutionResult SchedulerCore<P>::run_on(Accelerator* acc, const Task& task, const AppDescriptor& app,
+                                         WorkerLive* wl) {
+    WorkerPhaseScope exec(WorkerPhase::Execute);
+    if (wl) wl->begin(task);
+    auto run_start = wl ? std::chrono::steady_clock::now() : std::chrono::steady_clock::time_point{};
+    ExecutionResult r;
+    if (collect_perf_) {
+        auto before = perf::read_thread_counters();
+        r = acc->run(task, app);
+        r.perf = perf::delta(before, perf::read_thread_counters());
+    } else {
+        r = acc->run(task, app);
+    }
+    if (wl) {
+        auto busy = std::chrono::steady_clock::now() - run_start;
+        wl->end(busy);
+        auto it = acc_index_.find(acc);
+        if (it != acc_index_.end()) {
+            acc_live_[it->second].runs.fetch_add(1, std::memory_order_relaxed);
+            acc_live_[it->second].busy_ns.fetch_add(
+                static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(busy).count()),
+                std::memory_order_relaxed);
+        }
     }
+    return r;
+}
+
+// Runs task on the submitting thread when it is small, bound for a CPU
+// provider and nothing queued would be dispatched first. That skips the
+// queue handoff, the worker wakeup and the accelerator scan; completion
+// goes through report() as usual. False leaves the task to the caller.
+template <class P>
+bool SchedulerCore<P>::try_inline(const std::shared_ptr<Task>& task) {
+    if (!inline_cpu_ || !running_ || t_running_inline) return false;
+    bool small = task->footprint.host_bytes > 0
+        ? inline_.max_bytes > 0 && task->footprint.host_bytes <= inline_.max_bytes
+        : inline_.max_runtime.count() > 0 && task->est_runtime_ns.count() > 0 &&
+              task->est_runtime_ns <= inline_.max_runtime;
+    if (!small) return false;
+    if (!use_cpu_ && task->required != ResourceKind::CPU) return false;
+    if (hedge_.enabled && hedge_eligible(*task)) return false;
+    if (ready_.outranks(*task)) return false;
+    auto app = reg_.lookup(task->app);
+    if (!app) return false;
+    task->ready.store(true);
+    if (!admit_memory(task)) return true;  // parked; a worker runs it once memory frees up
+
+    t_running_inline = true;
+    auto r = run_on(inline_cpu_, *task, *app, nullptr);
+    release_memory(*task);
+    report(*task, r);
+    t_running_inline = false;
+    if (r.ok) deps_.mark_complete(task->id);
+    return true;
+}
+
+template <class P>
+bool SchedulerCore<P>::hedge_eligible(const Task& task) const {
+    return task.hedge || std::find(hedge_.apps.begin(), hedge_.apps.end(), task.app) != hedge_.apps.end();
+}
+
+template <class P>
+std::shared_ptr<HedgeRace> SchedulerCore<P>::begin_race(const std::shared_ptr<Task>& task,
+                                                        const AppDescriptor& app, Accelerator* chosen) {
+    auto out = dash::PrivateOutput::create(*task);
+    if (!out) return nullptr;
+    auto race = std::make_shared<HedgeRace>();
+    race->task = task;
+    race->app = app;
+    race->primary = chosen;
+    race->out[0] = std::move(out);
+    race->attempts[0] = make_attempt(*task, *race->out[0], &race->cancel[0]);
+    auto now = std::chrono::steady_clock::now();
+    std::lock_guard<InstrumentedMutex> lk(mu_hedge_);
+    std::optional<std::chrono::nanoseconds> expected;
+    auto hist = runtime_history_.find(task->app);
+    if (hist != runtime_history_.end()) expected = hist->second.percentile(hedge_.percentile);
+    if (!expected && task->est_runtime_ns.count() > 0) expected = task->est_runtime_ns;
+    if (expected) race->trigger = now + *expected;
+    races_.push_back(race);
+    ++hedge_stats_.tasks;
+    return race;
+}
+
+template <class P>
+std::shared_ptr<HedgeRace> SchedulerCore<P>::take_duplicate(const Task& task) {
+    std::lock_guard<InstrumentedMutex> lk(mu_hedge_);
+    auto it = hedge_queued_.find(&task);
+    if (it == hedge_queued_.end()) return nullptr;
+    auto race = std::move(it->second);
+    hedge_queued_.erase(it);
+    return race;
+}
+
+template <class P>
+void SchedulerCore<P>::run_duplicate(const std::shared_ptr<HedgeRace>& race, WorkerLive* wl) {
+    const Task& attempt = *race->attempts[1];
+    ExecutionResult r{attempt.id, false, {StatusCode::Cancelled}, std::chrono::nanoseconds(0), "none"};
+    // Skip it outright if the primary finished while this sat in the queue.
+    if (!cancelled(attempt)) {
+        if (auto* acc = select_hedge_target(*race)) {
+            r = run_on(acc, attempt, race->app, wl);
+        } else {
+            r.status.code = StatusCode::NoAccelerator;
+        }
+    }
+    finish_attempt(race, 1, std::move(r));
+}
+
+// The first success wins; a failure only ends the race once no other attempt
+// is still running. Later attempts are counted as cancelled and dropped.
+template <class P>
+void SchedulerCore<P>::finish_attempt(const std::shared_ptr<HedgeRace>& race, unsigned idx, ExecutionResult r) {
+    bool won = false;
+    bool lost = false;
+    {
+        std::lock_guard<InstrumentedMutex> lk(race->mu);
+        ++race->finished;
+        lost = race->done;
+        if (!race->done && (r.ok || race->finished >= race->launched)) {
+            race->done = won = true;
+            race->cancel[idx ^ 1u].store(true, std::memory_order_relaxed);
+            race->out[idx]->commit();
+        }
+    }
+    {
+        std::lock_guard<InstrumentedMutex> lk(mu_hedge_);
+        if (idx == 0 && r.ok) runtime_history_[race->task->app].add(r.runtime_ns);
+        if (won) {
+            auto it = std::find(races_.begin(), races_.end(), race);
+            if (it != races_.end()) races_.erase(it);
+            if (idx == 1 && r.ok) ++hedge_stats_.hedge_wins;
+        } else if (lost) {
+            ++hedge_stats_.cancelled;
+        }
+    }
+    if (!won) return;
+    if (idx == 1) r.status.hedge = true;
+    Task& task = *race->task;
+    release_memory(task);
+    report(task, r);
+    if (r.ok) deps_.mark_complete(task.id);
+}
 
+// Prefers another slot that already holds the overlay, then another CPU
+// provider, then any other slot. The primary's own accelerator is never a
+// target: with nothing else available there is no duplicate (null).
+template <class P>
+Accelerator* SchedulerCore<P>::select_hedge_target(const HedgeRace& race) {
+    std::vector<Accelerator*> cpu_candidates;
+    std::vector<FpgaSlotAccelerator*> slots;
+    {
+        std::lock_guard<InstrumentedMutex> lk(mu_acc_);
+        for (auto& acc : accelerators_) {
+            if (!acc->is_available() || dynamic_cast<federation::RemoteNodeAccelerator*>(acc.get())) continue;
+            if (!acc->is_reconfigurable()) {
+                if (acc.get() != race.primary) cpu_candidates.push_back(acc.get());
+            } else if (!use_cpu_ && acc.get() != race.primary) {
+                if (auto* slot = dynamic_cast<FpgaSlotAccelerator*>(acc.get())) slots.push_back(slot);
+            }
+        }
+    }
+    if (race.task->required != ResourceKind::CPU) {
+        for (auto* slot : slots) {
+            if (slot->current_app() == race.app.app) return slot;
+        }
+    }
     if (!cpu_candidates.empty()) return cpu_candidates.front();
-    if (!use_cpu_ && !reconfigurable.empty()) return reconfigurable.front();
-    return nullptr;
+    if (race.task->required != ResourceKind::CPU && !slots.empty()) return slots.front();
+    return nullptr;  // a duplicate on the straggler itself would only add to its load
+}
+
+// Watches dispatched primaries and queues a duplicate for each one that has
+// run past its expected time or is running out of deadline slack.
+template <class P>
+void SchedulerCore<P>::hedge_loop() {
+    using namespace std::chrono_literals;
+    while (running_) {
+        std::vector<std::shared_ptr<HedgeRace>> late;
+        auto now = std::chrono::steady_clock::now();
+        {
+            std::lock_guard<InstrumentedMutex> lk(mu_hedge_);
+            for (auto it = races_.begin(); it != races_.end();) {
+                const auto& deadline = (*it)->task->effective_deadline;
+                bool overdue = now >= (*it)->trigger ||
+                               (hedge_.min_slack.count() > 0 && deadline && *deadline - now < hedge_.min_slack);
+                if (!overdue) {
+                    ++it;
+                    continue;
+                }
+                late.push_back(std::move(*it));
+                it = races_.erase(it);
+            }
+        }
+        std::vector<std::shared_ptr<Task>> launch;
+        for (auto& race : late) {
+            // Nowhere else to run it: the primary is left alone and nothing is launched.
+            if (!select_hedge_target(*race)) continue;
+            std::lock_guard<InstrumentedMutex> lk(mu_hedge_);
+            std::lock_guard<InstrumentedMutex> race_lk(race->mu);
+            if (!race->done && race->finished == 0) {
+                race->out[1] = dash::PrivateOutput::create(*race->task);
+                race->attempts[1] = make_attempt(*race->task, *race->out[1], &race->cancel[1]);
+                race->launched = 2;
+                hedge_queued_[race->attempts[1].get()] = race;
+                launch.push_back(race->attempts[1]);
+                ++hedge_stats_.launched;
+            }
+        }
+        for (auto& t : launch) {
+            record_ready(t, +1);
+            ready_.push(t);
+        }
+        std::this_thread::sleep_for(500us);
+    }
 }
 
-void Scheduler::Impl::maybe_preload(const std::string& app) {
-    if (use_cpu_ || overlay_preload_threshold_ == 0) return;
+template <class P>
+void SchedulerCore<P>::maybe_preload(const std::string& app, int queued) {
+    if (use_cpu_) return;
     auto descOpt = reg_.lookup(app);
     if (!descOpt) return;
 
     std::vector<FpgaSlotAccelerator*> slots;
     {
-        std::lock_guard<std::mutex> lk(mu_acc_);
+        std::lock_guard<InstrumentedMutex> lk(mu_acc_);
         for (auto& acc : accelerators_) {
             if (!acc->is_available()) continue;
             if (auto* slot = dynamic_cast<FpgaSlotAccelerator*>(acc.get())) {
@@ -266,22 +1121,236 @@ void Scheduler::Impl::maybe_preload(const std::string& app) {
         }
     }
 
-    for (auto* slot : slots) {
-        if (slot->ensure_app_loaded(*descOpt)) return;
+    Preload::load(*descOpt, queued, {slots, ready_depth_.load(std::memory_order_relaxed), cpu_workers_});
+}
+
+template <class P>
+void SchedulerCore<P>::live_loop() {
+    using namespace std::chrono_literals;
+    auto last = std::chrono::steady_clock::now();
+    uint64_t last_completed = 0;
+    while (running_) {
+        auto deadline = last + live_period_;
+        while (running_ && std::chrono::steady_clock::now() < deadline) std::this_thread::sleep_for(10ms);
+        if (!running_) break;
+        auto now = std::chrono::steady_clock::now();
+        uint64_t done = completed_.load(std::memory_order_relaxed);
+        double secs = std::chrono::duration<double>(now - last).count();
+        double throughput = secs > 0 ? static_cast<double>(done - last_completed) / secs : 0.0;
+        publish_live(now, throughput, false);
+        last = now;
+        last_completed = done;
+    }
+}
+
+template <class P>
+void SchedulerCore<P>::publish_live(std::chrono::steady_clock::time_point now, double throughput, bool stopped) {
+    // Built off the hot path: workers only ever touch relaxed atomics.
+    auto snap = std::make_unique<live::Snapshot>();
+    std::memset(snap.get(), 0, sizeof(live::Snapshot));
+    snap->pid = static_cast<uint64_t>(getpid());
+    snap->uptime_ns = static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(now - start_time_).count());
+    snap->ready_depth = ready_depth_.load(std::memory_order_relaxed);
+    {
+        std::lock_guard<InstrumentedMutex> lk(mu_wait_);
+        snap->waiting_depth = waiting_.size();
+    }
+    snap->submitted = submitted_.load(std::memory_order_relaxed);
+    snap->completed = completed_.load(std::memory_order_relaxed);
+    snap->failed = failed_.load(std::memory_order_relaxed);
+    // The final frame reports the whole-run average instead of the last interval.
+    snap->throughput = stopped && snap->uptime_ns
+        ? static_cast<double>(snap->completed) * 1e9 / static_cast<double>(snap->uptime_ns)
+        : throughput;
+    for (unsigned i = 0; i < live::kLatencyBuckets; ++i)
+        snap->latency_hist[i] = latency_hist_[i].load(std::memory_order_relaxed);
+    snap->latency_p50_ns = live::latency_percentile(snap->latency_hist, 0.50);
+    snap->latency_p90_ns = live::latency_percentile(snap->latency_hist, 0.90);
+    snap->latency_p99_ns = live::latency_percentile(snap->latency_hist, 0.99);
+    snap->latency_max_ns = latency_max_.load(std::memory_order_relaxed);
+
+    snap->num_workers = std::min(cpu_workers_, live::kMaxWorkers);
+    for (unsigned i = 0; i < snap->num_workers; ++i) {
+        worker_live_[i].snapshot(snap->workers[i]);
+        if (worker_clock_) {
+            auto times = worker_clock_[i].read();
+            std::memcpy(snap->workers[i].phase_ns, times.ns, sizeof(times.ns));
+        }
+        if (stopped) snap->workers[i].state = live::WorkerState::Stopped;
+    }
+
+    std::lock_guard<InstrumentedMutex> lk(mu_acc_);
+    snap->num_slots = static_cast<uint32_t>(std::min<size_t>(accelerators_.size(), live::kMaxSlots));
+    for (unsigned i = 0; i < snap->num_slots; ++i) {
+        auto& acc = accelerators_[i];
+        auto& out = snap->slots[i];
+        std::strncpy(out.name, acc->name().c_str(), sizeof(out.name) - 1);
+        out.reconfigurable = acc->is_reconfigurable();
+        out.available = acc->is_available();
+        if (auto* slot = dynamic_cast<FpgaSlotAccelerator*>(acc.get())) {
+            std::strncpy(out.overlay, slot->current_app().c_str(), sizeof(out.overlay) - 1);
+        }
+        auto it = acc_index_.find(acc.get());
+        if (it != acc_index_.end()) {
+            out.runs = acc_live_[it->second].runs.load(std::memory_order_relaxed);
+            out.busy_ns = acc_live_[it->second].busy_ns.load(std::memory_order_relaxed);
+        }
+    }
+    live_->publish(*snap);
+}
+
+// Stock policy sets. A custom build adds its PolicySet here, with a
+// SchedulerPolicy value to select it.
+std::unique_ptr<Scheduler::Impl> make_core(SchedulerPolicy policy, ApplicationRegistry& reg, BackendMode mode,
+                                           unsigned cpu_workers, unsigned overlay_preload_threshold) {
+    switch (policy) {
+    case SchedulerPolicy::Edf:
+        return std::make_unique<SchedulerCore<PolicySet<EdfOrder, OverlayFirstMapping, ThresholdPreload>>>(
+            policy, reg, mode, cpu_workers, overlay_preload_threshold);
+    case SchedulerPolicy::Fifo:
+        return std::make_unique<SchedulerCore<PolicySet<FifoOrder, OverlayFirstMapping, ThresholdPreload>>>(
+            policy, reg, mode, cpu_workers, overlay_preload_threshold);
+    case SchedulerPolicy::ResidentFirst:
+        return std::make_unique<SchedulerCore<PolicySet<PriorityOrder, ResidentFirstMapping, ThresholdPreload>>>(
+            policy, reg, mode, cpu_workers, overlay_preload_threshold);
+    case SchedulerPolicy::NoPreload:
+        return std::make_unique<SchedulerCore<PolicySet<PriorityOrder, OverlayFirstMapping, NoPreload>>>(
+            policy, reg, mode, cpu_workers, overlay_preload_threshold);
+    case SchedulerPolicy::Plugin:
+        return std::make_unique<SchedulerCore<PolicySet<PluginOrder, PluginMapping, PluginPreload>>>(
+            policy, reg, mode, cpu_workers, overlay_preload_threshold);
+    case SchedulerPolicy::Default:
+        break;
+    }
+    return std::make_unique<SchedulerCore<PolicySet<PriorityOrder, OverlayFirstMapping, ThresholdPreload>>>(
+        SchedulerPolicy::Default, reg, mode, cpu_workers, overlay_preload_threshold);
+}
+
+// Chunks per worker parallel_for aims for, so uneven chunks still balance.
+constexpr size_t kChunksPerWorker = 4;
+
+// One parallel_for call. Whoever takes the next index from `next` runs that
+// chunk; `done` counts finished (or skipped) chunks. Helpers share ownership,
+// so one that is dispatched after the call returned only sees next >= chunks.
+struct ForkJoin {
+    const std::function<void(size_t, size_t)>* fn{nullptr};  // valid while chunks remain
+    size_t begin{0};
+    size_t end{0};
+    size_t chunk{1};
+    size_t chunks{0};
+    std::atomic<size_t> next{0};
+    std::atomic<size_t> done{0};
+    std::atomic<bool> failed{false};
+    std::exception_ptr error;  // written once, by whoever set failed
+    std::mutex mu;
+    std::condition_variable cv;
+
+    void help() {
+        for (;;) {
+            size_t i = next.fetch_add(1, std::memory_order_relaxed);
+            if (i >= chunks) return;
+            if (!failed.load(std::memory_order_relaxed)) {
+                size_t lo = begin + i * chunk;
+                try {
+                    (*fn)(lo, std::min(end, lo + chunk));
+                } catch (...) {
+                    if (!failed.exchange(true)) error = std::current_exception();
+                }
+            }
+            if (done.fetch_add(1, std::memory_order_acq_rel) + 1 == chunks) {
+                std::lock_guard<std::mutex> lk(mu);
+                cv.notify_all();
+            }
+        }
+    }
+};
+
+} // namespace
+
+const char* to_string(SchedulerPolicy policy) {
+    switch (policy) {
+    case SchedulerPolicy::Edf: return "edf";
+    case SchedulerPolicy::Fifo: return "fifo";
+    case SchedulerPolicy::ResidentFirst: return "resident-first";
+    case SchedulerPolicy::NoPreload: return "no-preload";
+    case SchedulerPolicy::Plugin: return "plugin";
+    case SchedulerPolicy::Default: break;
     }
+    return "default";
 }
 
+std::optional<SchedulerPolicy> parse_scheduler_policy(const std::string& name) {
+    for (auto p : {SchedulerPolicy::Default, SchedulerPolicy::Edf, SchedulerPolicy::Fifo,
+                   SchedulerPolicy::ResidentFirst, SchedulerPolicy::NoPreload, SchedulerPolicy::Plugin}) {
+        if (name == to_string(p)) return p;
+    }
+    return std::nullopt;
+}
+
+void Scheduler::parallel_for(size_t begin, size_t end, size_t grain,
+                             const std::function<void(size_t, size_t)>& fn) {
+    if (begin >= end) return;
+    size_t n = end - begin;
+    unsigned workers = impl_->parallelism();
+    size_t chunk = std::max<size_t>(grain, 1);
+    if (workers > 0) chunk = std::max(chunk, (n + workers * kChunksPerWorker - 1) / (workers * kChunksPerWorker));
+    if (workers == 0 || chunk >= n) {
+        fn(begin, end);
+        return;
+    }
+
+    auto job = std::make_shared<ForkJoin>();
+    job->fn = &fn;
+    job->begin = begin;
+    job->end = end;
+    job->chunk = chunk;
+    job->chunks = (n + chunk - 1) / chunk;
+    // Queued ahead of ordinary tasks: a helper is cheap, and a late one is a no-op.
+    size_t helpers = std::min<size_t>(job->chunks - 1, workers);
+    for (size_t i = 0; i < helpers; ++i) impl_->post([job] { job->help(); }, std::numeric_limits<int>::max());
+
+    job->help();
+    // Only chunks already running elsewhere are left; none can be waiting on a worker.
+    if (job->done.load(std::memory_order_acquire) != job->chunks) {
+        std::unique_lock<std::mutex> lk(job->mu);
+        job->cv.wait(lk, [&] { return job->done.load(std::memory_order_acquire) == job->chunks; });
+    }
+    if (job->error) std::rethrow_exception(job->error);
+}
 
 // -------------- thin wrappers --------------
 Scheduler::Scheduler(ApplicationRegistry& reg, BackendMode mode, unsigned cpu_workers,
                      unsigned overlay_preload_threshold)
-    : impl_(std::make_unique<Impl>(reg, mode, cpu_workers, overlay_preload_threshold)) {}
+    : impl_(make_core(SchedulerPolicy::Default, reg, mode, cpu_workers, overlay_preload_threshold)) {}
+
+Scheduler::Scheduler(ApplicationRegistry& reg, BackendMode mode, SchedulerPolicy policy, unsigned cpu_workers,
+                     unsigned overlay_preload_threshold)
+    : impl_(make_core(policy, reg, mode, cpu_workers, overlay_preload_threshold)) {}
 
 Scheduler::~Scheduler() = default;
 
 void Scheduler::add_accelerator(std::unique_ptr<Accelerator> acc) { impl_->add_accelerator(std::move(acc)); }
 void Scheduler::submit(const std::shared_ptr<Task>& t) { impl_->submit(t); }
+void Scheduler::post(std::function<void()> fn, int priority) { impl_->post(std::move(fn), priority); }
 void Scheduler::start() { impl_->start(); }
 void Scheduler::stop() { impl_->stop(); }
+SchedulerPolicy Scheduler::policy() const { return impl_->policy(); }
+bool Scheduler::uses_overlays() const { return impl_->uses_overlays(); }
+AppMetricsMap Scheduler::app_metrics() const { return impl_->app_metrics(); }
+federation::LoadSummary Scheduler::load_summary() const { return impl_->load_summary(); }
+void Scheduler::set_priority_inheritance(bool enabled) { impl_->set_priority_inheritance(enabled); }
+void Scheduler::set_memory_budget(const MemoryBudget& budget) { impl_->set_memory_budget(budget); }
+MemoryStats Scheduler::memory_stats() const { return impl_->memory_stats(); }
+void Scheduler::set_hedging(const HedgePolicy& policy) { impl_->set_hedging(policy); }
+void Scheduler::set_inline_policy(const InlinePolicy& policy) { impl_->set_inline_policy(policy); }
+void Scheduler::set_worker_accounting(bool enabled) { impl_->set_worker_accounting(enabled); }
+std::vector<WorkerTimes> Scheduler::worker_times() const { return impl_->worker_times(); }
+HedgeStats Scheduler::hedge_stats() const { return impl_->hedge_stats(); }
+unsigned Scheduler::parallelism() const { return impl_->parallelism(); }
+bool Scheduler::on_worker_thread() { return t_on_worker; }
+bool Scheduler::enable_live_stats(const std::string& name, std::chrono::milliseconds period) {
+    return impl_->enable_live_stats(name, period);
+}
 
 } // namespace schedrt
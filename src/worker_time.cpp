@@ -0,0 +1,76 @@
+#include "schedrt/worker_time.hpp"
+
+namespace schedrt {
+
+namespace {
+
+thread_local WorkerClock* t_clock = nullptr;
+
+} // namespace
+
+const char* to_string(WorkerPhase phase) {
+    switch (phase) {
+    case WorkerPhase::Idle: return "idle";
+    case WorkerPhase::Select: return "select";
+    case WorkerPhase::Execute: return "execute";
+    case WorkerPhase::LockWait: return "lock_wait";
+    case WorkerPhase::Report: return "report";
+    case WorkerPhase::Other: return "other";
+    }
+    return "?";
+}
+
+uint64_t WorkerTimes::total_ns() const {
+    uint64_t total = 0;
+    for (auto v : ns) total += v;
+    return total;
+}
+
+WorkerTimes& WorkerTimes::operator+=(const WorkerTimes& other) {
+    for (unsigned i = 0; i < kWorkerPhases; ++i) ns[i] += other.ns[i];
+    tasks += other.tasks;
+    return *this;
+}
+
+void WorkerClock::start() {
+    phase_.store(static_cast<uint32_t>(WorkerPhase::Other), std::memory_order_relaxed);
+    since_.store(now(), std::memory_order_relaxed);
+}
+
+// Single writer, so plain load/store pairs rather than read-modify-writes.
+WorkerPhase WorkerClock::enter(WorkerPhase phase) {
+    int64_t t = now();
+    uint32_t prev = phase_.load(std::memory_order_relaxed);
+    int64_t since = since_.load(std::memory_order_relaxed);
+    if (since != 0 && t > since) {
+        ns_[prev].store(ns_[prev].load(std::memory_order_relaxed) + static_cast<uint64_t>(t - since),
+                        std::memory_order_relaxed);
+    }
+    phase_.store(static_cast<uint32_t>(phase), std::memory_order_relaxed);
+    since_.store(t, std::memory_order_relaxed);
+    return static_cast<WorkerPhase>(prev);
+}
+
+void WorkerClock::stop() {
+    enter(WorkerPhase::Other);
+    since_.store(0, std::memory_order_relaxed);
+}
+
+WorkerTimes WorkerClock::read() const {
+    WorkerTimes out;
+    for (unsigned i = 0; i < kWorkerPhases; ++i) out.ns[i] = ns_[i].load(std::memory_order_relaxed);
+    out.tasks = tasks_.load(std::memory_order_relaxed);
+    int64_t since = since_.load(std::memory_order_relaxed);
+    int64_t t = now();
+    if (since != 0 && t > since) {
+        uint32_t phase = phase_.load(std::memory_order_relaxed);
+        if (phase < kWorkerPhases) out.ns[phase] += static_cast<uint64_t>(t - since);
+    }
+    return out;
+}
+
+WorkerClock* current_worker_clock() { return t_clock; }
+
+void set_current_worker_clock(WorkerClock* clock) { t_clock = clock; }
+
+} // namespace schedrt